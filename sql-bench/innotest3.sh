@@ -0,0 +1,161 @@
+#!/usr/bin/perl
+############################################################################
+#     Row lock scaling benchmark for MySQL/InnoDB
+#
+############################################################################
+
+use Cwd;
+use DBI;
+use Time::HiRes qw(time);
+
+$opt_row_count = 1000000;	# Rows in the table
+$opt_time_limit = 60;		# Seconds to run each concurrency level
+$opt_loop_count = 10;		# Updates per transaction
+
+$pwd = cwd(); $pwd = "." if ($pwd eq '');
+require "$pwd/bench-init.pl" || die "Can't read Configuration file: $!\n";
+
+@concurrency = (1, 2, 4, 8, 16, 32, 64, 128);
+
+if ($opt_small_test) {
+	$opt_row_count = 10000;
+	$opt_time_limit = 10;
+	@concurrency = (1, 4, 16);
+}
+
+print "Innotest3: MySQL/InnoDB row lock scaling benchmark\n";
+print "--------------------------------------------------\n";
+print "This is an update-heavy workload in the style of the sysbench\n";
+print "OLTP update tests. Every transaction updates $opt_loop_count random\n";
+print "rows by primary key, half of them changing an indexed column, and\n";
+print "commits. The test runs $opt_time_limit seconds at each level of\n";
+print "concurrency and prints the transactions and row updates per second,\n";
+print "so that the scaling curve of the InnoDB lock system can be\n";
+print "compared between servers. Use --time-limit and --row-count to\n";
+print "change the duration and the table size.\n";
+print "\n";
+
+####
+####  Connect and create the table
+####
+
+$dbh = $server->connect()
+|| die $dbh->errstr;
+
+print "creating table innotest3 with $opt_row_count rows\n";
+$dbh->do("drop table if exists innotest3");
+$dbh->do(
+"create table innotest3 (id INT NOT NULL, k INT NOT NULL, c CHAR(120) NOT NULL, pad CHAR(60) NOT NULL, PRIMARY KEY (id), INDEX (k)) ENGINE = INNODB")
+|| die $dbh->errstr;
+
+$dbh->do("set autocommit = 0");
+for ($i = 1; $i <= $opt_row_count; $i += 1000) {
+	@values = ();
+	for ($j = $i; $j < $i + 1000 && $j <= $opt_row_count; $j++) {
+		push(@values, "($j, $j, '".("c" x 119)."', '".("p" x 59)."')");
+	}
+	$dbh->do("insert into innotest3 values ".join(",", @values))
+	|| die $dbh->errstr;
+	$dbh->do("commit");
+}
+$dbh->disconnect;
+
+####
+####  Run the clients
+####
+
+print "\n";
+printf("%8s %12s %14s %10s %10s\n",
+       "threads", "trx/s", "updates/s", "deadlocks", "timeouts");
+
+foreach $threads (@concurrency) {
+	@pipes = ();
+
+	for ($t = 0; $t < $threads; $t++) {
+		pipe($reader, $writer) || die "pipe: $!\n";
+		$pid = fork();
+		die "fork: $!\n" if (!defined($pid));
+
+		if ($pid == 0) {
+			close($reader);
+			srand($$ ^ time());
+			print $writer join(" ", run_client()), "\n";
+			close($writer);
+			exit(0);
+		}
+
+		close($writer);
+		push(@pipes, $reader);
+		undef $reader;
+		undef $writer;
+	}
+
+	$n_trx = $n_deadlocks = $n_timeouts = 0;
+	foreach $reader (@pipes) {
+		($trx, $deadlocks, $timeouts) = split(" ", <$reader>);
+		close($reader);
+		$n_trx += $trx;
+		$n_deadlocks += $deadlocks;
+		$n_timeouts += $timeouts;
+	}
+	while (wait() != -1) {}
+
+	printf("%8d %12.1f %14.1f %10d %10d\n", $threads,
+	       $n_trx / $opt_time_limit,
+	       $n_trx * $opt_loop_count / $opt_time_limit,
+	       $n_deadlocks, $n_timeouts);
+}
+
+$dbh = $server->connect()
+|| die $dbh->errstr;
+$dbh->do("drop table innotest3");
+$dbh->disconnect;
+
+####
+####  Runs transactions until the time limit, returns the number of
+####  committed transactions, deadlocks and lock wait timeouts
+####
+
+sub run_client
+{
+	my ($dbh, $end, $trx, $deadlocks, $timeouts, $i, $id, $ok);
+
+	$dbh = $server->connect()
+	|| die $dbh->errstr;
+	$dbh->do("set autocommit = 0");
+
+	$trx = $deadlocks = $timeouts = 0;
+	$end = time() + $opt_time_limit;
+
+	while (time() < $end) {
+		$ok = 1;
+		for ($i = 0; $ok && $i < $opt_loop_count; $i++) {
+			$id = 1 + int(rand($opt_row_count));
+			if ($i % 2) {
+				$ok = $dbh->do(
+				"update innotest3 set k = k + 1 where id = $id");
+			} else {
+				$ok = $dbh->do(
+				"update innotest3 set c = '".int(rand(1000000000))."' where id = $id");
+			}
+		}
+
+		if ($ok) {
+			$dbh->do("commit");
+			$trx++;
+		} else {
+			# 1213 is ER_LOCK_DEADLOCK, 1205 ER_LOCK_WAIT_TIMEOUT
+			if ($dbh->err == 1213) {
+				$deadlocks++;
+			} elsif ($dbh->err == 1205) {
+				$timeouts++;
+			} else {
+				print STDERR $dbh->errstr, "\n";
+			}
+			$dbh->do("rollback");
+		}
+	}
+
+	$dbh->disconnect;
+	return ($trx, $deadlocks, $timeouts);
+}
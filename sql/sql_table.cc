@@ -9728,6 +9728,66 @@ bool mysql_recreate_table(THD *thd, TABLE_LIST *table_list, bool table_copy)
 }
 
 
+/**
+  Calculate the checksum of one row, as CHECKSUM TABLE adds them up for
+  engines that do not keep a live checksum.
+
+  @param t       Table of the row
+  @param record  Record buffer of t holding the row, t->record[0] or
+                 another buffer of the same layout. Undefined null bits
+                 in it are set.
+
+  @return The checksum of the row
+*/
+
+ha_checksum calc_row_checksum(TABLE *t, uchar *record)
+{
+  const my_ptrdiff_t ptr_diff= record - t->record[0];
+  ha_checksum row_crc= 0;
+
+  if (t->s->null_bytes)
+  {
+    /* fix undefined null bits */
+    uchar null_mask= 256 - (1 << t->s->last_null_bit_pos);
+    record[t->s->null_bytes-1] |= null_mask;
+    if (!(t->s->db_create_options & HA_OPTION_PACK_RECORD))
+      record[0] |= 1;
+
+    row_crc= my_checksum(row_crc, record, t->s->null_bytes);
+  }
+
+  for (uint i= 0; i < t->s->fields; i++ )
+  {
+    Field *f= t->field[i];
+
+    /*
+      BLOB and VARCHAR have pointers in their field, we must convert
+      to string; GEOMETRY and DOCUMENT are implemented on top of BLOB.
+      BIT may store its data among NULL bits, convert as well.
+    */
+    switch (f->type()) {
+      case MYSQL_TYPE_BLOB:
+      case MYSQL_TYPE_VARCHAR:
+      case MYSQL_TYPE_GEOMETRY:
+      case MYSQL_TYPE_BIT:
+      case MYSQL_TYPE_DOCUMENT:
+      {
+        String tmp;
+        f->move_field_offset(ptr_diff);
+        f->val_str(&tmp);
+        f->move_field_offset(-ptr_diff);
+        row_crc= my_checksum(row_crc, (uchar*) tmp.ptr(), tmp.length());
+        break;
+      }
+      default:
+        row_crc= my_checksum(row_crc, f->ptr + ptr_diff, f->pack_length());
+        break;
+    }
+  }
+  return row_crc;
+}
+
+
 bool mysql_checksum_table(THD *thd, TABLE_LIST *tables,
                           HA_CHECK_OPT *check_opt)
 {
@@ -9799,7 +9859,14 @@ bool mysql_checksum_table(THD *thd, TABLE_LIST *tables,
     {
       if (t->file->ha_table_flags() & HA_HAS_CHECKSUM &&
 	  !(check_opt->flags & T_EXTEND))
-	protocol->store((ulonglong)t->file->checksum());
+      {
+        ha_checksum crc= t->file->checksum();
+        /* The engine raises the error if it could not compute the checksum */
+        if (thd->is_error())
+          protocol->store_null();
+        else
+          protocol->store((ulonglong)crc);
+      }
       else if (!(t->file->ha_table_flags() & HA_HAS_CHECKSUM) &&
 	       (check_opt->flags & T_QUICK))
 	protocol->store_null();
@@ -9807,7 +9874,6 @@ bool mysql_checksum_table(THD *thd, TABLE_LIST *tables,
       {
 	/* calculating table's checksum */
 	ha_checksum crc= 0;
-        uchar null_mask=256 -  (1 << t->s->last_null_bit_pos);
 
         t->use_all_columns();
 
@@ -9827,7 +9893,6 @@ bool mysql_checksum_table(THD *thd, TABLE_LIST *tables,
               thd->protocol->remove_last_row();
               goto err;
             }
-	    ha_checksum row_crc= 0;
             int error= t->file->ha_rnd_next(t->record[0]);
             if (unlikely(error))
             {
@@ -9835,45 +9900,7 @@ bool mysql_checksum_table(THD *thd, TABLE_LIST *tables,
                 continue;
               break;
             }
-	    if (t->s->null_bytes)
-            {
-              /* fix undefined null bits */
-              t->record[0][t->s->null_bytes-1] |= null_mask;
-              if (!(t->s->db_create_options & HA_OPTION_PACK_RECORD))
-                t->record[0][0] |= 1;
-
-	      row_crc= my_checksum(row_crc, t->record[0], t->s->null_bytes);
-            }
-
-	    for (uint i= 0; i < t->s->fields; i++ )
-	    {
-	      Field *f= t->field[i];
-
-             /*
-               BLOB and VARCHAR have pointers in their field, we must convert
-               to string; GEOMETRY and DOCUMENT are implemented on top of BLOB.
-               BIT may store its data among NULL bits, convert as well.
-             */
-              switch (f->type()) {
-                case MYSQL_TYPE_BLOB:
-                case MYSQL_TYPE_VARCHAR:
-                case MYSQL_TYPE_GEOMETRY:
-                case MYSQL_TYPE_BIT:
-                case MYSQL_TYPE_DOCUMENT:
-                {
-                  String tmp;
-                  f->val_str(&tmp);
-                  row_crc= my_checksum(row_crc, (uchar*) tmp.ptr(),
-                           tmp.length());
-                  break;
-                }
-                default:
-                  row_crc= my_checksum(row_crc, f->ptr, f->pack_length());
-                  break;
-	      }
-	    }
-
-	    crc+= row_crc;
+	    crc+= calc_row_checksum(t, t->record[0]);
 	  }
 	  protocol->store((ulonglong)crc);
           t->file->ha_rnd_end();
@@ -21,6 +21,7 @@
 #include "my_pthread.h"
 #include "m_ctype.h"                            /* CHARSET_INFO */
 #include "mysql_com.h"                          /* enum_field_types */
+#include "my_sys.h"                             /* ha_checksum */
 
 class Alter_info;
 class Alter_table_ctx;
@@ -207,6 +208,7 @@ bool mysql_restore_table(THD* thd, TABLE_LIST* table_list);
 
 bool mysql_checksum_table(THD* thd, TABLE_LIST* table_list,
                           HA_CHECK_OPT* check_opt);
+ha_checksum calc_row_checksum(TABLE *t, uchar *record);
 bool mysql_rm_table(THD *thd,TABLE_LIST *tables, my_bool if_exists,
                     my_bool drop_temporary);
 int mysql_rm_table_no_locks(THD *thd, TABLE_LIST *tables, bool if_exists,
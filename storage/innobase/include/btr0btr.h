@@ -225,6 +225,19 @@ btr_root_get(
 	mtr_t*			mtr)	/*!< in: mtr */
 	MY_ATTRIBUTE((nonnull));
 
+/**************************************************************//**
+Gets the root node of a tree and x- or s-latches it.
+@return	root page, x- or s-latched */
+UNIV_INTERN
+buf_block_t*
+btr_root_block_get(
+/*===============*/
+	const dict_index_t*	index,	/*!< in: index tree */
+	ulint			mode,	/*!< in: either RW_S_LATCH
+					or RW_X_LATCH */
+	mtr_t*			mtr)	/*!< in: mtr */
+	MY_ATTRIBUTE((nonnull));
+
 /**************************************************************//**
 Checks and adjusts the root node of a tree during IMPORT TABLESPACE.
 @return error code, or DB_SUCCESS */
@@ -1242,7 +1242,7 @@ struct dict_table_t{
 	const trx_t*	autoinc_trx;
 				/*!< The transaction that currently holds the
 				the AUTOINC lock on this table.
-				Protected by lock_sys->mutex. */
+				Protected by lock_sys->latch. */
 	fts_t*		fts;	/* FTS specific state variables */
 				/* @} */
 	/*----------------------*/
@@ -1258,7 +1258,10 @@ struct dict_table_t{
 				/*!< Count of the number of record locks on
 				this table. We use this to determine whether
 				we can evict the table from the dictionary
-				cache. It is protected by lock_sys->mutex. */
+				cache. It is protected by lock_sys->latch
+				in X mode, except that record locks created
+				with the latch in S mode increment it
+				atomically. */
 	ulint		n_ref_count;
 				/*!< count of how many handles are opened
 				to this table; dropping of the table is
@@ -1267,10 +1270,10 @@ struct dict_table_t{
 				open handles at drop */
 	ulint		lock_counter[LOCK_NUM];
 				/*!< Counter array for each table lock mode;
-				Protected by lock_sys::mutex */
+				Protected by lock_sys->latch */
 	UT_LIST_BASE_NODE_T(lock_t)
 			locks;	/*!< list of locks on the table; protected
-				by lock_sys->mutex */
+				by lock_sys->latch */
 #endif /* !UNIV_HOTBACKUP */
 
 #ifdef UNIV_DEBUG
@@ -668,7 +668,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 UNIV_INTERN
 ulint
 lock_number_of_rows_locked(
@@ -940,10 +940,25 @@ struct lock_op_t{
 	enum lock_mode	mode;	/*!< lock mode */
 };
 
+/** Number of record lock hash shards, each with its own mutex */
+#define LOCK_SYS_N_SHARDS	64
+
 /** The lock system struct */
 struct lock_sys_t{
-	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+	rw_lock_t	latch;			/*!< Latch protecting the
+						locks. Holding it in X mode
+						gives access to all the locks.
+						Only the fast path of record
+						locking holds it in S mode,
+						together with the mutex of the
+						shard of the page. */
+	ib_mutex_t	rec_shard_mutex[LOCK_SYS_N_SHARDS];
+						/*!< Mutexes protecting the
+						record locks of the hash cells
+						whose number is congruent to
+						the index modulo
+						LOCK_SYS_N_SHARDS, for threads
+						holding latch in S mode */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
@@ -960,7 +975,7 @@ struct lock_sys_t{
 						/*!< TRUE if rollback of all
 						recovered transactions is
 						complete. Protected by
-						lock_sys->mutex */
+						lock_sys->latch */
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
@@ -976,20 +991,30 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/** Test if lock_sys->latch can be X-latched without waiting.
+@return 0 if it was X-latched, like mutex_enter_nowait() */
+#define lock_mutex_enter_nowait()				\
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() mutex_own(&lock_sys->mutex)
+/** Test if lock_sys->latch is X-latched by this thread. */
+#ifdef UNIV_SYNC_DEBUG
+# define lock_mutex_own() rw_lock_own(&lock_sys->latch, RW_LOCK_EX)
+#else /* UNIV_SYNC_DEBUG */
+# define lock_mutex_own()					\
+	(rw_lock_get_writer(&lock_sys->latch) == RW_LOCK_EX	\
+	 && lock_sys->latch.recursive				\
+	 && os_thread_eq(lock_sys->latch.writer_thread,		\
+			 os_thread_get_curr_id()))
+#endif /* UNIV_SYNC_DEBUG */
 
-/** Acquire the lock_sys->mutex. */
+/** X-latch the lock_sys->latch. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the X-latch on lock_sys->latch. */
 #define lock_mutex_exit() do {			\
-	mutex_exit(&lock_sys->mutex);		\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
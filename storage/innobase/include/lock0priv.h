@@ -58,7 +58,10 @@ struct lock_rec_t {
 					lock struct */
 };
 
-/** Lock struct; protected by lock_sys->mutex */
+/** Lock struct; protected by lock_sys->latch in X mode. A record lock
+may also be created or have a bit set while holding lock_sys->latch in S
+mode together with the mutex of the record lock hash shard of its page,
+see lock_rec_lock_sharded(). */
 struct lock_t {
 	trx_t*		trx;		/*!< transaction owning the
 					lock */
@@ -467,6 +467,10 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+	ulint		n_apply_threads;
+				/*!< number of recv_apply_thread that
+				have not yet gone through their share of
+				addr_hash in the running apply batch */
 
 	recv_dblwr_t	dblwr;
 };
@@ -289,6 +289,10 @@ extern ibool	srv_enable_row_lock_wait_callback;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads scanning key ranges of the clustered index, and
+then sorting and inserting the entries of the indexes that are not
+unique, in index creation */
+extern ulong	srv_merge_sort_pll_degree;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -618,6 +622,9 @@ extern ulong srv_n_purge_threads;
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
+/* the number of threads applying redo log records during crash recovery */
+extern ulong srv_n_recv_apply_threads;
+
 /* the number of sync wait arrays */
 extern ulong srv_sync_array_size;
 
@@ -676,6 +683,7 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
 extern mysql_pfs_key_t	srv_slowrm_thread_key;
 
 /* This macro register the current thread and its key with performance
@@ -215,8 +215,9 @@ trx_read_trx_id(
 Looks for the trx instance with the given id in the rw trx_list.
 The caller must be holding trx_sys->mutex.
 @return	the trx handle or NULL if not found;
-the pointer must not be dereferenced unless lock_sys->mutex was
-acquired before calling this function and is still being held */
+the pointer must not be dereferenced unless lock_sys->latch was
+acquired in S or X mode before calling this function and is still being
+held, because a transaction commits with lock_sys->latch in X mode */
 UNIV_INLINE
 trx_t*
 trx_get_rw_trx_by_id(
@@ -235,10 +236,11 @@ trx_rw_min_trx_id(void);
 /****************************************************************//**
 Checks if a rw transaction with the given id is active. Caller must hold
 trx_sys->mutex in shared mode. If the caller is not holding
-lock_sys->mutex, the transaction may already have been committed.
+lock_sys->latch, the transaction may already have been committed.
 @return	transaction instance if active, or NULL;
-the pointer must not be dereferenced unless lock_sys->mutex was
-acquired before calling this function and is still being held */
+the pointer must not be dereferenced unless lock_sys->latch was
+acquired in S or X mode before calling this function and is still being
+held, because a transaction commits with lock_sys->latch in X mode */
 UNIV_INLINE
 trx_t*
 trx_rw_is_active_low(
@@ -248,11 +250,12 @@ trx_rw_is_active_low(
 					that will be set if corrupt */
 /****************************************************************//**
 Checks if a rw transaction with the given id is active. If the caller is
-not holding lock_sys->mutex, the transaction may already have been
+not holding lock_sys->latch, the transaction may already have been
 committed.
 @return	transaction instance if active, or NULL;
-the pointer must not be dereferenced unless lock_sys->mutex was
-acquired before calling this function and is still being held */
+the pointer must not be dereferenced unless lock_sys->latch was
+acquired in S or X mode before calling this function and is still being
+held, because a transaction commits with lock_sys->latch in X mode */
 UNIV_INLINE
 trx_t*
 trx_rw_is_active(
@@ -389,9 +389,14 @@ static lock_stack_t*	lock_stack;
 static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 #endif /* UNIV_DEBUG */
 
+#ifdef UNIV_PFS_RWLOCK
+/* Key to register rwlock with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_latch_key;
+#endif /* UNIV_PFS_RWLOCK */
+
 #ifdef UNIV_PFS_MUTEX
 /* Key to register mutex with performance schema */
-UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	lock_sys_shard_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
@@ -614,7 +619,13 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(lock_sys_mutex_key, &lock_sys->mutex, SYNC_LOCK_SYS);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < LOCK_SYS_N_SHARDS; i++) {
+		mutex_create(lock_sys_shard_mutex_key,
+			     &lock_sys->rec_shard_mutex[i],
+			     SYNC_LOCK_SYS_SHARD);
+	}
 
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
@@ -670,7 +681,10 @@ lock_sys_close(void)
 
 	hash_table_free(lock_sys->rec_hash);
 
-	mutex_free(&lock_sys->mutex);
+	rw_lock_free(&lock_sys->latch);
+	for (ulint i = 0; i < LOCK_SYS_N_SHARDS; i++) {
+		mutex_free(&lock_sys->rec_shard_mutex[i]);
+	}
 	mutex_free(&lock_sys->wait_mutex);
 
 	mem_free(lock_stack);
@@ -691,6 +705,39 @@ lock_get_size(void)
 	return((ulint) sizeof(lock_t));
 }
 
+/*********************************************************************//**
+Gets the mutex of the record lock hash shard of a page. The caller must
+hold lock_sys->latch, which keeps the number of hash cells fixed.
+@return	shard mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_get_shard_mutex(
+/*=====================*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(&lock_sys->rec_shard_mutex[lock_rec_hash(space, page_no)
+					  % LOCK_SYS_N_SHARDS]);
+}
+
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Checks if the thread may access the record locks of a page: it must hold
+lock_sys->latch in X mode, or in S mode and the mutex of the shard of the
+page.
+@return	TRUE if the locks of the page may be accessed */
+static
+ibool
+lock_rec_page_own(
+/*==============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(lock_mutex_own()
+	       || mutex_own(lock_rec_get_shard_mutex(space, page_no)));
+}
+#endif /* UNIV_DEBUG */
+
 /*********************************************************************//**
 Gets the mode of a lock.
 @return	mode */
@@ -746,7 +793,7 @@ lock_get_src_table(
 	Other transactions could want to convert one of our implicit
 	record locks to an explicit one. For that, they would need our
 	trx mutex. Waiting locks can be removed while only holding
-	lock_sys->mutex, but this is a running transaction and cannot
+	lock_sys->latch, but this is a running transaction and cannot
 	thus be holding any waiting locks. */
 	trx_mutex_enter(trx);
 
@@ -1187,12 +1234,13 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
 	page_no = lock->un_member.rec_lock.page_no;
 
+	ut_ad(lock_rec_page_own(space, page_no));
+
 	for (;;) {
 		lock = static_cast<const lock_t*>(HASH_GET_NEXT(hash, lock));
 
@@ -1288,7 +1336,7 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(space, page_no));
 
 	hash = buf_block_get_lock_hash_val(block);
 
@@ -1773,7 +1821,7 @@ lock_rec_other_trx_holds_expl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 UNIV_INTERN
 ulint
 lock_number_of_rows_locked(
@@ -1861,7 +1909,6 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1873,6 +1920,9 @@ lock_rec_create(
 	page_no	= buf_block_get_page_no(block);
 	page = block->frame;
 
+	ut_ad(lock_rec_page_own(space, page_no));
+	ut_ad(!(type_mode & LOCK_WAIT) || lock_mutex_own());
+
 	btr_assert_not_corrupted(block, index);
 
 	/* If rec is the supremum record, then we reset the gap and
@@ -1909,7 +1959,13 @@ lock_rec_create(
 	/* Set the bit corresponding to rec */
 	lock_rec_set_nth_bit(lock, heap_no);
 
+	/* Threads locking records in different shards may get here
+	at the same time */
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
+#else
 	index->table->n_rec_locks++;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
@@ -1938,8 +1994,11 @@ lock_rec_create(
 		trx_mutex_exit(trx);
 	}
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	/* Like n_rec_locks above, these may be incremented from
+	several shards at once. They are only decremented while
+	lock_sys->latch is held in X mode. */
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return(lock);
 }
@@ -2210,7 +2269,8 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(buf_block_get_space(block),
+				buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2407,6 +2467,78 @@ lock_rec_lock(
 	return(DB_ERROR);
 }
 
+/*********************************************************************//**
+Locks a record like lock_rec_lock(), acquiring the latches itself. The
+common cases handled by lock_rec_lock_fast() only hold lock_sys->latch in
+S mode and the mutex of the record lock hash shard of the page, so that
+transactions locking records on pages of different shards do not wait for
+each other. Everything else, including lock waits and deadlock detection,
+holds lock_sys->latch in X mode.
+@return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, DB_DEADLOCK,
+or DB_QUE_THR_SUSPENDED */
+static
+dberr_t
+lock_rec_lock_sharded(
+/*==================*/
+	ibool			impl,	/*!< in: if TRUE, no lock is set
+					if no wait is necessary: we
+					assume that the caller will
+					set an implicit lock */
+	ulint			mode,	/*!< in: lock mode: LOCK_X or
+					LOCK_S possibly ORed to either
+					LOCK_GAP or LOCK_REC_NOT_GAP */
+	enum x_lock_mode	x_mode,	/*!< in: mode of the x-lock:
+					LOCK_X_REGULAR, LOCK_X_NOWAIT,
+					or LOCK_X_SKIP_LOCKED, this is
+					for SELECT FOR UPDATE */
+	const buf_block_t*	block,	/*!< in: buffer block containing
+					the record */
+	ulint			heap_no,/*!< in: heap number of record */
+	dict_index_t*		index,	/*!< in: index of record */
+	que_thr_t*		thr)	/*!< in: query thread */
+{
+	dberr_t	err;
+
+	ut_ad(!lock_mutex_own());
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	/* lock_rec_create() needs atomics to count the record locks of
+	the table without lock_sys->latch in X mode */
+	ib_mutex_t*			shard_mutex;
+	enum lock_rec_req_status	status;
+
+	rw_lock_s_lock(&lock_sys->latch);
+
+	shard_mutex = lock_rec_get_shard_mutex(
+		buf_block_get_space(block), buf_block_get_page_no(block));
+
+	mutex_enter(shard_mutex);
+	status = lock_rec_lock_fast(impl, mode, block, heap_no, index, thr);
+	mutex_exit(shard_mutex);
+
+	rw_lock_s_unlock(&lock_sys->latch);
+
+	switch (status) {
+	case LOCK_REC_SUCCESS:
+		return(DB_SUCCESS);
+	case LOCK_REC_SUCCESS_CREATED:
+		return(DB_SUCCESS_LOCKED_REC);
+	case LOCK_REC_FAIL:
+		/* The queue of the page may change before we get the
+		X-latch, so lock_rec_lock() checks it from scratch */
+		break;
+	}
+#endif /* HAVE_ATOMIC_BUILTINS */
+
+	lock_mutex_enter();
+
+	err = lock_rec_lock(impl, mode, x_mode, block, heap_no, index, thr);
+
+	lock_mutex_exit();
+
+	return(err);
+}
+
 /*********************************************************************//**
 Checks if a waiting record lock request still has to wait in a queue.
 @return	lock that is causing the wait */
@@ -2453,7 +2585,7 @@ lock_rec_has_to_wait_in_queue(
 
 /*************************************************************//**
 Grants a lock to a waiting lock request and releases the waiting transaction.
-The caller must hold lock_sys->mutex but not lock->trx->mutex. */
+The caller must hold lock_sys->latch but not lock->trx->mutex. */
 static
 void
 lock_grant(
@@ -3713,7 +3845,7 @@ lock_deadlock_lock_print(
 	}
 }
 
-/** Used in deadlock tracking. Protected by lock_sys->mutex. */
+/** Used in deadlock tracking. Protected by lock_sys->latch. */
 static ib_uint64_t	lock_mark_counter = 0;
 
 /** Check if the search is too deep. */
@@ -5034,7 +5166,7 @@ lock_remove_recovered_trx_record_locks(
 			continue;
 		}
 
-		/* Because we are holding the lock_sys->mutex,
+		/* Because we are holding the lock_sys->latch,
 		implicit locks cannot be converted to explicit ones
 		while we are scanning the explicit locks. */
 
@@ -5210,12 +5342,13 @@ lock_rec_print(
 	ulint*			offsets		= offsets_;
 	rec_offs_init(offsets_);
 
-	ut_ad(lock_mutex_own());
 	ut_a(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
 	page_no = lock->un_member.rec_lock.page_no;
 
+	ut_ad(lock_rec_page_own(space, page_no));
+
 	fprintf(file, "RECORD LOCKS space id %lu page no %lu n bits %lu ",
 		(ulong) space, (ulong) page_no,
 		(ulong) lock_rec_get_n_bits(lock));
@@ -5468,7 +5601,7 @@ lock_print_info_all_transactions(
 	}
 
 loop:
-	/* Since we temporarily release lock_sys->mutex and
+	/* Since we temporarily release lock_sys->latch and
 	trx_sys->mutex when reading a database page in below,
 	variable trx may be obsolete now and we must loop
 	through the trx list to get probably the same trx,
@@ -5704,7 +5837,7 @@ lock_table_queue_validate(
 		/* lock->trx->state cannot change from or to NOT_STARTED
 		while we are holding the trx_sys->mutex. It may change
 		from ACTIVE to PREPARED, but it may not change to
-		COMMITTED, because we are holding the lock_sys->mutex. */
+		COMMITTED, because we are holding the lock_sys->latch. */
 		ut_ad(trx_assert_started(lock->trx));
 
 		if (!lock_get_wait(lock)) {
@@ -5796,7 +5929,7 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL
 		    && lock_rec_other_has_expl_req(LOCK_S, 0, LOCK_WAIT,
@@ -6296,7 +6429,7 @@ lock_rec_convert_impl_to_expl(
 		impl_trx = trx_rw_is_active(trx_id, NULL);
 
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL
 		    && !lock_rec_has_expl(LOCK_X | LOCK_REC_NOT_GAP, block,
@@ -6355,17 +6488,14 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
-	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
-			    block, heap_no, index, thr);
+	err = lock_rec_lock_sharded(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
+				    LOCK_X_REGULAR, block, heap_no, index,
+				    thr);
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	if (UNIV_UNLIKELY(err == DB_SUCCESS_LOCKED_REC)) {
@@ -6415,17 +6545,14 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
-	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
-			    block, heap_no, index, thr);
+	err = lock_rec_lock_sharded(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
+				    LOCK_X_REGULAR, block, heap_no, index,
+				    thr);
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 #ifdef UNIV_DEBUG
 	{
 		mem_heap_t*	heap		= NULL;
@@ -6518,20 +6645,16 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 
-	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
-			    block, heap_no, index, thr);
+	err = lock_rec_lock_sharded(FALSE, mode | gap_mode, x_mode,
+				    block, heap_no, index, thr);
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6594,20 +6717,16 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 
-	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
-			    block, heap_no, index, thr);
+	err = lock_rec_lock_sharded(FALSE, mode | gap_mode, x_mode,
+				    block, heap_no, index, thr);
 
 	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
 
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -7049,7 +7168,7 @@ lock_trx_release_locks(
 	}
 
 	/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-	is protected by both the lock_sys->mutex and the trx->mutex. */
+	is protected by both the lock_sys->latch and the trx->mutex. */
 	lock_mutex_enter();
 	trx_mutex_enter(trx);
 
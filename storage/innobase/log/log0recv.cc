@@ -166,6 +166,7 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -1845,6 +1846,174 @@ recv_read_in_area(
 	return(n);
 }
 
+/** The share of recv_sys->addr_hash of a recv_apply_thread: the cells i
+with i % n_shards == shard. The cells are chosen by the fold of (space,
+page_no), so every page belongs to exactly one thread. */
+struct recv_apply_shard_t {
+	ulint	shard;
+	ulint	n_shards;
+};
+
+/*******************************************************************//**
+Applies the hashed log records of the pages of a share of
+recv_sys->addr_hash. Pages in the buffer pool are recovered right away;
+the others are read in around them, asynchronously, and recovered by the
+i/o handler threads that complete the reads. The caller must own
+recv_sys->mutex, which is released while a page is recovered or read. */
+static
+void
+recv_apply_hashed_log_recs_shard(
+/*=============================*/
+	const recv_apply_shard_t*	shard)
+					/*!< in: share of the hash */
+{
+	recv_addr_t*	recv_addr;
+	ulint		i;
+	mtr_t		mtr;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+
+	for (i = shard->shard; i < hash_get_n_cells(recv_sys->addr_hash);
+	     i += shard->n_shards) {
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	zip_size = fil_space_get_zip_size(space);
+			ulint	page_no = recv_addr->page_no;
+
+			if (recv_addr->state != RECV_NOT_PROCESSED) {
+				continue;
+			}
+
+			mutex_exit(&(recv_sys->mutex));
+
+			if (buf_page_peek(space, page_no)) {
+				buf_block_t*	block;
+
+				mtr_start(&mtr);
+
+				block = buf_page_get(
+					space, zip_size, page_no,
+					RW_X_LATCH, &mtr);
+				buf_block_dbg_add_level(
+					block, SYNC_NO_ORDER_CHECK);
+
+				recv_recover_page(FALSE, block);
+				mtr_commit(&mtr);
+			} else {
+				recv_read_in_area(space, zip_size, page_no);
+			}
+
+			mutex_enter(&(recv_sys->mutex));
+		}
+	}
+}
+
+/******************************************************************//**
+Thread applying the hashed log records of its share of recv_sys->addr_hash
+in an apply batch.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: recv_apply_shard_t of the thread */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(recv_sys->mutex));
+
+	recv_apply_hashed_log_recs_shard(
+		static_cast<const recv_apply_shard_t*>(arg));
+
+	ut_a(recv_sys->n_apply_threads > 0);
+	recv_sys->n_apply_threads--;
+
+	mutex_exit(&(recv_sys->mutex));
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Applies the hashed log records with srv_n_recv_apply_threads threads, each
+going through its own share of recv_sys->addr_hash, and prints the share of
+the pages recovered as they progress. Returns once the threads have issued
+the reads of all the pages that were not in the buffer pool; some of those
+pages may still be waiting to be recovered. The caller must own
+recv_sys->mutex, which is released while the threads run.
+@return TRUE if there were pages to recover */
+static
+ibool
+recv_apply_hashed_log_recs_parallel(void)
+/*=====================================*/
+{
+	recv_apply_shard_t*	shards;
+	ulint			n_total;
+	ulint			last_pct;
+	ulint			i;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(srv_n_recv_apply_threads > 1);
+
+	n_total = recv_sys->n_addrs;
+
+	if (n_total == 0) {
+		return(FALSE);
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Starting an apply batch of log records to %lu pages"
+		" of the database with %lu threads...",
+		(ulong) n_total, (ulong) srv_n_recv_apply_threads);
+	fputs("InnoDB: Progress in percent: ", stderr);
+
+	shards = static_cast<recv_apply_shard_t*>(
+		mem_alloc(srv_n_recv_apply_threads * sizeof(*shards)));
+
+	recv_sys->n_apply_threads = srv_n_recv_apply_threads;
+
+	for (i = 0; i < srv_n_recv_apply_threads; i++) {
+		shards[i].shard = i;
+		shards[i].n_shards = srv_n_recv_apply_threads;
+
+		os_thread_create(recv_apply_thread, &shards[i], NULL);
+	}
+
+	last_pct = 0;
+
+	while (recv_sys->n_apply_threads != 0) {
+		ulint	pct = (n_total - recv_sys->n_addrs) * 100
+			/ n_total;
+
+		if (pct != last_pct) {
+			fprintf(stderr, "%lu ", (ulong) pct);
+			last_pct = pct;
+		}
+
+		mutex_exit(&(recv_sys->mutex));
+
+		os_thread_sleep(100000);
+
+		mutex_enter(&(recv_sys->mutex));
+	}
+
+	mem_free(shards);
+
+	return(TRUE);
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
 pages. */
@@ -1891,6 +2060,12 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
+	if (srv_n_recv_apply_threads > 1) {
+		has_printed = recv_apply_hashed_log_recs_parallel();
+
+		goto wait_for_pages;
+	}
+
 	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
 
 		for (recv_addr = static_cast<recv_addr_t*>(
@@ -1949,6 +2124,7 @@ loop:
 		}
 	}
 
+wait_for_pages:
 	/* Wait until all the pages have been processed */
 
 	while (recv_sys->n_addrs != 0) {
@@ -2000,6 +2000,596 @@ wait_again:
 	DBUG_RETURN(err);
 }
 
+/** Sorted runs of the entries of an index in a merge file, when a run
+can be longer than a block, see row_merge_read_clustered_index_pll() */
+struct row_merge_runs_t {
+	ulint		n_run;		/*!< number of runs */
+	ulint*		run_offset;	/*!< first offset number of each
+					run */
+};
+
+/** Reader of one key range of the clustered index, see
+row_merge_read_clustered_index_pll() */
+struct row_merge_range_t {
+	trx_t*			trx;		/*!< in: transaction */
+	const dict_table_t*	table;		/*!< in: table where rows
+						are read from */
+	bool			online;		/*!< in: true if creating
+						indexes online */
+	dict_index_t**		index;		/*!< in: indexes to be
+						created */
+	ulint			n_index;	/*!< in: size of index[] */
+	const dtuple_t*		low;		/*!< in: first key of the
+						range, or NULL */
+	const dtuple_t*		high;		/*!< in: first key after the
+						range, or NULL */
+	const char*		path;		/*!< in: directory of the
+						temporary files */
+	merge_file_t*		files;		/*!< out: one sorted run of
+						the entries of each index */
+	row_merge_block_t*	block;		/*!< 3 buffers */
+	ulint			block_size;	/*!< allocated size of
+						block */
+	dberr_t			error;		/*!< out: DB_SUCCESS or error
+						code */
+	ulint			error_key_num;	/*!< out: index of index[]
+						that failed */
+	os_thread_t		thread_hdl;	/*!< thread handle */
+};
+
+/*********************************************************************//**
+Whether row_merge_build_indexes() may scan the clustered index in key
+ranges, one thread per range. Only plain secondary indexes are created
+that way: a table rebuild needs the rows in order for the new clustered
+index, FTS indexes have their own parallel tokenizer threads, and a
+duplicate in a unique index is reported in the MySQL table object, which
+only one thread may use.
+@return	true if the clustered index may be scanned in parallel */
+static
+bool
+row_merge_is_pll_scan(
+/*==================*/
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	const dict_table_t*	new_table,/*!< in: table where indexes are
+					created */
+	dict_index_t**		index,	/*!< in: indexes to be created */
+	ulint			n_index)/*!< in: size of index[] */
+{
+	if (srv_merge_sort_pll_degree <= 1 || old_table != new_table) {
+		return(false);
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (index[i]->type & DICT_FTS
+		    || dict_index_is_unique(index[i])) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/*********************************************************************//**
+Split the clustered index into at most n key ranges, at node pointers of
+the root page, so that the ranges hold about the same number of subtrees.
+@return	number of ranges; range i starts at bounds[i - 1], or at the
+start of the index, and ends before bounds[i], or at the end of the
+index */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+ulint
+row_merge_split_clust_index(
+/*========================*/
+	dict_index_t*		index,	/*!< in: clustered index */
+	ulint			n,	/*!< in: maximum number of ranges */
+	const dtuple_t**	bounds,	/*!< out: n - 1 keys separating
+					the ranges */
+	mem_heap_t*		heap)	/*!< in/out: memory heap for
+					bounds */
+{
+	mtr_t		mtr;
+	ulint		n_ranges = 1;
+	const page_t*	root;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	root = buf_block_get_frame(
+		btr_root_block_get(index, RW_S_LATCH, &mtr));
+
+	if (!page_is_leaf(root)) {
+		const ulint	n_recs = page_get_n_recs(root);
+		const rec_t*	rec = page_rec_get_next_const(
+			page_get_infimum_rec(root));
+
+		/* The first node pointer points to the start of the
+		index, so the ranges start at the others. */
+		for (ulint i = 0; !page_rec_is_supremum(rec);
+		     i++, rec = page_rec_get_next_const(rec)) {
+			if (i == 0 || i * n < n_ranges * n_recs) {
+				continue;
+			}
+
+			/* The fields are copied to heap, so the bounds
+			remain valid after the root page is released. */
+			bounds[n_ranges++ - 1] = dict_index_build_data_tuple(
+				index, const_cast<rec_t*>(rec),
+				dict_index_get_n_unique_in_tree(index), heap);
+
+			if (n_ranges == n) {
+				break;
+			}
+		}
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_ranges);
+}
+
+/*********************************************************************//**
+Sort the entries in a sort buffer and write them to a merge file as one
+run.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_buf_flush(
+/*================*/
+	row_merge_buf_t*	buf,	/*!< in/out: sort buffer */
+	merge_file_t*		file,	/*!< in/out: merge file */
+	row_merge_block_t*	block,	/*!< in/out: file buffer */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	const char*		path)	/*!< in: directory of the temporary
+					files */
+{
+	if (buf->n_tuples == 0) {
+		return(DB_SUCCESS);
+	}
+
+	row_merge_buf_sort(buf, NULL);
+
+	if (row_merge_file_create_if_needed(file, tmpfd, 0, path) < 0) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	file->n_rec += buf->n_tuples;
+
+	row_merge_buf_write(buf, file, block);
+
+	if (!row_merge_write(file->fd, file->offset++, block)) {
+		return(DB_TEMP_FILE_WRITE_FAILURE);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Read the rows of a key range of the clustered index and write the
+entries of the indexes to be created to range->files, as sorted runs of
+one block each. This is the scan of row_merge_read_clustered_index() for
+the indexes that row_merge_is_pll_scan() accepts.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_read_range(
+/*=================*/
+	row_merge_range_t*	range,	/*!< in/out: key range */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	trx_t*			trx = range->trx;
+	dict_index_t*		clust_index;
+	row_merge_buf_t**	merge_buf;
+	mem_heap_t*		row_heap;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	doc_id_t		doc_id = 0;
+	dberr_t			err = DB_SUCCESS;
+
+	merge_buf = static_cast<row_merge_buf_t**>(
+		mem_alloc(range->n_index * sizeof *merge_buf));
+
+	for (ulint i = 0; i < range->n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(range->index[i]);
+	}
+
+	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	clust_index = dict_table_get_first_index(range->table);
+
+	mtr_start(&mtr);
+
+	if (range->low == NULL) {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+	} else {
+		/* Position on the last record before the range. */
+		btr_pcur_open(clust_index, range->low, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		ulint*		offsets;
+		const dtuple_t*	row;
+		row_ext_t*	ext;
+		page_cur_t*	cur	= btr_pcur_get_page_cur(&pcur);
+
+		page_cur_move_to_next(cur);
+
+		if (page_cur_is_after_last(cur)) {
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (rw_lock_get_waiters(
+				    dict_index_get_lock(clust_index))) {
+				/* Yield to the waiters on the clustered
+				index tree lock, as
+				row_merge_read_clustered_index() does. */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+
+				os_thread_yield();
+
+				mtr_start(&mtr);
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+
+				if (!btr_pcur_move_to_next_user_rec(
+					    &pcur, &mtr)) {
+					break;
+				}
+			} else {
+				ulint		next_page_no;
+				buf_block_t*	block;
+
+				next_page_no = btr_page_get_next(
+					page_cur_get_page(cur), &mtr);
+
+				if (next_page_no == FIL_NULL) {
+					break;
+				}
+
+				block = page_cur_get_block(cur);
+				block = btr_block_get(
+					buf_block_get_space(block),
+					buf_block_get_zip_size(block),
+					next_page_no, BTR_SEARCH_LEAF,
+					clust_index, &mtr);
+
+				btr_leaf_page_release(page_cur_get_block(cur),
+						      BTR_SEARCH_LEAF, &mtr);
+				page_cur_set_before_first(block, cur);
+				page_cur_move_to_next(cur);
+
+				ut_ad(!page_cur_is_after_last(cur));
+			}
+		}
+
+		rec = page_cur_get_rec(cur);
+
+		offsets = rec_get_offsets(rec, clust_index, NULL,
+					  ULINT_UNDEFINED, &row_heap);
+
+		if (range->high != NULL
+		    && cmp_dtuple_rec(range->high, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (range->online) {
+			/* Perform a REPEATABLE READ, see
+			row_merge_read_clustered_index(). */
+			ut_ad(trx->read_view);
+
+			if (!read_view_sees_trx_id(
+				    trx->read_view,
+				    row_get_rec_trx_id(
+					    rec, clust_index, offsets))) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					trx->read_view, &row_heap,
+					row_heap, &old_vers);
+
+				rec = old_vers;
+
+				if (!rec) {
+					mem_heap_empty(row_heap);
+					continue;
+				}
+			}
+		}
+
+		if (rec_get_deleted_flag(
+			    rec, dict_table_is_comp(range->table))) {
+			/* Skip delete-marked records. */
+			mem_heap_empty(row_heap);
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build(ROW_COPY_POINTERS, clust_index,
+				rec, offsets, range->table,
+				NULL, NULL, &ext, row_heap);
+
+		for (ulint i = 0; i < range->n_index; i++) {
+			row_merge_buf_t*	buf	= merge_buf[i];
+			bool			exceed_page = false;
+
+			if (row_merge_buf_add(buf, NULL, range->table,
+					      NULL, row, ext, &doc_id,
+					      NULL, &exceed_page)) {
+				if (exceed_page) {
+					err = DB_TOO_BIG_RECORD;
+					range->error_key_num = i;
+					break;
+				}
+
+				continue;
+			}
+
+			/* The buffer is full. Write it out as a run,
+			and add the entry to the emptied buffer. */
+			err = row_merge_buf_flush(
+				buf, &range->files[i], range->block, tmpfd,
+				range->path);
+
+			if (err != DB_SUCCESS) {
+				range->error_key_num = i;
+				break;
+			}
+
+			merge_buf[i] = buf = row_merge_buf_empty(buf);
+
+			if (!row_merge_buf_add(buf, NULL, range->table,
+					       NULL, row, ext, &doc_id,
+					       NULL, &exceed_page)) {
+				/* An empty buffer should have enough
+				room for at least one record. */
+				ut_error;
+			}
+
+			if (exceed_page) {
+				err = DB_TOO_BIG_RECORD;
+				range->error_key_num = i;
+				break;
+			}
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		mem_heap_empty(row_heap);
+	}
+
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	for (ulint i = 0; i < range->n_index; i++) {
+		if (err == DB_SUCCESS) {
+			err = row_merge_buf_flush(
+				merge_buf[i], &range->files[i], range->block,
+				tmpfd, range->path);
+
+			if (err != DB_SUCCESS) {
+				range->error_key_num = i;
+			}
+		}
+
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	mem_free(merge_buf);
+	mem_heap_free(row_heap);
+
+	return(err);
+}
+
+/*********************************************************************//**
+Thread reading a key range of the clustered index, and merging the runs
+of the entries of each index into one run.
+@return	a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(row_merge_read_range_thread)(
+/*========================================*/
+	void*	arg)	/*!< in/out: row_merge_range_t of the thread */
+{
+	row_merge_range_t*	range = static_cast<row_merge_range_t*>(arg);
+	int			tmpfd = -1;
+
+	range->error = row_merge_read_range(range, &tmpfd);
+
+	for (ulint i = 0; i < range->n_index; i++) {
+		row_merge_dup_t	dup = {range->index[i], NULL, NULL, 0};
+
+		if (range->error != DB_SUCCESS) {
+			break;
+		}
+
+		if (range->files[i].fd != -1) {
+			range->error = row_merge_sort(
+				range->trx, &dup, &range->files[i],
+				range->block, &tmpfd);
+			range->error_key_num = i;
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Read the clustered index in key ranges, each in its own thread, and
+create merge files containing the entries of the indexes to be built.
+Each thread sorts its entries into one run per index. The runs of each
+index are then copied to one file, to be merged with row_merge_sort_runs()
+while its entries are inserted.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_pll(
+/*===============================*/
+	trx_t*			trx,	/*!< in: transaction */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	bool			online,	/*!< in: true if creating indexes
+					online */
+	dict_index_t**		index,	/*!< in: indexes to be created */
+	merge_file_t*		files,	/*!< out: temporary files */
+	ulint			n_index,/*!< in: size of index[] */
+	const dtuple_t**	bounds,	/*!< in: n_ranges - 1 keys
+					separating the ranges */
+	ulint			n_ranges,/*!< in: number of ranges */
+	row_merge_runs_t*	runs,	/*!< out: runs of each file */
+	row_merge_block_t*	block,	/*!< in/out: file buffer */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	row_merge_range_t*	ranges;
+	merge_file_t*		range_files;
+	ulint			n_started;
+	ulint			r;
+	dberr_t			err = DB_SUCCESS;
+	DBUG_ENTER("row_merge_read_clustered_index_pll");
+
+	trx->op_info = "reading clustered index";
+
+	ut_ad(trx->mysql_thd != NULL);
+	const char*	path = thd_innodb_tmpdir(trx->mysql_thd);
+
+	ranges = static_cast<row_merge_range_t*>(
+		mem_alloc(n_ranges * sizeof *ranges));
+	range_files = static_cast<merge_file_t*>(
+		mem_alloc(n_ranges * n_index * sizeof *range_files));
+
+	for (r = 0; r < n_ranges * n_index; r++) {
+		range_files[r].fd = -1;
+		range_files[r].offset = 0;
+		range_files[r].n_rec = 0;
+	}
+
+	for (n_started = 0; n_started < n_ranges; n_started++) {
+		row_merge_range_t*	range = &ranges[n_started];
+
+		range->block_size = 3 * srv_sort_buf_size;
+		range->block = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&range->block_size, FALSE));
+
+		if (range->block == NULL) {
+			err = DB_OUT_OF_MEMORY;
+			break;
+		}
+
+		range->trx = trx;
+		range->table = old_table;
+		range->online = online;
+		range->index = index;
+		range->n_index = n_index;
+		range->low = n_started > 0 ? bounds[n_started - 1] : NULL;
+		range->high = n_started + 1 < n_ranges
+			? bounds[n_started] : NULL;
+		range->path = path;
+		range->files = &range_files[n_started * n_index];
+		range->error = DB_SUCCESS;
+		range->error_key_num = 0;
+
+		range->thread_hdl = os_thread_create(
+			row_merge_read_range_thread, range, NULL);
+	}
+
+	for (r = 0; r < n_started; r++) {
+		os_thread_join(ranges[r].thread_hdl);
+		os_mem_free_large(ranges[r].block, ranges[r].block_size);
+
+		if (err == DB_SUCCESS && ranges[r].error != DB_SUCCESS) {
+			err = ranges[r].error;
+			trx->error_key_num = ranges[r].error_key_num;
+		}
+	}
+
+	/* Copy the run of each range to the file of each index, in
+	turn, and note where the runs start. */
+	for (ulint i = 0; err == DB_SUCCESS && i < n_index; i++) {
+		runs[i].run_offset = static_cast<ulint*>(
+			mem_alloc(n_ranges * sizeof *runs[i].run_offset));
+
+		for (r = 0; err == DB_SUCCESS && r < n_ranges; r++) {
+			const merge_file_t*	src
+				= &range_files[r * n_index + i];
+
+			if (src->fd == -1) {
+				continue;
+			}
+
+			if (row_merge_file_create_if_needed(
+				    &files[i], tmpfd, 0, path) < 0) {
+				err = DB_OUT_OF_MEMORY;
+				trx->error_key_num = i;
+				break;
+			}
+
+			runs[i].run_offset[runs[i].n_run++] = files[i].offset;
+			files[i].n_rec += src->n_rec;
+
+			for (ulint j = 0; j < src->offset; j++) {
+				if (!row_merge_read(src->fd, j, block)
+				    || !row_merge_write(files[i].fd,
+							files[i].offset++,
+							block)) {
+					err = DB_TEMP_FILE_WRITE_FAILURE;
+					trx->error_key_num = i;
+					break;
+				}
+			}
+		}
+
+		UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+	}
+
+	for (r = 0; r < n_ranges * n_index; r++) {
+		row_merge_file_destroy(&range_files[r]);
+	}
+
+	if (err == DB_SUCCESS && online) {
+		/* Note the newest transaction that modified each index
+		when the scan was completed. We prevent older readers
+		from accessing the index, to ensure read consistency. */
+		for (ulint i = 0; i < n_index; i++) {
+			trx_id_t	max_trx_id;
+
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			max_trx_id = row_log_get_max_trx(index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+	}
+
+	mem_free(range_files);
+	mem_free(ranges);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err);
+}
+
 /** Write a record via buffer 2 and read the next record to buffer N.
 @param N	number of the buffer (0 or 1)
 @param INDEX	record descriptor
@@ -2339,6 +2929,41 @@ row_merge(
 	return(DB_SUCCESS);
 }
 
+/*************************************************************//**
+Merge the sorted runs of a file until there is one run left.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+row_merge_sort_runs(
+/*================*/
+	trx_t*			trx,	/*!< in: transaction */
+	const row_merge_dup_t*	dup,	/*!< in: descriptor of
+					index being created */
+	merge_file_t*		file,	/*!< in/out: file containing
+					index entries */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	ulint			num_runs,/*!< in: number of runs */
+	ulint*			run_offset)/*!< in/out: first offset number
+					of each run; row_merge() needs
+					only that of run num_runs / 2 */
+{
+	dberr_t		error	= DB_SUCCESS;
+
+	while (num_runs > 1) {
+		error = row_merge(trx, dup, file, block, tmpfd,
+				  &num_runs, run_offset);
+
+		if (error != DB_SUCCESS) {
+			break;
+		}
+
+		UNIV_MEM_ASSERT_RW(run_offset, num_runs * sizeof *run_offset);
+	}
+
+	return(error);
+}
+
 /*************************************************************//**
 Merge disk files.
 @return	DB_SUCCESS or error code */
@@ -2357,7 +2982,7 @@ row_merge_sort(
 	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
 	ulint*		run_offset;
-	dberr_t		error	= DB_SUCCESS;
+	dberr_t		error;
 	DBUG_ENTER("row_merge_sort");
 
 	/* Record the number of merge runs we need to perform */
@@ -2365,7 +2990,7 @@ row_merge_sort(
 
 	/* If num_runs are less than 1, nothing to merge */
 	if (num_runs <= 1) {
-		DBUG_RETURN(error);
+		DBUG_RETURN(DB_SUCCESS);
 	}
 
 	/* "run_offset" records each run's first offset number */
@@ -2379,17 +3004,10 @@ row_merge_sort(
 	of file marker).  Thus, it must be at least one block. */
 	ut_ad(file->offset > 0);
 
-	/* Merge the runs until we have one big run */
-	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset);
-
-		if (error != DB_SUCCESS) {
-			break;
-		}
-
-		UNIV_MEM_ASSERT_RW(run_offset, num_runs * sizeof *run_offset);
-	} while (num_runs > 1);
+	/* Merge the runs until we have one big run. Each block is a
+run to begin with. */
+	error = row_merge_sort_runs(trx, dup, file, block, tmpfd,
+				    num_runs, run_offset);
 
 	mem_free(run_offset);
 
@@ -3605,6 +4223,235 @@ row_merge_drop_table(
 	return(row_drop_table_for_mysql(table->name, trx, false, false));
 }
 
+/*********************************************************************//**
+Merge sort the entries of an index being created and insert them to the
+index.
+@return	DB_SUCCESS or error code */
+static MY_ATTRIBUTE((nonnull(1,2,3,6,8,9), warn_unused_result))
+dberr_t
+row_merge_sort_insert(
+/*==================*/
+	trx_t*			trx,	/*!< in: transaction */
+	dict_index_t*		index,	/*!< in/out: index being created */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	struct TABLE*		table,	/*!< in/out: MySQL table, for
+					reporting erroneous key value
+					if applicable */
+	const ulint*		col_map,/*!< in: mapping of old column
+					numbers to new ones, or NULL */
+	merge_file_t*		file,	/*!< in/out: file containing
+					index entries */
+	const row_merge_runs_t*	runs,	/*!< in: runs in file, or NULL
+					if each block is a run */
+	row_merge_block_t*	block,	/*!< in/out: 3 buffers */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	row_merge_dup_t	dup = {index, table, col_map, 0};
+	dberr_t		error;
+
+	if (runs != NULL) {
+		error = row_merge_sort_runs(trx, &dup, file, block, tmpfd,
+					    runs->n_run, runs->run_offset);
+	} else {
+		error = row_merge_sort(trx, &dup, file, block, tmpfd);
+	}
+
+	if (error == DB_SUCCESS) {
+		error = row_merge_insert_index_tuples(
+			trx->id, index, old_table, file->fd, block);
+	}
+
+	return(error);
+}
+
+/*********************************************************************//**
+Whether row_merge_build_indexes() leaves the sorting and insertion of the
+entries of an index to the parallel sort threads. The entries of unique
+indexes are sorted by the thread of the ALTER TABLE, because a duplicate
+is reported in the MySQL table object, which only one thread may use.
+@return	true if the index is sorted by a parallel sort thread */
+static
+bool
+row_merge_is_psort_index(
+/*=====================*/
+	const dict_index_t*	index,	/*!< in: index being created */
+	const merge_file_t*	file)	/*!< in: file of its entries */
+{
+	return(!(index->type & DICT_FTS)
+	       && !dict_index_is_unique(index)
+	       && file->fd != -1);
+}
+
+/** Parallel sort thread of row_merge_build_indexes() */
+struct row_merge_psort_t {
+	ulint			psort_id;	/*!< number of the thread */
+	const ulint*		psort_of;	/*!< in: number of the thread
+						that sorts each index, or
+						ULINT_UNDEFINED */
+	trx_t*			trx;		/*!< in: transaction */
+	const dict_table_t*	old_table;	/*!< in: table where rows are
+						read from */
+	dict_index_t**		indexes;	/*!< in: indexes being
+						created */
+	merge_file_t*		merge_files;	/*!< in/out: files of their
+						entries */
+	const row_merge_runs_t*	runs;		/*!< in: runs in each of
+						merge_files[], or NULL */
+	ulint			n_indexes;	/*!< size of indexes[] */
+	dberr_t*		errors;		/*!< out: result of each
+						index */
+	const char*		path;		/*!< in: directory of the
+						temporary files */
+	row_merge_block_t*	block;		/*!< 3 buffers */
+	ulint			block_size;	/*!< allocated size of
+						block */
+	os_thread_t		thread_hdl;	/*!< thread handle */
+};
+
+/*********************************************************************//**
+Thread sorting the entries of its share of the indexes that are not
+unique, and inserting them.
+@return	a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(row_merge_psort_thread)(
+/*===================================*/
+	void*	arg)	/*!< in/out: row_merge_psort_t of the thread */
+{
+	row_merge_psort_t*	psort = static_cast<row_merge_psort_t*>(arg);
+	int			tmpfd = -1;
+
+	for (ulint i = 0; i < psort->n_indexes; i++) {
+		merge_file_t*	file = &psort->merge_files[i];
+
+		if (psort->psort_of[i] != psort->psort_id) {
+			continue;
+		}
+
+		if (row_merge_tmpfile_if_needed(&tmpfd, psort->path) < 0) {
+			psort->errors[i] = DB_OUT_OF_MEMORY;
+			break;
+		}
+
+		psort->errors[i] = row_merge_sort_insert(
+			psort->trx, psort->indexes[i], psort->old_table,
+			NULL, NULL, file,
+			psort->runs ? &psort->runs[i] : NULL,
+			psort->block, &tmpfd);
+
+		/* Close the temporary file to free up space. */
+		row_merge_file_destroy(file);
+
+		if (psort->errors[i] != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Start the parallel sort threads of row_merge_build_indexes() on the
+indexes that are not unique, at most srv_merge_sort_pll_degree of them.
+The indexes are dealt to the threads in turn.
+@return	number of threads started */
+static MY_ATTRIBUTE((nonnull(1,2,3,4,7,8,9), warn_unused_result))
+ulint
+row_merge_psort_start(
+/*==================*/
+	trx_t*			trx,	/*!< in: transaction */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	dict_index_t**		indexes,/*!< in: indexes being created */
+	merge_file_t*		merge_files,/*!< in/out: files of their
+					entries */
+	const row_merge_runs_t*	runs,	/*!< in: runs in each of
+					merge_files[], or NULL */
+	ulint			n_indexes,/*!< in: size of indexes[] */
+	ulint*			psort_of,/*!< out: number of the thread
+					that sorts each index, or
+					ULINT_UNDEFINED */
+	dberr_t*		errors,	/*!< out: result of each index */
+	row_merge_psort_t*	psort)	/*!< out: srv_merge_sort_pll_degree
+					threads */
+{
+	const char*	path = thd_innodb_tmpdir(trx->mysql_thd);
+	ulint		n_psort;
+	ulint		n = 0;
+	ulint		i;
+	ulint		j;
+
+	for (i = 0; i < n_indexes; i++) {
+		errors[i] = DB_SUCCESS;
+		psort_of[i] = ULINT_UNDEFINED;
+
+		if (row_merge_is_psort_index(indexes[i], &merge_files[i])) {
+			psort_of[i] = n++ % srv_merge_sort_pll_degree;
+		}
+	}
+
+	n_psort = ut_min(n, srv_merge_sort_pll_degree);
+
+	for (j = 0; j < n_psort; j++) {
+		psort[j].block_size = 3 * srv_sort_buf_size;
+		psort[j].block = static_cast<row_merge_block_t*>(
+			os_mem_alloc_large(&psort[j].block_size, FALSE));
+
+		if (psort[j].block == NULL) {
+			/* The indexes of the threads that cannot be
+			started are left to the caller. */
+			for (i = 0; i < n_indexes; i++) {
+				if (psort_of[i] != ULINT_UNDEFINED
+				    && psort_of[i] >= j) {
+					psort_of[i] = ULINT_UNDEFINED;
+				}
+			}
+
+			n_psort = j;
+			break;
+		}
+	}
+
+	for (j = 0; j < n_psort; j++) {
+		psort[j].psort_id = j;
+		psort[j].psort_of = psort_of;
+		psort[j].trx = trx;
+		psort[j].old_table = old_table;
+		psort[j].indexes = indexes;
+		psort[j].merge_files = merge_files;
+		psort[j].runs = runs;
+		psort[j].n_indexes = n_indexes;
+		psort[j].errors = errors;
+		psort[j].path = path;
+
+		psort[j].thread_hdl = os_thread_create(
+			row_merge_psort_thread, &psort[j], NULL);
+	}
+
+	return(n_psort);
+}
+
+/*********************************************************************//**
+Wait for the parallel sort threads of row_merge_build_indexes() to
+finish, and free their buffers. */
+static MY_ATTRIBUTE((nonnull))
+void
+row_merge_psort_join(
+/*=================*/
+	row_merge_psort_t*	psort,	/*!< in/out: threads */
+	ulint			n_psort)/*!< in: number of threads */
+{
+	for (ulint j = 0; j < n_psort; j++) {
+		os_thread_join(psort[j].thread_hdl);
+		os_mem_free_large(psort[j].block, psort[j].block_size);
+	}
+}
+
 /*********************************************************************//**
 Build indexes on a table by reading a clustered index,
 creating a temporary file containing index entries, merge sorting
@@ -3651,6 +4498,10 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	dberr_t*		sort_errors = NULL;
+	ulint*			psort_of = NULL;
+	row_merge_runs_t*	runs = NULL;
+	mem_heap_t*		bounds_heap = NULL;
 	DBUG_ENTER("row_merge_build_indexes");
 
 	ut_ad(!srv_read_only_mode);
@@ -3717,11 +4568,38 @@ row_merge_build_indexes(
 	/* Read clustered index of the table and create files for
 	secondary index entries for merge sort */
 
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, add_cols, col_map,
-		add_autoinc, sequence, block, &tmpfd);
+	if (row_merge_is_pll_scan(old_table, new_table, indexes, n_indexes)) {
+		const dtuple_t**	bounds;
+		ulint			n_ranges;
+
+		bounds_heap = mem_heap_create(1024);
+		bounds = static_cast<const dtuple_t**>(
+			mem_heap_alloc(bounds_heap,
+				       (srv_merge_sort_pll_degree - 1)
+				       * sizeof *bounds));
+
+		n_ranges = row_merge_split_clust_index(
+			dict_table_get_first_index(old_table),
+			srv_merge_sort_pll_degree, bounds, bounds_heap);
+
+		if (n_ranges > 1) {
+			runs = static_cast<row_merge_runs_t*>(
+				mem_zalloc(n_indexes * sizeof *runs));
+
+			error = row_merge_read_clustered_index_pll(
+				trx, old_table, online, indexes, merge_files,
+				n_indexes, bounds, n_ranges, runs, block,
+				&tmpfd);
+		}
+	}
+
+	if (runs == NULL) {
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, add_cols, col_map,
+			add_autoinc, sequence, block, &tmpfd);
+	}
 
 	if (error != DB_SUCCESS) {
 
@@ -3733,6 +4611,47 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (srv_merge_sort_pll_degree > 1) {
+		row_merge_psort_t*	psort;
+		ulint			n_psort;
+
+		psort = static_cast<row_merge_psort_t*>(
+			mem_alloc(srv_merge_sort_pll_degree * sizeof *psort));
+		psort_of = static_cast<ulint*>(
+			mem_alloc(n_indexes * sizeof *psort_of));
+		sort_errors = static_cast<dberr_t*>(
+			mem_alloc(n_indexes * sizeof *sort_errors));
+
+		n_psort = row_merge_psort_start(
+			trx, old_table, indexes, merge_files, runs,
+			n_indexes, psort_of, sort_errors, psort);
+
+		/* While the threads sort and insert the entries of the
+		indexes that are not unique, do the other indexes. The
+		online logs are applied in the loop below, in order. */
+		for (i = 0; i < n_indexes; i++) {
+			if (indexes[i]->type & DICT_FTS
+			    || psort_of[i] != ULINT_UNDEFINED
+			    || merge_files[i].fd == -1) {
+				continue;
+			}
+
+			sort_errors[i] = row_merge_sort_insert(
+				trx, indexes[i], old_table, table, col_map,
+				&merge_files[i], runs ? &runs[i] : NULL,
+				block, &tmpfd);
+
+			row_merge_file_destroy(&merge_files[i]);
+
+			if (sort_errors[i] != DB_SUCCESS) {
+				break;
+			}
+		}
+
+		row_merge_psort_join(psort, n_psort);
+		mem_free(psort);
+	}
+
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -3809,19 +4728,13 @@ wait_again:
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (sort_errors != NULL) {
+			error = sort_errors[i];
 		} else if (merge_files[i].fd != -1) {
-			row_merge_dup_t	dup = {
-				sort_idx, table, col_map, 0};
-
-			error = row_merge_sort(
-				trx, &dup, &merge_files[i],
+			error = row_merge_sort_insert(
+				trx, sort_idx, old_table, table, col_map,
+				&merge_files[i], runs ? &runs[i] : NULL,
 				block, &tmpfd);
-
-			if (error == DB_SUCCESS) {
-				error = row_merge_insert_index_tuples(
-					trx->id, sort_idx, old_table,
-					merge_files[i].fd, block);
-			}
 		}
 
 		/* Close the temporary file to free up space. */
@@ -3882,6 +4795,25 @@ func_exit:
 		dict_mem_index_free(fts_sort_idx);
 	}
 
+	if (sort_errors != NULL) {
+		mem_free(sort_errors);
+		mem_free(psort_of);
+	}
+
+	if (runs != NULL) {
+		for (i = 0; i < n_indexes; i++) {
+			if (runs[i].run_offset != NULL) {
+				mem_free(runs[i].run_offset);
+			}
+		}
+
+		mem_free(runs);
+	}
+
+	if (bounds_heap != NULL) {
+		mem_heap_free(bounds_heap);
+	}
+
 	mem_free(merge_files);
 	os_mem_free_large(block, block_size);
 
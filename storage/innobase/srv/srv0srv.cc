@@ -144,6 +144,10 @@ UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 UNIV_INTERN ibool	srv_enable_row_lock_wait_callback = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Number of threads scanning key ranges of the clustered index, and
+then sorting and inserting the entries of the indexes that are not
+unique, in index creation */
+UNIV_INTERN ulong	srv_merge_sort_pll_degree = 1;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -331,6 +335,10 @@ UNIV_INTERN ulong	srv_n_purge_threads = 1;
 /* the number of pages to purge in one batch */
 UNIV_INTERN ulong	srv_purge_batch_size = 20;
 
+/* The number of threads applying redo log records during crash recovery;
+with 1, the recovery thread applies them itself. */
+UNIV_INTERN ulong	srv_n_recv_apply_threads = 1;
+
 /* Internal setting for "innodb_stats_method". Decides how InnoDB treats
 NULL value when collecting statistics. By default, it is set to
 SRV_STATS_NULLS_EQUAL(0), ie. all NULL value are treated equal */
@@ -2307,7 +2315,7 @@ loop:
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys->mutex
+			ensure we will not be blocked by lock_sys->latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
@@ -1898,9 +1898,12 @@ innobase_start_or_create_for_mysql(void)
 			    + srv_n_read_io_threads
 			    + srv_n_write_io_threads
 			    + srv_n_purge_threads
+			    + srv_n_recv_apply_threads
 			    /* FTS Parallel Sort */
 			    + fts_sort_pll_degree * FTS_NUM_AUX_INDEX
-			      * max_connections;
+			      * max_connections
+			    /* Index creation parallel sort */
+			    + srv_merge_sort_pll_degree * max_connections;
 
 	if (srv_buf_pool_size < BUF_POOL_SIZE_THRESHOLD) {
 		/* If buffer pool is less than 1 GB,
@@ -79,6 +79,18 @@ void Rdb_event_listener::OnCompactionCompleted(
   DBUG_ASSERT(db != nullptr);
   DBUG_ASSERT(m_ddl_manager != nullptr);
 
+  if (ci.status.ok()) {
+    const Rdb_cf_compaction_stats stats = {
+        ci.cf_id,
+        1 /* compactions */,
+        ci.stats.cpu_micros,
+        ci.stats.num_input_records,
+        ci.stats.num_output_records,
+        ci.stats.num_input_deletion_records,
+        ci.stats.num_expired_deletion_records};
+    rdb_update_cf_compaction_stats(stats);
+  }
+
   if (rdb_is_table_scan_index_stats_calculation_enabled()) {
     return;
   }
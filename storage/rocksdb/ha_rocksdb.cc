@@ -33,11 +33,13 @@
 /* C++ standard header files */
 #include <inttypes.h>
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <map>
 #include <queue>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 /* MySQL includes */
@@ -82,6 +84,7 @@
 #include "./rdb_mutex_wrapper.h"
 #include "./rdb_psi.h"
 #include "./rdb_threads.h"
+#include "./rdb_written_keys.h"
 
 // Internal MySQL APIs not exposed in any header.
 extern "C" {
@@ -583,6 +586,11 @@ static void rocksdb_set_rate_limiter_bytes_per_sec(THD *thd,
                                                    void *var_ptr,
                                                    const void *save);
 
+static void rocksdb_set_drop_index_bytes_per_sec(THD *thd,
+                                                 struct st_mysql_sys_var *var,
+                                                 void *var_ptr,
+                                                 const void *save);
+
 static void rocksdb_set_sst_mgr_rate_bytes_per_sec(THD *thd,
                                                    struct st_mysql_sys_var *var,
                                                    void *var_ptr,
@@ -687,6 +695,13 @@ static char *rocksdb_checkpoint_name;
 static char *rocksdb_block_cache_trace_options_str;
 static char *rocksdb_trace_options_str;
 static my_bool rocksdb_signal_drop_index_thread;
+static unsigned long long  // NOLINT(runtime/int)
+    rocksdb_drop_index_slice_size = 0;
+static unsigned long long  // NOLINT(runtime/int)
+    rocksdb_drop_index_bytes_per_sec = 0;
+static uint32_t rocksdb_auto_compact_index_expired_pct = 0;
+static unsigned long long  // NOLINT(runtime/int)
+    rocksdb_auto_compact_index_min_rows = 100000;
 static my_bool rocksdb_strict_collation_check = 1;
 static my_bool rocksdb_ignore_unknown_options = 1;
 static my_bool rocksdb_enable_2pc = 0;
@@ -766,6 +781,13 @@ std::atomic<uint64_t> rocksdb_num_get_for_update_calls(0);
 std::atomic<uint64_t> rocksdb_select_bypass_executed(0);
 std::atomic<uint64_t> rocksdb_select_bypass_rejected(0);
 std::atomic<uint64_t> rocksdb_select_bypass_failed(0);
+std::atomic<uint64_t> rocksdb_scan_readahead_iterators(0);
+std::atomic<uint64_t> rocksdb_scan_readahead_bytes(0);
+std::atomic<uint64_t> rocksdb_sk_lookup_batches(0);
+std::atomic<uint64_t> rocksdb_sk_lookup_batched_rows(0);
+std::atomic<uint64_t> rocksdb_pk_scan_batches(0);
+std::atomic<uint64_t> rocksdb_pk_scan_batched_rows(0);
+std::atomic<uint64_t> rocksdb_write_batch_reads_skipped(0);
 
 static int rocksdb_trace_block_cache_access(
     THD *const thd MY_ATTRIBUTE((__unused__)),
@@ -930,6 +952,8 @@ static std::unique_ptr<rocksdb::DBOptions> rocksdb_db_options =
     rdb_init_rocksdb_db_options();
 
 static std::shared_ptr<rocksdb::RateLimiter> rocksdb_rate_limiter;
+/* Paces the incremental index drops, see rocksdb_drop_index_slice_size */
+static std::shared_ptr<rocksdb::RateLimiter> rocksdb_drop_index_rate_limiter;
 
 /* This enum needs to be kept up to date with rocksdb::TxnDBWritePolicy */
 static const char *write_policy_names[] = {"write_committed", "write_prepared",
@@ -1093,12 +1117,17 @@ const ulong RDB_DEFAULT_MAX_ROW_LOCKS = 1024 * 1024;
 const ulong RDB_MAX_ROW_LOCKS = 1024 * 1024 * 1024;
 const ulong RDB_DEFAULT_BULK_LOAD_SIZE = 1000;
 const ulong RDB_MAX_BULK_LOAD_SIZE = 1024 * 1024 * 1024;
+const uint RDB_MAX_BULK_LOAD_WRITER_THREADS = 64;
+const ulonglong RDB_DEFAULT_BULK_LOAD_WRITER_MAX_PENDING_SIZE =
+    1024 * 1024 * 1024;
+const ulonglong RDB_MIN_BULK_LOAD_WRITER_MAX_PENDING_SIZE = 1024 * 1024;
 const size_t RDB_DEFAULT_MERGE_BUF_SIZE = 64 * 1024 * 1024;
 const size_t RDB_MIN_MERGE_BUF_SIZE = 100;
 const size_t RDB_DEFAULT_MERGE_COMBINE_READ_SIZE = 1024 * 1024 * 1024;
 const size_t RDB_MIN_MERGE_COMBINE_READ_SIZE = 100;
 const size_t RDB_DEFAULT_MERGE_TMP_FILE_REMOVAL_DELAY = 0;
 const size_t RDB_MIN_MERGE_TMP_FILE_REMOVAL_DELAY = 0;
+const uint RDB_MAX_PARALLEL_SCAN_THREADS = 64;
 const int64 RDB_DEFAULT_BLOCK_CACHE_SIZE = 512 * 1024 * 1024;
 const int64 RDB_MIN_BLOCK_CACHE_SIZE = 1024;
 const int RDB_MAX_CHECKSUMS_PCT = 100;
@@ -1199,6 +1228,35 @@ static MYSQL_THDVAR_BOOL(
     "Enable rocksdb iterator upper/lower bounds in read options.", nullptr,
     nullptr, TRUE);
 
+static MYSQL_THDVAR_UINT(
+    scan_readahead_after_nexts, PLUGIN_VAR_RQCMDARG,
+    "Number of Next() calls on a range scan with iterator bounds after which "
+    "the scan is continued with an iterator that reads ahead up to the bound. "
+    "0 disables readahead",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ UINT_MAX, 0);
+
+static MYSQL_THDVAR_ULONG(
+    scan_readahead_size, PLUGIN_VAR_RQCMDARG,
+    "Maximum number of bytes a range scan reads ahead, see "
+    "rocksdb_scan_readahead_after_nexts",
+    nullptr, nullptr, 2 * 1024 * 1024, /* min */ 4 * 1024,
+    /* max */ LONG_MAX, 0);
+
+static MYSQL_THDVAR_UINT(
+    sk_lookup_batch_size, PLUGIN_VAR_RQCMDARG,
+    "Maximum number of rows a non-covering secondary index scan reads ahead "
+    "with one MultiGet. The scan reads 2 rows ahead first, and twice as many "
+    "each time it has returned them. 0 or 1 reads the rows one at a time",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ 64 * 1024, 0);
+
+static MYSQL_THDVAR_UINT(
+    pk_scan_batch_size, PLUGIN_VAR_RQCMDARG,
+    "Maximum number of rows a primary key scan that does not lock its rows "
+    "reads ahead and decodes together. The scan reads 2 rows ahead first, "
+    "and twice as many each time it has returned them. 0 or 1 reads and "
+    "decodes the rows one at a time",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ 64 * 1024, 0);
+
 static const char *DEFAULT_READ_FREE_RPL_TABLES = ".*";
 
 static int rocksdb_validate_read_free_rpl_tables(
@@ -1313,6 +1371,14 @@ static MYSQL_THDVAR_ULONGLONG(
     "rocksdb_write_policy is WRITE_UNPREPARED. 0 means no limit.",
     nullptr, nullptr, /* default */ 0, /* min */ 0, /* max */ SIZE_T_MAX, 1);
 
+static MYSQL_THDVAR_BOOL(
+    track_written_keys, PLUGIN_VAR_RQCMDARG,
+    "Keep an index of the keys that each transaction writes, so that reads of "
+    "other keys skip the write batch of the transaction. Meant for "
+    "transactions that write many rows. Takes effect at the start of the "
+    "next transaction",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_THDVAR_BOOL(
     lock_scanned_rows, PLUGIN_VAR_RQCMDARG,
     "Take and hold locks on rows that are scanned but not updated", nullptr,
@@ -1325,6 +1391,24 @@ static MYSQL_THDVAR_ULONG(bulk_load_size, PLUGIN_VAR_RQCMDARG,
                           /*min*/ 1,
                           /*max*/ RDB_MAX_BULK_LOAD_SIZE, 0);
 
+static MYSQL_THDVAR_UINT(
+    bulk_load_writer_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of threads per bulk loaded index that build, compress and write "
+    "out the SST files while the client keeps sending rows. 0 writes the "
+    "files on the loading thread.",
+    nullptr, nullptr, /* default */ 0, /* min */ 0,
+    /* max */ RDB_MAX_BULK_LOAD_WRITER_THREADS, 0);
+
+static MYSQL_THDVAR_ULONGLONG(
+    bulk_load_writer_max_pending_size, PLUGIN_VAR_RQCMDARG,
+    "Maximum size of the rows of a bulk loaded index that are waiting for "
+    "rocksdb_bulk_load_writer_threads to write them out. The client waits "
+    "when more would be pending.",
+    nullptr, nullptr,
+    /* default (1GB) */ RDB_DEFAULT_BULK_LOAD_WRITER_MAX_PENDING_SIZE,
+    /* min (1MB) */ RDB_MIN_BULK_LOAD_WRITER_MAX_PENDING_SIZE,
+    /* max */ SIZE_T_MAX, 1);
+
 static MYSQL_THDVAR_ULONGLONG(
     merge_buf_size, PLUGIN_VAR_RQCMDARG,
     "Size to allocate for merge sort buffers written out to disk "
@@ -1356,6 +1440,22 @@ static MYSQL_THDVAR_ULONGLONG(
     /* min (0ms) */ RDB_MIN_MERGE_TMP_FILE_REMOVAL_DELAY,
     /* max */ SIZE_T_MAX, 1);
 
+static MYSQL_THDVAR_UINT(
+    merge_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of threads that scan the primary key and sort the new keys "
+    "in parallel during inplace index creation. The primary key is split "
+    "by its SST files, so small tables are scanned by a single thread.",
+    nullptr, nullptr, /* default */ 1, /* min */ 1,
+    /* max */ RDB_MAX_PARALLEL_SCAN_THREADS, 0);
+
+static MYSQL_THDVAR_UINT(
+    parallel_scan_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of threads that scan the primary key in parallel for "
+    "COUNT(*) without conditions and for CHECKSUM TABLE. The primary key is "
+    "split by its SST files. 1 disables parallel scans.",
+    nullptr, nullptr, /* default */ 1, /* min */ 1,
+    /* max */ RDB_MAX_PARALLEL_SCAN_THREADS, 0);
+
 static MYSQL_THDVAR_INT(
     manual_compaction_threads, PLUGIN_VAR_RQCMDARG,
     "How many rocksdb threads to run for manual compactions", nullptr, nullptr,
@@ -1950,6 +2050,12 @@ static MYSQL_THDVAR_UINT(force_index_records_in_range, PLUGIN_VAR_RQCMDARG,
                          nullptr, nullptr, 0,
                          /* min */ 0, /* max */ INT_MAX, 0);
 
+static MYSQL_THDVAR_BOOL(
+    records_in_range_use_histograms, PLUGIN_VAR_RQCMDARG,
+    "Estimate the rows in SST files for records_in_range() from the key "
+    "histograms in the index statistics, instead of from the size of the range",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_SYSVAR_UINT(
     debug_optimizer_n_rows, rocksdb_debug_optimizer_n_rows,
     PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY | PLUGIN_VAR_NOSYSVAR,
@@ -1994,6 +2100,39 @@ static MYSQL_SYSVAR_BOOL(signal_drop_index_thread,
                          "Wake up drop index thread", nullptr,
                          rocksdb_drop_index_wakeup_thread, FALSE);
 
+static MYSQL_SYSVAR_ULONGLONG(
+    drop_index_slice_size, rocksdb_drop_index_slice_size, PLUGIN_VAR_RQCMDARG,
+    "Bytes of a dropped index to delete with one DeleteRange at a time. "
+    "Dropped indexes are deleted slice by slice and left to regular "
+    "compactions, instead of with DeleteFilesInRange and a manual "
+    "compaction. 0 disables the incremental drop",
+    nullptr, nullptr, /* default */ 0,
+    /* min */ 0, /* max */ LLONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONGLONG(
+    drop_index_bytes_per_sec, rocksdb_drop_index_bytes_per_sec,
+    PLUGIN_VAR_RQCMDARG,
+    "Bytes per second of dropped indexes the incremental index drop may "
+    "delete. 0 means no limit",
+    nullptr, rocksdb_set_drop_index_bytes_per_sec, /* default */ 0,
+    /* min */ 0, /* max */ MAX_RATE_LIMITER_BYTES_PER_SEC, 0);
+
+static MYSQL_SYSVAR_UINT(
+    auto_compact_index_expired_pct, rocksdb_auto_compact_index_expired_pct,
+    PLUGIN_VAR_RQCMDARG,
+    "Percentage of the rows of an index seen by compactions that must have "
+    "expired for the background thread to compact the whole index. "
+    "0 disables these compactions",
+    nullptr, nullptr, /* default */ 0, /* min */ 0, /* max */ 100, 0);
+
+static MYSQL_SYSVAR_ULONGLONG(
+    auto_compact_index_min_rows, rocksdb_auto_compact_index_min_rows,
+    PLUGIN_VAR_RQCMDARG,
+    "Number of rows of an index compactions must see before the background "
+    "thread checks rocksdb_auto_compact_index_expired_pct for it",
+    nullptr, nullptr, /* default */ 100000,
+    /* min */ 1, /* max */ LLONG_MAX, 0);
+
 static MYSQL_SYSVAR_BOOL(pause_background_work, rocksdb_pause_background_work,
                          PLUGIN_VAR_RQCMDARG,
                          "Disable all rocksdb background operations", nullptr,
@@ -2403,6 +2542,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(max_row_locks),
     MYSQL_SYSVAR(write_batch_max_bytes),
     MYSQL_SYSVAR(write_batch_flush_threshold),
+    MYSQL_SYSVAR(track_written_keys),
     MYSQL_SYSVAR(lock_scanned_rows),
     MYSQL_SYSVAR(bulk_load),
     MYSQL_SYSVAR(bulk_load_allow_sk),
@@ -2412,9 +2552,15 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(commit_in_the_middle),
     MYSQL_SYSVAR(blind_delete_primary_key),
     MYSQL_SYSVAR(enable_iterate_bounds),
+    MYSQL_SYSVAR(scan_readahead_after_nexts),
+    MYSQL_SYSVAR(scan_readahead_size),
+    MYSQL_SYSVAR(sk_lookup_batch_size),
+    MYSQL_SYSVAR(pk_scan_batch_size),
     MYSQL_SYSVAR(read_free_rpl_tables),
     MYSQL_SYSVAR(read_free_rpl),
     MYSQL_SYSVAR(bulk_load_size),
+    MYSQL_SYSVAR(bulk_load_writer_threads),
+    MYSQL_SYSVAR(bulk_load_writer_max_pending_size),
     MYSQL_SYSVAR(merge_buf_size),
     MYSQL_SYSVAR(enable_bulk_load_api),
     MYSQL_SYSVAR(enable_pipelined_write),
@@ -2422,6 +2568,8 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(tmpdir),
     MYSQL_SYSVAR(merge_combine_read_size),
     MYSQL_SYSVAR(merge_tmp_file_removal_delay_ms),
+    MYSQL_SYSVAR(merge_threads),
+    MYSQL_SYSVAR(parallel_scan_threads),
     MYSQL_SYSVAR(skip_bloom_filter_on_read),
 
     MYSQL_SYSVAR(create_if_missing),
@@ -2508,6 +2656,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
 
     MYSQL_SYSVAR(records_in_range),
     MYSQL_SYSVAR(force_index_records_in_range),
+    MYSQL_SYSVAR(records_in_range_use_histograms),
     MYSQL_SYSVAR(debug_optimizer_n_rows),
     MYSQL_SYSVAR(force_compute_memtable_stats),
     MYSQL_SYSVAR(force_compute_memtable_stats_cachetime),
@@ -2516,6 +2665,10 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(compact_cf),
     MYSQL_SYSVAR(delete_cf),
     MYSQL_SYSVAR(signal_drop_index_thread),
+    MYSQL_SYSVAR(drop_index_slice_size),
+    MYSQL_SYSVAR(drop_index_bytes_per_sec),
+    MYSQL_SYSVAR(auto_compact_index_expired_pct),
+    MYSQL_SYSVAR(auto_compact_index_min_rows),
     MYSQL_SYSVAR(pause_background_work),
     MYSQL_SYSVAR(enable_2pc),
     MYSQL_SYSVAR(ignore_unknown_options),
@@ -3002,6 +3155,13 @@ class Rdb_transaction {
     }
   }
 
+  void update_scan_readahead(ulonglong readahead_size) {
+    if (m_tbl_io_perf != nullptr) {
+      m_tbl_io_perf->update_scan_readahead(rocksdb_perf_context_level(m_thd),
+                                           readahead_size);
+    }
+  }
+
   void set_params(int timeout_sec_arg, int max_row_locks_arg) {
     m_timeout_sec = timeout_sec_arg;
     m_max_row_locks = max_row_locks_arg;
@@ -3020,11 +3180,27 @@ class Rdb_transaction {
 
   ulonglong get_row_lock_count() const { return m_row_lock_count; }
 
-  void incr_insert_count() { ++m_insert_count; }
+  void incr_insert_count() {
+    ++m_insert_count;
+    update_write_batch_size();
+  }
+
+  void incr_update_count() {
+    ++m_update_count;
+    update_write_batch_size();
+  }
 
-  void incr_update_count() { ++m_update_count; }
+  void incr_delete_count() {
+    ++m_delete_count;
+    update_write_batch_size();
+  }
 
-  void incr_delete_count() { ++m_delete_count; }
+  /*
+    Publish the size of the write batch after a row has been written, for
+    other sessions that show this transaction. They must not look at the
+    write batch itself while this session writes to it.
+  */
+  virtual void update_write_batch_size() {}
 
   void incr_row_lock_count() { ++m_row_lock_count; }
 
@@ -3218,7 +3394,9 @@ class Rdb_transaction {
         table_name = "./" + table_name;
         auto sst_info = std::make_shared<Rdb_sst_info>(
             rdb, table_name, index_name, rdb_merge.get_cf(),
-            *rocksdb_db_options, THDVAR(get_thd(), trace_sst_api));
+            *rocksdb_db_options, THDVAR(get_thd(), trace_sst_api),
+            THDVAR(get_thd(), bulk_load_writer_threads),
+            THDVAR(get_thd(), bulk_load_writer_max_pending_size));
 
         while ((rc2 = rdb_merge.next(&merge_key, &merge_val)) == 0) {
           if ((rc2 = sst_info->put(merge_key, merge_val)) != 0) {
@@ -3429,6 +3607,21 @@ class Rdb_transaction {
     return get_indexed_write_batch()->GetWriteBatch();
   }
 
+  /*
+    Write to get_indexed_write_batch(), so skipping transaction locking, in a
+    way that reads of the transaction know about.
+  */
+  virtual rocksdb::Status indexed_put(
+      rocksdb::ColumnFamilyHandle *const column_family,
+      const rocksdb::Slice &key, const rocksdb::Slice &value) {
+    return get_indexed_write_batch()->Put(column_family, key, value);
+  }
+  virtual rocksdb::Status indexed_single_delete(
+      rocksdb::ColumnFamilyHandle *const column_family,
+      const rocksdb::Slice &key) {
+    return get_indexed_write_batch()->SingleDelete(column_family, key);
+  }
+
   virtual rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                               const rocksdb::Slice &key,
                               rocksdb::PinnableSlice *const value) const = 0;
@@ -3453,7 +3646,7 @@ class Rdb_transaction {
       rocksdb::ColumnFamilyHandle *const column_family, bool skip_bloom_filter,
       bool fill_cache, const rocksdb::Slice &eq_cond_lower_bound,
       const rocksdb::Slice &eq_cond_upper_bound, bool read_current = false,
-      bool create_snapshot = true) {
+      bool create_snapshot = true, size_t readahead_size = 0) {
     // Make sure we are not doing both read_current (which implies we don't
     // want a snapshot) and create_snapshot which makes sure we create
     // a snapshot
@@ -3479,6 +3672,7 @@ class Rdb_transaction {
       options.prefix_same_as_start = true;
     }
     options.fill_cache = fill_cache;
+    options.readahead_size = readahead_size;
     if (read_current) {
       options.snapshot = nullptr;
     }
@@ -3555,6 +3749,7 @@ class Rdb_transaction {
       */
       do_set_savepoint();
       m_write_count = m_writes_at_last_savepoint;
+      update_write_batch_size();
     }
   }
 
@@ -3657,6 +3852,31 @@ class Rdb_transaction_impl : public Rdb_transaction {
   rocksdb::Transaction *m_rocksdb_tx = nullptr;
   rocksdb::Transaction *m_rocksdb_reuse_tx = nullptr;
 
+  /*
+    Keys written by the transaction, if rocksdb_track_written_keys was on
+    when it started. Reads of other keys do not need to look at the write
+    batch.
+  */
+  Rdb_written_keys m_written_keys;
+  bool m_track_written_keys = false;
+
+  /* Data size of the write batch, see update_write_batch_size() */
+  std::atomic<uint64_t> m_write_batch_size{0};
+
+  /* Whether key is surely not in the write batch */
+  bool not_written(rocksdb::ColumnFamilyHandle *const column_family,
+                   const rocksdb::Slice &key) const {
+    return m_track_written_keys &&
+           !m_written_keys.may_contain(column_family->GetID(), key);
+  }
+
+  void track_write(rocksdb::ColumnFamilyHandle *const column_family,
+                   const rocksdb::Slice &key) {
+    if (m_track_written_keys) {
+      m_written_keys.add(column_family->GetID(), key);
+    }
+  }
+
  public:
   void set_lock_timeout(int timeout_sec_arg) override {
     if (m_rocksdb_tx) {
@@ -3756,6 +3976,8 @@ class Rdb_transaction_impl : public Rdb_transaction {
     on_rollback();
     /* Save the transaction object to be reused */
     release_tx();
+    m_written_keys.clear();
+    m_write_batch_size = 0;
 
     m_write_count = 0;
     m_insert_count = 0;
@@ -3777,6 +3999,8 @@ class Rdb_transaction_impl : public Rdb_transaction {
     m_row_lock_count = 0;
     m_auto_incr_map.clear();
     m_ddl_transaction = false;
+    m_written_keys.clear();
+    m_write_batch_size = 0;
     if (m_rocksdb_tx) {
       release_snapshot();
       /* This will also release all of the locks: */
@@ -3838,6 +4062,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
                       const rocksdb::Slice &key, const rocksdb::Slice &value,
                       const bool assume_tracked) override {
     ++m_write_count;
+    track_write(column_family, key);
     return m_rocksdb_tx->Put(column_family, key, value, assume_tracked);
   }
 
@@ -3845,6 +4070,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
                              const rocksdb::Slice &key,
                              const bool assume_tracked) override {
     ++m_write_count;
+    track_write(column_family, key);
     return m_rocksdb_tx->Delete(column_family, key, assume_tracked);
   }
 
@@ -3852,9 +4078,24 @@ class Rdb_transaction_impl : public Rdb_transaction {
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, const bool assume_tracked) override {
     ++m_write_count;
+    track_write(column_family, key);
     return m_rocksdb_tx->SingleDelete(column_family, key, assume_tracked);
   }
 
+  rocksdb::Status indexed_put(rocksdb::ColumnFamilyHandle *const column_family,
+                              const rocksdb::Slice &key,
+                              const rocksdb::Slice &value) override {
+    track_write(column_family, key);
+    return Rdb_transaction::indexed_put(column_family, key, value);
+  }
+
+  rocksdb::Status indexed_single_delete(
+      rocksdb::ColumnFamilyHandle *const column_family,
+      const rocksdb::Slice &key) override {
+    track_write(column_family, key);
+    return Rdb_transaction::indexed_single_delete(column_family, key);
+  }
+
   bool has_modifications() const override {
     return m_rocksdb_tx->GetWriteBatch() &&
            m_rocksdb_tx->GetWriteBatch()->GetWriteBatch() &&
@@ -3885,6 +4126,10 @@ class Rdb_transaction_impl : public Rdb_transaction {
     // handler::reset call
     value->Reset();
     global_stats.queries[QUERIES_POINT].inc();
+    if (not_written(column_family, key)) {
+      rocksdb_write_batch_reads_skipped++;
+      return rdb->Get(m_read_opts, column_family, key, value);
+    }
     return m_rocksdb_tx->Get(m_read_opts, column_family, key, value);
   }
 
@@ -3892,6 +4137,16 @@ class Rdb_transaction_impl : public Rdb_transaction {
                  const size_t num_keys, const rocksdb::Slice *keys,
                  rocksdb::PinnableSlice *values, rocksdb::Status *statuses,
                  const bool sorted_input) const override {
+    bool skip_write_batch = m_track_written_keys;
+    for (size_t i = 0; skip_write_batch && i < num_keys; i++) {
+      skip_write_batch = not_written(column_family, keys[i]);
+    }
+    if (skip_write_batch) {
+      rocksdb_write_batch_reads_skipped += num_keys;
+      rdb->MultiGet(m_read_opts, column_family, num_keys, keys, values,
+                    statuses, sorted_input);
+      return;
+    }
     m_rocksdb_tx->MultiGet(m_read_opts, column_family, num_keys, keys, values,
                            statuses, sorted_input);
   }
@@ -3940,6 +4195,21 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
   const rocksdb::Transaction *get_rdb_trx() const { return m_rocksdb_tx; }
 
+  size_t get_written_keys_memory_usage() const {
+    return m_written_keys.memory_usage();
+  }
+
+  void update_write_batch_size() override {
+    m_write_batch_size.store(
+        m_rocksdb_tx->GetWriteBatch()->GetWriteBatch()->GetDataSize(),
+        std::memory_order_relaxed);
+  }
+
+  /* Can be called from other sessions, unlike get_write_batch() */
+  uint64_t get_write_batch_size() const {
+    return m_write_batch_size.load(std::memory_order_relaxed);
+  }
+
   bool is_tx_started() const override { return (m_rocksdb_tx != nullptr); }
 
   void start_tx() override {
@@ -3972,6 +4242,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
     m_rocksdb_reuse_tx = nullptr;
 
     m_read_opts = rocksdb::ReadOptions();
+    m_track_written_keys = THDVAR(m_thd, track_written_keys);
 
     set_initial_savepoint();
 
@@ -4952,7 +5223,9 @@ class Rdb_trx_info_aggregator : public Rdb_tx_list_walker {
            1,                             /*is_replication */
            1,                             /* skip_trx_api */
            wb_impl->is_tx_read_only(), 0, /* deadlock detection */
-           wb_impl->num_ongoing_bulk_load(), thread_id, "" /* query string */});
+           wb_impl->num_ongoing_bulk_load(), thread_id, "", /* query string */
+           0, /* write_batch_size */
+           0 /* written_keys_memory */});
     } else {
       const auto tx_impl = static_cast<const Rdb_transaction_impl *>(tx);
       DBUG_ASSERT(tx_impl);
@@ -4981,7 +5254,9 @@ class Rdb_trx_info_aggregator : public Rdb_tx_list_walker {
                state_it->second, waiting_key, waiting_cf_id, is_replication,
                0, /* skip_trx_api */
                tx_impl->is_tx_read_only(), rdb_trx->IsDeadlockDetect(),
-               tx_impl->num_ongoing_bulk_load(), thread_id, query_str});
+               tx_impl->num_ongoing_bulk_load(), thread_id, query_str,
+               tx_impl->get_write_batch_size(),
+               tx_impl->get_written_keys_memory_usage()});
     }
   }
 };
@@ -5007,6 +5282,37 @@ std::vector<Rdb_deadlock_info> rdb_get_deadlock_info() {
   return showStatus.get_deadlock_info();
 }
 
+std::vector<Rdb_drop_index_progress> rdb_get_drop_index_progress() {
+  std::unordered_set<GL_INDEX_ID> ongoing;
+  dict_manager.get_ongoing_drop_indexes(&ongoing);
+
+  std::vector<GL_INDEX_ID> gl_index_ids(ongoing.begin(), ongoing.end());
+  std::sort(gl_index_ids.begin(), gl_index_ids.end());
+
+  std::vector<Rdb_drop_index_progress> progress;
+  for (const auto &gl_index_id : gl_index_ids) {
+    progress.push_back(rdb_drop_idx_thread.get_progress(gl_index_id));
+  }
+  return progress;
+}
+
+std::vector<Rdb_index_compaction_stats> rdb_get_index_compaction_stats() {
+  return rdb_bg_thread.get_index_compaction_stats();
+}
+
+std::vector<Rdb_cf_compaction_stats> rdb_get_cf_compaction_stats() {
+  return rdb_bg_thread.get_cf_compaction_stats();
+}
+
+void rdb_update_index_compaction_stats(
+    const Rdb_index_compaction_stats &stats) {
+  rdb_bg_thread.update_index_compaction_stats(stats);
+}
+
+void rdb_update_cf_compaction_stats(const Rdb_cf_compaction_stats &stats) {
+  rdb_bg_thread.update_cf_compaction_stats(stats);
+}
+
 /* Generate the snapshot status table */
 static bool rocksdb_show_snapshot_status(handlerton *const hton, THD *const thd,
                                          stat_print_fn *const stat_print) {
@@ -5748,6 +6054,10 @@ static int rocksdb_init_func(void *const p) {
     rocksdb_db_options->rate_limiter = rocksdb_rate_limiter;
   }
 
+  /* Its rate is only used while rocksdb_drop_index_bytes_per_sec is set */
+  rocksdb_drop_index_rate_limiter.reset(rocksdb::NewGenericRateLimiter(
+      std::max(rocksdb_drop_index_bytes_per_sec, 1ULL)));
+
   rocksdb_db_options->delayed_write_rate = rocksdb_delayed_write_rate;
 
   std::shared_ptr<Rdb_logger> myrocks_logger = std::make_shared<Rdb_logger>();
@@ -6642,13 +6952,12 @@ longlong ha_rocksdb::update_hidden_pk_val() {
   return new_val;
 }
 
-/* Get the id of the hidden pk id from m_last_rowkey */
-int ha_rocksdb::read_hidden_pk_id_from_rowkey(longlong *const hidden_pk_id) {
-  DBUG_ASSERT(table != nullptr);
-  DBUG_ASSERT(has_hidden_pk(table));
-
-  rocksdb::Slice rowkey_slice(m_last_rowkey.ptr(), m_last_rowkey.length());
-
+/*
+  Read the hidden primary key id from a row key of a table without a
+  primary key.
+*/
+static int rdb_read_hidden_pk_id(const rocksdb::Slice &rowkey_slice,
+                                 longlong *const hidden_pk_id) {
   // Get hidden primary key from old key slice
   Rdb_string_reader reader(&rowkey_slice);
   if ((!reader.read(Rdb_key_def::INDEX_NUMBER_SIZE))) {
@@ -6666,6 +6975,15 @@ int ha_rocksdb::read_hidden_pk_id_from_rowkey(longlong *const hidden_pk_id) {
   return HA_EXIT_SUCCESS;
 }
 
+/* Get the id of the hidden pk id from m_last_rowkey */
+int ha_rocksdb::read_hidden_pk_id_from_rowkey(longlong *const hidden_pk_id) {
+  DBUG_ASSERT(table != nullptr);
+  DBUG_ASSERT(has_hidden_pk(table));
+
+  rocksdb::Slice rowkey_slice(m_last_rowkey.ptr(), m_last_rowkey.length());
+  return rdb_read_hidden_pk_id(rowkey_slice, hidden_pk_id);
+}
+
 /**
   @brief
   Free lock controls. We call this whenever we close a table. If the table had
@@ -6706,6 +7024,20 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_scan_it_snapshot(nullptr),
       m_scan_it_lower_bound(nullptr),
       m_scan_it_upper_bound(nullptr),
+      m_scan_it_nexts(0),
+      m_scan_it_readahead_checked(false),
+      m_scan_it_reads_ahead(false),
+      m_sk_batch_size(0),
+      m_sk_batch_pos(0),
+      m_sk_batch_window(0),
+      m_sk_batch_forward(true),
+      m_sk_batch_rc(0),
+      m_pk_batch_size(0),
+      m_pk_batch_pos(0),
+      m_pk_batch_window(0),
+      m_pk_batch_forward(true),
+      m_pk_batch_decoded(false),
+      m_pk_batch_rc(0),
       m_tbl_def(nullptr),
       m_pk_descr(nullptr),
       m_key_descr_arr(nullptr),
@@ -6778,36 +7110,13 @@ bool ha_rocksdb::init_with_fields() {
 }
 
 /*
-  If the key is a TTL key, we may need to filter it out.
-
-  The purpose of read filtering for tables with TTL is to ensure that
-  during a transaction a key which has expired already but not removed by
-  compaction yet is not returned to the user.
-
-  Without this the user might be hit with problems such as disappearing
-  rows within a transaction, etc, because the compaction filter ignores
-  snapshots when filtering keys.
+  Whether a record with TTL has expired before curr_ts and must be hidden
+  from reads, see ha_rocksdb::should_hide_ttl_rec(). Does not update any
+  statistics, so that it can be used outside of the connection thread.
 */
-bool ha_rocksdb::should_hide_ttl_rec(const Rdb_key_def &kd,
-                                     const rocksdb::Slice &ttl_rec_val,
-                                     const int64_t curr_ts) {
-  DBUG_ASSERT(kd.has_ttl());
-  DBUG_ASSERT(kd.m_ttl_rec_offset != UINT_MAX);
-
-  /*
-    Curr_ts can only be 0 if there are no snapshots open.
-    should_hide_ttl_rec can only be called when there is >=1 snapshots, unless
-    we are filtering on the write path (single INSERT/UPDATE) in which case
-    we are passed in the current time as curr_ts.
-
-    In the event curr_ts is 0, we always decide not to filter the record. We
-    also log a warning and increment a diagnostic counter.
-  */
-  if (curr_ts == 0) {
-    update_row_stats(ROWS_HIDDEN_NO_SNAPSHOT);
-    return false;
-  }
-
+static bool rdb_is_ttl_rec_expired(const Rdb_key_def &kd,
+                                   const rocksdb::Slice &ttl_rec_val,
+                                   const int64_t curr_ts) {
   if (!rdb_is_ttl_read_filtering_enabled() || !rdb_is_ttl_enabled()) {
     return false;
   }
@@ -6841,8 +7150,42 @@ bool ha_rocksdb::should_hide_ttl_rec(const Rdb_key_def &kd,
 #ifndef DBUG_OFF
   read_filter_ts += rdb_dbug_set_ttl_read_filter_ts();
 #endif
-  bool is_hide_ttl =
-      ts + kd.m_ttl_duration + read_filter_ts <= static_cast<uint64>(curr_ts);
+  return ts + kd.m_ttl_duration + read_filter_ts <=
+         static_cast<uint64>(curr_ts);
+}
+
+/*
+  If the key is a TTL key, we may need to filter it out.
+
+  The purpose of read filtering for tables with TTL is to ensure that
+  during a transaction a key which has expired already but not removed by
+  compaction yet is not returned to the user.
+
+  Without this the user might be hit with problems such as disappearing
+  rows within a transaction, etc, because the compaction filter ignores
+  snapshots when filtering keys.
+*/
+bool ha_rocksdb::should_hide_ttl_rec(const Rdb_key_def &kd,
+                                     const rocksdb::Slice &ttl_rec_val,
+                                     const int64_t curr_ts) {
+  DBUG_ASSERT(kd.has_ttl());
+  DBUG_ASSERT(kd.m_ttl_rec_offset != UINT_MAX);
+
+  /*
+    Curr_ts can only be 0 if there are no snapshots open.
+    should_hide_ttl_rec can only be called when there is >=1 snapshots, unless
+    we are filtering on the write path (single INSERT/UPDATE) in which case
+    we are passed in the current time as curr_ts.
+
+    In the event curr_ts is 0, we always decide not to filter the record. We
+    also log a warning and increment a diagnostic counter.
+  */
+  if (curr_ts == 0) {
+    update_row_stats(ROWS_HIDDEN_NO_SNAPSHOT);
+    return false;
+  }
+
+  const bool is_hide_ttl = rdb_is_ttl_rec_expired(kd, ttl_rec_val, curr_ts);
   if (is_hide_ttl) {
     update_row_stats(ROWS_FILTERED);
 
@@ -9587,69 +9930,482 @@ int ha_rocksdb::index_prev(uchar *const buf) {
   DBUG_RETURN(rc);
 }
 
-int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
-  DBUG_ENTER_FUNC();
+/*
+  Whether a scan of the secondary index kd reads its rows in batches, see
+  fill_sk_batch(). Locking reads lock the rows one at a time, an index only
+  scan that the index covers has no rows to read, and MRR batches the
+  lookups itself.
+*/
+bool ha_rocksdb::use_sk_batch(const Rdb_key_def &kd) const {
+  return THDVAR(ha_thd(), sk_lookup_batch_size) > 1 &&
+         m_lock_rows == RDB_LOCK_NONE && m_scan_it_snapshot == nullptr &&
+         mrr_rowid_reader == nullptr &&
+         !(m_keyread_only && kd.can_cover_lookup());
+}
 
-  int rc;
+/*
+  Read ahead up to m_sk_batch_window entries of the secondary index kd from
+  m_scan_it, in scan order, and read the rows of those that do not cover the
+  lookup with one MultiGet, sorted by primary key. read_sk_batch_row() then
+  returns them in index order.
 
-  if (active_index == pk_index(table, m_tbl_def)) {
-    rc = rnd_next_with_direction(buf, move_forward);
-  } else {
-    THD *thd = ha_thd();
-    for (;;) {
-      DEBUG_SYNC(thd, "rocksdb.check_flags_inwd");
-      if (thd && thd->killed) {
-        rc = HA_ERR_QUERY_INTERRUPTED;
-        break;
-      }
-      if (m_skip_scan_it_next_call) {
-        m_skip_scan_it_next_call = false;
-      } else {
-        if (move_forward) {
-          m_scan_it->Next(); /* this call cannot fail */
-        } else {
-          m_scan_it->Prev();
-        }
-      }
-      rc = rocksdb_skip_expired_records(*m_key_descr_arr[active_index],
-                                        m_scan_it, !move_forward);
-      if (rc != HA_EXIT_SUCCESS) {
+  The window starts at 2 entries, so that a scan that stops after a few
+  rows, like ORDER BY ... LIMIT, reads few rows it does not return, and
+  doubles every time the scan has returned all of its rows, up to
+  rocksdb_sk_lookup_batch_size.
+
+  m_scan_it is left at the last entry read ahead.
+
+  @return
+    HA_EXIT_SUCCESS  At least one entry was read ahead. The error that ended
+                     the batch early, if any, is kept in m_sk_batch_rc.
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::fill_sk_batch(const Rdb_key_def &kd, uchar *const buf,
+                              const bool move_forward) {
+  THD *const thd = ha_thd();
+  const uint max_window = THDVAR(thd, sk_lookup_batch_size);
+  const uint window = m_sk_batch_size == 0 ? 2 : m_sk_batch_window * 2;
+  m_sk_batch_window = std::min(window, max_window);
+
+  if (m_sk_batch.size() < m_sk_batch_window) {
+    m_sk_batch.resize(m_sk_batch_window);
+    m_sk_batch_values.reset(new rocksdb::PinnableSlice[m_sk_batch_window]);
+    m_sk_batch_statuses.resize(m_sk_batch_window);
+  }
+  reset_sk_batch();
+  m_sk_batch_forward = move_forward;
+
+  int rc = HA_EXIT_SUCCESS;
+  while (m_sk_batch_size < m_sk_batch_window) {
+    if (thd && thd->killed) {
+      rc = HA_ERR_QUERY_INTERRUPTED;
+      break;
+    }
+    if (m_skip_scan_it_next_call) {
+      m_skip_scan_it_next_call = false;
+    } else if (!start_scan_readahead(kd, move_forward)) {
+      rocksdb_smart_next(!move_forward, m_scan_it);
+    }
+    rc = rocksdb_skip_expired_records(kd, m_scan_it, !move_forward);
+    if (!rc) rc = find_icp_matching_index_rec(move_forward, buf);
+    if (rc) {
+      break;
+    }
+    if (!is_valid_iterator(m_scan_it) || !kd.covers_key(m_scan_it->key())) {
+      rc = HA_ERR_END_OF_FILE;
+      break;
+    }
+
+    const rocksdb::Slice key = m_scan_it->key();
+    const rocksdb::Slice value = m_scan_it->value();
+
+    /*
+      With ICP, find_icp_matching_index_rec() has checked end_range already.
+      Without it the SQL layer only checks the rows we return, so stop the
+      batch at the first entry past the end of the range instead of reading
+      the rows beyond it.
+    */
+    if (end_range && !(pushed_idx_cond &&
+                       pushed_idx_cond_keyno == active_index)) {
+      rc = kd.unpack_record(table, buf, &key, &value,
+                            m_converter->get_verify_row_debug_checksums());
+      if (rc) {
         break;
       }
-      rc = find_icp_matching_index_rec(move_forward, buf);
-      if (!rc) rc = secondary_index_read(active_index, buf);
-      if (!should_skip_invalidated_record(rc)) {
+      if (compare_key_icp(end_range) > 0) {
+        rc = HA_ERR_END_OF_FILE;
         break;
       }
     }
+
+    const uint size =
+        kd.get_primary_key_tuple(table, *m_pk_descr, &key, m_pk_packed_tuple);
+    if (size == RDB_INVALID_KEY_LEN) {
+      rc = HA_ERR_ROCKSDB_CORRUPT_DATA;
+      break;
+    }
+
+    Rdb_sk_batch_entry &entry = m_sk_batch[m_sk_batch_size++];
+    entry.m_sk_key.assign(key.data(), key.size());
+    entry.m_pk.assign(reinterpret_cast<const char *>(m_pk_packed_tuple),
+                      size);
+    entry.m_covered =
+        kd.covers_lookup(&value, m_converter->get_lookup_bitmap());
+    if (entry.m_covered) {
+      entry.m_sk_value.assign(value.data(), value.size());
+    }
   }
 
-  DBUG_RETURN(rc);
-}
+  if (m_sk_batch_size == 0) {
+    return rc;
+  }
+  m_sk_batch_rc = rc;
 
-/**
-  @return
-    HA_EXIT_SUCCESS  OK
-    other            HA_ERR error code (can be SE-specific)
-*/
-int ha_rocksdb::index_first(uchar *const buf) {
-  DBUG_ENTER_FUNC();
+  std::vector<uint> order;
+  for (uint i = 0; i < m_sk_batch_size; i++) {
+    if (!m_sk_batch[i].m_covered) {
+      order.push_back(i);
+    }
+  }
+  if (order.empty()) {
+    return HA_EXIT_SUCCESS;
+  }
 
-  check_build_decoder();
+  const bool is_reverse_cf = m_pk_descr->m_is_reverse_cf;
+  std::sort(order.begin(), order.end(), [&](const uint a, const uint b) {
+    const int cmp = m_sk_batch[a].m_pk.compare(m_sk_batch[b].m_pk);
+    return is_reverse_cf ? cmp > 0 : cmp < 0;
+  });
+  for (uint i = 0; i < order.size(); i++) {
+    m_sk_batch[order[i]].m_slot = i;
+    m_sk_batch_keys.emplace_back(m_sk_batch[order[i]].m_pk);
+  }
 
-  m_sk_match_prefix = nullptr;
-  ha_statistic_increment(&SSV::ha_read_first_count);
-  int rc = m_key_descr_arr[active_index]->m_is_reverse_cf
-               ? index_last_intern(buf)
-               : index_first_intern(buf);
-  if (rc == HA_ERR_KEY_NOT_FOUND) rc = HA_ERR_END_OF_FILE;
+  Rdb_transaction *const tx = get_or_create_tx(thd);
+  tx->acquire_snapshot(true);
+  tx->multi_get(m_pk_descr->get_cf(), m_sk_batch_keys.size(),
+                m_sk_batch_keys.data(), m_sk_batch_values.get(),
+                m_sk_batch_statuses.data(), true /* sorted_input */);
+  rocksdb_sk_lookup_batches++;
+  rocksdb_sk_lookup_batched_rows += m_sk_batch_keys.size();
 
-  DBUG_RETURN(rc);
+  return HA_EXIT_SUCCESS;
 }
 
-/**
-  @return
-    HA_EXIT_SUCCESS  OK
+/*
+  Return the row of the next entry read ahead by fill_sk_batch(), the way
+  secondary_index_read() returns the row of the entry m_scan_it is at.
+*/
+int ha_rocksdb::read_sk_batch_row(const Rdb_key_def &kd, uchar *const buf) {
+  DBUG_ASSERT(m_sk_batch_pos < m_sk_batch_size);
+
+  const Rdb_sk_batch_entry &entry = m_sk_batch[m_sk_batch_pos++];
+  int rc;
+
+  stats.rows_requested++;
+  table->status = STATUS_NOT_FOUND;
+
+  if (entry.m_covered) {
+    const rocksdb::Slice key(entry.m_sk_key);
+    const rocksdb::Slice value(entry.m_sk_value);
+    rc = kd.unpack_record(table, buf, &key, &value,
+                          m_converter->get_verify_row_debug_checksums());
+    inc_covered_sk_lookup();
+  } else {
+    Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+    const rocksdb::Status &s = m_sk_batch_statuses[entry.m_slot];
+    const rocksdb::PinnableSlice &value = m_sk_batch_values[entry.m_slot];
+
+    if (!s.IsNotFound() && !s.ok()) {
+      return tx->set_status_error(table->in_use, s, *m_pk_descr, m_tbl_def,
+                                  m_table_handler);
+    }
+    /* The row was deleted after the entry was read, or it has expired */
+    if (s.IsNotFound() ||
+        (m_pk_descr->has_ttl() &&
+         should_hide_ttl_rec(*m_pk_descr, value, tx->m_snapshot_timestamp))) {
+      return HA_ERR_KEY_NOT_FOUND;
+    }
+
+    const rocksdb::Slice key(entry.m_pk);
+    rc = convert_record_from_storage_format(&key, &value, buf);
+  }
+
+  m_last_rowkey.copy(entry.m_pk.data(), entry.m_pk.size(), &my_charset_bin);
+  if (!rc) {
+    table->status = 0;
+    stats.rows_read++;
+    stats.rows_index_next++;
+    update_row_stats(ROWS_READ);
+  }
+  return rc;
+}
+
+void ha_rocksdb::reset_sk_batch() {
+  for (size_t i = 0; i < m_sk_batch_keys.size(); i++) {
+    m_sk_batch_values[i].Reset();
+  }
+  m_sk_batch_keys.clear();
+  m_sk_batch_size = 0;
+  m_sk_batch_pos = 0;
+  m_sk_batch_rc = 0;
+}
+
+/*
+  Whether a scan of the primary key reads its rows ahead and decodes them
+  in batches, see fill_pk_batch(). Locking reads read the rows one at a
+  time, to lock them.
+*/
+bool ha_rocksdb::use_pk_batch() const {
+  /* The simulated corruption is applied by Rdb_converter::decode() */
+  DBUG_EXECUTE_IF("myrocks_simulate_bad_pk_read1", return false;);
+
+  return THDVAR(ha_thd(), pk_scan_batch_size) > 1 &&
+         m_lock_rows == RDB_LOCK_NONE && m_scan_it_snapshot == nullptr;
+}
+
+/*
+  Read ahead up to m_pk_batch_window rows of the primary key from m_scan_it,
+  in scan order, and decode them together with
+  Rdb_converter::decode_batch(). read_pk_batch_row() then returns them one
+  at a time. If the batch does not decode, for instance because a row is
+  corrupt, the rows are decoded one at a time when they are returned, so
+  that the rows before the bad one are still returned.
+
+  The window grows as in fill_sk_batch(), from 2 rows up to
+  rocksdb_pk_scan_batch_size.
+
+  m_scan_it is left at the last row read ahead.
+
+  @return
+    HA_EXIT_SUCCESS  At least one row was read ahead. The error that ended
+                     the batch early, if any, is kept in m_pk_batch_rc.
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::fill_pk_batch(const bool move_forward) {
+  THD *const thd = ha_thd();
+  const uint max_window = THDVAR(thd, pk_scan_batch_size);
+  const uint window = m_pk_batch_size == 0 ? 2 : m_pk_batch_window * 2;
+  m_pk_batch_window = std::min(window, max_window);
+
+  reset_pk_batch();
+  m_pk_batch_forward = move_forward;
+
+  const int64_t snapshot_timestamp =
+      get_or_create_tx(table->in_use)->m_snapshot_timestamp;
+  int rc = HA_EXIT_SUCCESS;
+  while (m_pk_batch_rows.size() < m_pk_batch_window) {
+    if (thd && thd->killed) {
+      rc = HA_ERR_QUERY_INTERRUPTED;
+      break;
+    }
+    if (m_skip_scan_it_next_call) {
+      m_skip_scan_it_next_call = false;
+    } else if (!start_scan_readahead(*m_pk_descr, move_forward)) {
+      rocksdb_smart_next(!move_forward, m_scan_it);
+    }
+    if (!is_valid_iterator(m_scan_it) ||
+        !m_pk_descr->covers_key(m_scan_it->key())) {
+      rc = HA_ERR_END_OF_FILE;
+      break;
+    }
+
+    const rocksdb::Slice key = m_scan_it->key();
+    const rocksdb::Slice value = m_scan_it->value();
+    if (m_pk_descr->has_ttl() &&
+        should_hide_ttl_rec(*m_pk_descr, value, snapshot_timestamp)) {
+      continue;
+    }
+
+    // The iterator's slices only live until Next(), keep copies
+    m_pk_batch_rows.push_back(
+        std::make_tuple(m_pk_batch_data.size(), key.size(), value.size()));
+    m_pk_batch_data.append(key.data(), key.size());
+    m_pk_batch_data.append(value.data(), value.size());
+  }
+
+  m_pk_batch_size = m_pk_batch_rows.size();
+  if (m_pk_batch_size == 0) {
+    return rc;
+  }
+  m_pk_batch_rc = rc;
+
+  for (const auto &row : m_pk_batch_rows) {
+    size_t offset, key_len, value_len;
+    std::tie(offset, key_len, value_len) = row;
+    m_pk_batch_keys.emplace_back(m_pk_batch_data.data() + offset, key_len);
+    m_pk_batch_values.emplace_back(m_pk_batch_data.data() + offset + key_len,
+                                   value_len);
+  }
+
+  const size_t rec_len = table->s->rec_buff_length;
+  if (m_pk_batch_records.size() < m_pk_batch_size * rec_len) {
+    m_pk_batch_records.resize(m_pk_batch_size * rec_len);
+    for (uint i = 0; i < m_pk_batch_size; i++) {
+      memcpy(m_pk_batch_records.data() + i * rec_len, table->s->default_values,
+             rec_len);
+    }
+  }
+
+  m_pk_batch_decoded =
+      m_converter->decode_batch(m_pk_descr, m_pk_batch_size,
+                                m_pk_batch_keys.data(),
+                                m_pk_batch_values.data(),
+                                m_pk_batch_records.data(),
+                                rec_len) == HA_EXIT_SUCCESS;
+  rocksdb_pk_scan_batches++;
+  rocksdb_pk_scan_batched_rows += m_pk_batch_size;
+
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  Return the next row read ahead by fill_pk_batch(), the way
+  rnd_next_with_direction() returns the row m_scan_it is at.
+*/
+int ha_rocksdb::read_pk_batch_row(uchar *const buf) {
+  DBUG_ASSERT(m_pk_batch_pos < m_pk_batch_size);
+
+  const uint pos = m_pk_batch_pos++;
+  const rocksdb::Slice &key = m_pk_batch_keys[pos];
+  const rocksdb::Slice &value = m_pk_batch_values[pos];
+  int rc = HA_EXIT_SUCCESS;
+
+  if (m_pk_batch_decoded) {
+    memcpy(buf, m_pk_batch_records.data() + pos * table->s->rec_buff_length,
+           table->s->reclength);
+    /* decode() leaves the TTL of the row it decoded here */
+    if (m_pk_descr->has_ttl()) {
+      memcpy(m_converter->get_ttl_bytes_buffer(), value.data(),
+             ROCKSDB_SIZEOF_TTL_RECORD);
+    }
+  } else {
+    rc = convert_record_from_storage_format(&key, &value, buf);
+  }
+
+  m_last_rowkey.copy(key.data(), key.size(), &my_charset_bin);
+  if (!rc) {
+    table->status = 0;
+  }
+  return rc;
+}
+
+/*
+  Return the next row of a primary key scan that reads its rows in batches,
+  reading the next batch ahead once all rows of the last one were returned.
+*/
+int ha_rocksdb::next_pk_batch_row(uchar *const buf, const bool move_forward) {
+  if (m_pk_batch_size > 0 && m_pk_batch_forward != move_forward) {
+    // Go back to the row returned last, and read ahead in the other
+    // direction from there
+    DBUG_ASSERT(m_pk_batch_pos > 0);
+    const rocksdb::Slice key(m_pk_batch_keys[m_pk_batch_pos - 1]);
+    rocksdb_smart_seek(!move_forward, m_scan_it, key);
+    // If the row is gone, the iterator is already at the next one in the
+    // new direction and must not be moved
+    m_skip_scan_it_next_call =
+        !is_valid_iterator(m_scan_it) || m_scan_it->key() != key;
+    reset_pk_batch();
+  }
+
+  if (m_pk_batch_pos == m_pk_batch_size) {
+    if (m_pk_batch_rc != HA_EXIT_SUCCESS) {
+      return m_pk_batch_rc;
+    }
+    if (!is_valid_iterator(m_scan_it)) {
+      return HA_ERR_END_OF_FILE;
+    }
+    const int rc = fill_pk_batch(move_forward);
+    if (rc != HA_EXIT_SUCCESS) {
+      return rc;
+    }
+  }
+  return read_pk_batch_row(buf);
+}
+
+void ha_rocksdb::reset_pk_batch() {
+  m_pk_batch_rows.clear();
+  m_pk_batch_data.clear();
+  m_pk_batch_keys.clear();
+  m_pk_batch_values.clear();
+  m_pk_batch_size = 0;
+  m_pk_batch_pos = 0;
+  m_pk_batch_rc = 0;
+}
+
+int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
+  DBUG_ENTER_FUNC();
+
+  int rc;
+
+  if (active_index == pk_index(table, m_tbl_def)) {
+    rc = rnd_next_with_direction(buf, move_forward);
+  } else {
+    THD *thd = ha_thd();
+    const Rdb_key_def &kd = *m_key_descr_arr[active_index];
+    const bool use_batch = use_sk_batch(kd);
+
+    if (m_sk_batch_size > 0 && m_sk_batch_forward != move_forward) {
+      // Go back to the entry of the last row returned, and read ahead in
+      // the other direction from there
+      DBUG_ASSERT(m_sk_batch_pos > 0);
+      const rocksdb::Slice key(m_sk_batch[m_sk_batch_pos - 1].m_sk_key);
+      rocksdb_smart_seek(!move_forward, m_scan_it, key);
+      // If the entry is gone, the iterator is already at the next one in
+      // the new direction and must not be moved
+      m_skip_scan_it_next_call =
+          !is_valid_iterator(m_scan_it) || m_scan_it->key() != key;
+      reset_sk_batch();
+    }
+
+    for (;;) {
+      DEBUG_SYNC(thd, "rocksdb.check_flags_inwd");
+      if (thd && thd->killed) {
+        rc = HA_ERR_QUERY_INTERRUPTED;
+        break;
+      }
+      if (use_batch) {
+        if (m_sk_batch_pos == m_sk_batch_size) {
+          if (m_sk_batch_rc != HA_EXIT_SUCCESS) {
+            rc = m_sk_batch_rc;
+            break;
+          }
+          rc = fill_sk_batch(kd, buf, move_forward);
+          if (rc != HA_EXIT_SUCCESS) {
+            break;
+          }
+        }
+        rc = read_sk_batch_row(kd, buf);
+      } else {
+        if (m_skip_scan_it_next_call) {
+          m_skip_scan_it_next_call = false;
+        } else if (!start_scan_readahead(kd, move_forward)) {
+          if (move_forward) {
+            m_scan_it->Next(); /* this call cannot fail */
+          } else {
+            m_scan_it->Prev();
+          }
+        }
+        rc = rocksdb_skip_expired_records(kd, m_scan_it, !move_forward);
+        if (rc != HA_EXIT_SUCCESS) {
+          break;
+        }
+        rc = find_icp_matching_index_rec(move_forward, buf);
+        if (!rc) rc = secondary_index_read(active_index, buf);
+      }
+      if (!should_skip_invalidated_record(rc)) {
+        break;
+      }
+    }
+  }
+
+  DBUG_RETURN(rc);
+}
+
+/**
+  @return
+    HA_EXIT_SUCCESS  OK
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::index_first(uchar *const buf) {
+  DBUG_ENTER_FUNC();
+
+  check_build_decoder();
+
+  m_sk_match_prefix = nullptr;
+  ha_statistic_increment(&SSV::ha_read_first_count);
+  int rc = m_key_descr_arr[active_index]->m_is_reverse_cf
+               ? index_last_intern(buf)
+               : index_first_intern(buf);
+  if (rc == HA_ERR_KEY_NOT_FOUND) rc = HA_ERR_END_OF_FILE;
+
+  DBUG_RETURN(rc);
+}
+
+/**
+  @return
+    HA_EXIT_SUCCESS  OK
     other            HA_ERR error code (can be SE-specific)
 */
 int ha_rocksdb::index_last(uchar *const buf) {
@@ -10526,9 +11282,11 @@ int ha_rocksdb::bulk_load_key(Rdb_transaction *const tx, const Rdb_key_def &kd,
   // used to store the keys. It is still used to indicate when tables
   // are switched.
   if (m_sst_info == nullptr || m_sst_info->is_done()) {
-    m_sst_info.reset(new Rdb_sst_info(rdb, m_table_handler->m_table_name,
-                                      kd.get_name(), cf, *rocksdb_db_options,
-                                      THDVAR(ha_thd(), trace_sst_api)));
+    m_sst_info.reset(new Rdb_sst_info(
+        rdb, m_table_handler->m_table_name, kd.get_name(), cf,
+        *rocksdb_db_options, THDVAR(ha_thd(), trace_sst_api),
+        THDVAR(ha_thd(), bulk_load_writer_threads),
+        THDVAR(ha_thd(), bulk_load_writer_max_pending_size)));
     res = tx->start_bulk_load(this, m_sst_info);
     if (res != HA_EXIT_SUCCESS) {
       DBUG_RETURN(res);
@@ -10660,8 +11418,7 @@ int ha_rocksdb::update_write_pk(const Rdb_key_def &kd,
       It is responsibility of the user to make sure that the data being
       inserted doesn't violate any unique keys.
     */
-    row_info.tx->get_indexed_write_batch()->Put(cf, row_info.new_pk_slice,
-                                                value_slice);
+    row_info.tx->indexed_put(cf, row_info.new_pk_slice, value_slice);
   } else {
     const bool assume_tracked = can_assume_tracked(ha_thd());
     const auto s = row_info.tx->put(cf, row_info.new_pk_slice, value_slice,
@@ -10768,8 +11525,7 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
     old_key_slice = rocksdb::Slice(
         reinterpret_cast<const char *>(m_sk_packed_tuple_old), old_packed_size);
 
-    row_info.tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
-                                                         old_key_slice);
+    row_info.tx->indexed_single_delete(kd.get_cf(), old_key_slice);
 
     bytes_written = old_key_slice.size();
   }
@@ -10783,8 +11539,7 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
   if (bulk_load_sk && row_info.old_data == nullptr) {
     rc = bulk_load_key(row_info.tx, kd, new_key_slice, new_value_slice, true);
   } else {
-    row_info.tx->get_indexed_write_batch()->Put(kd.get_cf(), new_key_slice,
-                                                new_value_slice);
+    row_info.tx->indexed_put(kd.get_cf(), new_key_slice, new_value_slice);
   }
 
   row_info.tx->update_bytes_written(bytes_written + new_key_slice.size() +
@@ -11026,6 +11781,15 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     release_scan_iterator();
   }
 
+  /*
+    An iterator that reads ahead was sized for the range of the previous
+    scan. Start this scan with a regular iterator and its own readahead
+    decision, see start_scan_readahead().
+  */
+  if (m_scan_it_reads_ahead) {
+    release_scan_iterator();
+  }
+
   /*
     SQL layer can call rnd_init() multiple times in a row.
     In that case, re-use the iterator, but re-position it at the table start.
@@ -11048,11 +11812,91 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     }
     m_scan_it_skips_bloom = skip_bloom;
   }
+  m_scan_it_nexts = 0;
+  m_scan_it_readahead_checked = false;
+  m_scan_it_reads_ahead = false;
+  reset_sk_batch();
+  reset_pk_batch();
+}
+
+/*
+  Continue a bounded scan with an iterator that reads ahead, once it has
+  moved forward rocksdb_scan_readahead_after_nexts times since it was
+  positioned. The scan is expected to go on to its bound then, so the
+  readahead is the approximate size of the data up to the bound, up to
+  rocksdb_scan_readahead_size. Reading ahead turns the one block at a time
+  reads of a cold scan into large sequential reads.
+
+  The new iterator is positioned at the key the old one is at.
+
+  @return
+    true   The new iterator is already past that key, because this
+           transaction deleted it meanwhile, and must not be moved.
+    false  The caller moves the iterator as usual.
+*/
+bool ha_rocksdb::start_scan_readahead(const Rdb_key_def &kd,
+                                      const bool move_forward) {
+  THD *const thd = ha_thd();
+  const uint after_nexts = THDVAR(thd, scan_readahead_after_nexts);
+
+  // RocksDB only reads ahead for Next(), and the bound below is an upper one
+  if (after_nexts == 0 || m_scan_it_readahead_checked || kd.m_is_reverse_cf ||
+      !move_forward || m_scan_it_snapshot != nullptr ||
+      ++m_scan_it_nexts < after_nexts) {
+    return false;
+  }
+
+  // The decision holds for the rest of the scan, whatever it is
+  m_scan_it_readahead_checked = true;
+
+  // This is the iterate_upper_bound of m_scan_it, see setup_iterator_bounds()
+  const rocksdb::Slice &bound = m_scan_it_upper_bound_slice;
+  if (!m_scan_it_skips_bloom || bound.empty() ||
+      !THDVAR(thd, enable_iterate_bounds) || !m_scan_it->Valid()) {
+    return false;
+  }
+
+  const std::string key = m_scan_it->key().ToString();
+  if (key.compare(0, std::string::npos, bound.data(), bound.size()) >= 0) {
+    return false;
+  }
+
+  const rocksdb::Range range(key, bound);
+  uint64_t size = 0;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  rdb->GetApproximateSizes(kd.get_cf(), &range, 1, &size,
+                           rocksdb::DB::INCLUDE_FILES);
+#pragma GCC diagnostic pop
+  size = std::min<uint64_t>(size, THDVAR(thd, scan_readahead_size));
+  if (size == 0) {
+    return false;
+  }
+
+  Rdb_transaction *const tx = get_or_create_tx(thd);
+  delete m_scan_it;
+  m_scan_it = tx->get_iterator(kd.get_cf(), true /* skip_bloom_filter */,
+                               !THDVAR(thd, skip_fill_cache),
+                               m_scan_it_lower_bound_slice,
+                               m_scan_it_upper_bound_slice,
+                               false /* read_current */,
+                               true /* create_snapshot */, size);
+  m_scan_it_reads_ahead = true;
+  rocksdb_scan_readahead_iterators++;
+  rocksdb_scan_readahead_bytes += size;
+  tx->update_scan_readahead(size);
+
+  m_scan_it->Seek(key);
+  return !is_valid_iterator(m_scan_it) || m_scan_it->key() != key;
 }
 
 void ha_rocksdb::release_scan_iterator() {
   delete m_scan_it;
   m_scan_it = nullptr;
+  m_scan_it_readahead_checked = false;
+  m_scan_it_reads_ahead = false;
+  reset_sk_batch();
+  reset_pk_batch();
 
   if (m_scan_it_snapshot) {
     rdb->ReleaseSnapshot(m_scan_it_snapshot);
@@ -11149,6 +11993,16 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
   table->status = STATUS_NOT_FOUND;
   stats.rows_requested++;
 
+  if (m_scan_it && use_pk_batch()) {
+    rc = next_pk_batch_row(buf, move_forward);
+    if (!rc) {
+      stats.rows_read++;
+      stats.rows_index_next++;
+      update_row_stats(ROWS_READ);
+    }
+    DBUG_RETURN(rc);
+  }
+
   if (!m_scan_it || !is_valid_iterator(m_scan_it)) {
     /*
       We can get here when SQL layer has called
@@ -11170,7 +12024,7 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
 
     if (m_skip_scan_it_next_call) {
       m_skip_scan_it_next_call = false;
-    } else {
+    } else if (!start_scan_readahead(*m_pk_descr, move_forward)) {
       if (move_forward) {
         m_scan_it->Next(); /* this call cannot fail */
       } else {
@@ -11415,8 +12269,7 @@ int ha_rocksdb::delete_row(const uchar *const buf) {
                                    nullptr, false, hidden_pk_id);
       rocksdb::Slice secondary_key_slice(
           reinterpret_cast<const char *>(m_sk_packed_tuple), packed_size);
-      tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
-                                                  secondary_key_slice);
+      tx->indexed_single_delete(kd.get_cf(), secondary_key_slice);
       bytes_written += secondary_key_slice.size();
     }
   }
@@ -12038,6 +12891,149 @@ static bool is_myrocks_index_empty(rocksdb::ColumnFamilyHandle *cfh,
   return index_removed;
 }
 
+/*
+  The SST files of a column family for which in_range is true, in column
+  family order of their first keys.
+*/
+static std::vector<rocksdb::LiveFileMetaData> rdb_get_cf_files(
+    rocksdb::ColumnFamilyHandle *const cfh,
+    const std::function<bool(const rocksdb::LiveFileMetaData &)> &in_range) {
+  const std::string cf_name = cfh->GetName();
+  std::vector<rocksdb::LiveFileMetaData> metadata;
+  rdb->GetLiveFilesMetaData(&metadata);
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  for (auto &file : metadata) {
+    if (file.column_family_name == cf_name && in_range(file)) {
+      files.push_back(std::move(file));
+    }
+  }
+
+  const rocksdb::Comparator *const cmp = cfh->GetComparator();
+  std::sort(files.begin(), files.end(),
+            [cmp](const rocksdb::LiveFileMetaData &lhs,
+                  const rocksdb::LiveFileMetaData &rhs) {
+              return cmp->Compare(lhs.smallestkey, rhs.smallestkey) < 0;
+            });
+  return files;
+}
+
+/*
+  Delete the keys of a dropped index with DeleteRange, one slice of about
+  rocksdb_drop_index_slice_size bytes at a time. Regular compactions drop
+  the covered keys later, so this avoids the burst of work that
+  DeleteFilesInRange() and a manual compaction of the whole range cause.
+
+  The slices are cut at the first keys of the SST files that hold the
+  index, and their sizes come from GetApproximateSizes(), so no data is
+  read to find them. A slice can be larger than the slice size when the
+  files are. The bytes of each slice are charged against
+  rocksdb_drop_index_bytes_per_sec before it is deleted.
+*/
+rocksdb::Status Rdb_drop_index_thread::delete_index_slices(
+    const GL_INDEX_ID gl_index_id, rocksdb::ColumnFamilyHandle *const cfh,
+    const rocksdb::Range &range) {
+  const rocksdb::Comparator *const cmp = cfh->GetComparator();
+  const std::vector<rocksdb::LiveFileMetaData> files = rdb_get_cf_files(
+      cfh, [cmp, &range](const rocksdb::LiveFileMetaData &file) {
+        return cmp->Compare(file.largestkey, range.start) >= 0 &&
+               cmp->Compare(file.smallestkey, range.limit) < 0;
+      });
+
+  /* Split the range at the first keys of the files that start inside it */
+  std::vector<std::string> cuts;
+  cuts.emplace_back(range.start.data(), range.start.size());
+  uint64_t files_size = 0;
+  uint64_t files_entries = 0;
+  for (const auto &file : files) {
+    files_size += file.size;
+    files_entries += file.num_entries;
+    if (cmp->Compare(file.smallestkey, cuts.back()) > 0) {
+      cuts.push_back(file.smallestkey);
+    }
+  }
+  cuts.emplace_back(range.limit.data(), range.limit.size());
+
+  std::vector<rocksdb::Range> pieces;
+  for (size_t i = 0; i + 1 < cuts.size(); i++) {
+    pieces.emplace_back(cuts[i], cuts[i + 1]);
+  }
+  std::vector<uint64_t> sizes(pieces.size(), 0);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  const uint8_t include_flags =
+      rocksdb::DB::INCLUDE_FILES | rocksdb::DB::INCLUDE_MEMTABLES;
+  rdb->GetApproximateSizes(cfh, pieces.data(), pieces.size(), sizes.data(),
+                           include_flags);
+#pragma GCC diagnostic pop
+
+  /* Keys are counted at the average size of the entries of the files */
+  const double bytes_per_key =
+      files_entries > 0 ? static_cast<double>(files_size) / files_entries : 0;
+
+  const uint64_t slice_size = rocksdb_drop_index_slice_size;
+  size_t slice_start = 0;
+  uint64_t slice_bytes = 0;
+  for (size_t i = 0; i < pieces.size(); i++) {
+    slice_bytes += sizes[i];
+    if (slice_bytes < slice_size && i + 1 < pieces.size()) {
+      continue;
+    }
+
+    if (rocksdb_drop_index_bytes_per_sec != 0) {
+      const int64_t burst = std::max<int64_t>(
+          rocksdb_drop_index_rate_limiter->GetSingleBurstBytes(), 1);
+      for (int64_t left = slice_bytes; left > 0; left -= burst) {
+        if (m_killed) {
+          return rocksdb::Status::ShutdownInProgress();
+        }
+        rocksdb_drop_index_rate_limiter->Request(
+            std::min(left, burst), rocksdb::Env::IO_LOW, nullptr,
+            rocksdb::RateLimiter::OpType::kWrite);
+      }
+    }
+    if (m_killed) {
+      return rocksdb::Status::ShutdownInProgress();
+    }
+
+    const rocksdb::Status status = rdb->GetBaseDB()->DeleteRange(
+        rocksdb::WriteOptions(), cfh, cuts[slice_start], cuts[i + 1]);
+    if (!status.ok()) {
+      return status;
+    }
+
+    RDB_MUTEX_LOCK_CHECK(m_progress_mutex);
+    Rdb_drop_index_progress &progress = m_progress[gl_index_id];
+    progress.cf_id = gl_index_id.cf_id;
+    progress.index_id = gl_index_id.index_id;
+    progress.slices++;
+    if (bytes_per_key > 0) {
+      progress.keys_deleted +=
+          static_cast<ulonglong>(slice_bytes / bytes_per_key);
+    }
+    progress.bytes_reclaimed += slice_bytes;
+    RDB_MUTEX_UNLOCK_CHECK(m_progress_mutex);
+
+    slice_start = i + 1;
+    slice_bytes = 0;
+  }
+
+  return rocksdb::Status::OK();
+}
+
+Rdb_drop_index_progress Rdb_drop_index_thread::get_progress(
+    const GL_INDEX_ID &gl_index_id) {
+  Rdb_drop_index_progress progress = {gl_index_id.cf_id, gl_index_id.index_id,
+                                      0, 0, 0};
+  RDB_MUTEX_LOCK_CHECK(m_progress_mutex);
+  const auto it = m_progress.find(gl_index_id);
+  if (it != m_progress.end()) {
+    progress = it->second;
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_progress_mutex);
+  return progress;
+}
+
 /*
   Drop index thread's main logic
 */
@@ -12104,6 +13100,22 @@ void Rdb_drop_index_thread::run() {
         rocksdb::Range range = get_range(d.index_id, buf, is_reverse_cf ? 1 : 0,
                                          is_reverse_cf ? 0 : 1);
 
+        if (rocksdb_drop_index_slice_size != 0) {
+          const rocksdb::Status status =
+              delete_index_slices(d, cfh.get(), range);
+          if (!status.ok()) {
+            if (status.IsShutdownInProgress()) {
+              break;
+            }
+            rdb_handle_io_error(status, RDB_IO_ERROR_BG_THREAD);
+          }
+          if (is_myrocks_index_empty(cfh.get(), is_reverse_cf, read_opts,
+                                     d.index_id)) {
+            finished.insert(d);
+          }
+          continue;
+        }
+
         rocksdb::Status status = DeleteFilesInRange(rdb->GetBaseDB(), cfh.get(),
                                                     &range.start, &range.limit);
         if (!status.ok()) {
@@ -12133,6 +13145,16 @@ void Rdb_drop_index_thread::run() {
 
       if (!finished.empty()) {
         dict_manager.finish_drop_indexes(finished);
+
+        RDB_MUTEX_LOCK_CHECK(m_progress_mutex);
+        for (const auto d : finished) {
+          m_progress.erase(d);
+        }
+        RDB_MUTEX_UNLOCK_CHECK(m_progress_mutex);
+
+        for (const auto d : finished) {
+          rdb_bg_thread.remove_index_compaction_stats(d);
+        }
       }
     }
 
@@ -12614,6 +13636,14 @@ void ha_rocksdb::records_in_range_internal(uint inx, key_range *const min_key,
   rdb->GetApproximateSizes(kd.get_cf(), &r, 1, &sz, include_flags);
   *row_count = rows * ((double)sz / (double)disk_size);
   *total_size = sz;
+  if (THDVAR(ha_thd(), records_in_range_use_histograms)) {
+    const auto histogram = kd.get_histogram();
+    if (histogram && !histogram->empty()) {
+      // Bounds are ordered bytewise, like slice1 and slice2 are
+      *row_count = static_cast<ulonglong>(histogram->rows_upto(slice2) -
+                                          histogram->rows_upto(slice1));
+    }
+  }
   uint64_t memTableCount;
   rdb->GetApproximateMemTableStats(kd.get_cf(), r, &memTableCount, &sz);
   *row_count += memTableCount;
@@ -13608,8 +14638,685 @@ bool ha_rocksdb::inplace_alter_table(
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
 
-/**
- Scan the Primary Key index entries and populate the new secondary keys.
+/*
+  Split an index into at most n_parts key ranges that hold about the same
+  amount of data, judging by the SST files of its column family. Returns the
+  keys that separate the ranges, in column family order. Data that is only
+  in memtables is not accounted for, so indexes that are small or were not
+  flushed yet are not split at all.
+*/
+static std::vector<std::string> rdb_split_index(const Rdb_key_def &kd,
+                                                const uint n_parts) {
+  std::vector<std::string> splits;
+  if (n_parts <= 1) {
+    return splits;
+  }
+
+  /* The files that start inside the index */
+  const std::vector<rocksdb::LiveFileMetaData> files = rdb_get_cf_files(
+      kd.get_cf(), [&kd](const rocksdb::LiveFileMetaData &file) {
+        return kd.covers_key(rocksdb::Slice(file.smallestkey));
+      });
+  uint64_t total_size = 0;
+  for (const auto &file : files) {
+    total_size += file.size;
+  }
+
+  const rocksdb::Comparator *const cmp = kd.get_cf()->GetComparator();
+
+  /* Cut at the start of the file that crosses the next 1/n_parts of data */
+  uint64_t size = 0;
+  for (const auto &file : files) {
+    if (splits.size() == n_parts - 1) {
+      break;
+    }
+    if (size >= total_size * (splits.size() + 1) / n_parts &&
+        (splits.empty() ||
+         cmp->Compare(file.smallestkey, splits.back()) != 0)) {
+      splits.push_back(file.smallestkey);
+    }
+    size += file.size;
+  }
+  return splits;
+}
+
+/*
+  Thread that scans one key range of the primary key as part of a parallel
+  scan, see ha_rocksdb::run_parallel_pk_scan(). Subclasses handle the rows
+  in process_row().
+
+  Rows that are decoded are collected in batches of PK_SCAN_BATCH_ROWS
+  rows and decoded with Rdb_converter::decode_batch(), each row into its
+  own record buffer.
+
+  Decoding a row moves the Field objects of the table around, so each
+  thread decodes into its own copy of the TABLE. Everything that needs the
+  connection (opening the copies, creating the iterator, reporting errors
+  and statistics) is done by the connection thread in prepare(); the scan
+  only reads the THD to notice that the statement was killed.
+*/
+class Rdb_pk_scan_thread : public Rdb_thread {
+ public:
+  Rdb_pk_scan_thread(THD *const thd, const Rdb_tbl_def *const tbl_def,
+                     const std::shared_ptr<Rdb_key_def> &pk_def,
+                     const bool decode_rows)
+      : m_thd(thd),
+        m_tbl_def(tbl_def),
+        m_pk_def(pk_def),
+        m_decode_rows(decode_rows) {}
+
+  ~Rdb_pk_scan_thread() override {
+    m_scan_it.reset();
+    m_converter.reset();
+    if (m_table_opened) {
+      closefrm(&m_table, false);
+    }
+  }
+
+  /*
+    Prepare to scan [lower_bound, upper_bound) of the primary key, in column
+    family order, within the snapshot of tx. Threads of the same scan share
+    the failed flag, so that they stop when one of them fails.
+  */
+  int prepare(TABLE *const table, Rdb_transaction *const tx,
+              const std::string &lower_bound, const std::string &upper_bound,
+              const bool verify_checksums, std::atomic<bool> *const failed) {
+    m_failed = failed;
+
+    if (m_decode_rows) {
+      if (open_table_from_share(m_thd, table->s, "", 0,
+                                (uint)(OPEN_FRM_FILE_ONLY | READ_ALL), 0,
+                                &m_table, false)) {
+        return HA_EXIT_FAILURE;
+      }
+      m_table_opened = true;
+      restore_record(&m_table, s->default_values);
+
+      m_converter.reset(new Rdb_converter(m_thd, m_tbl_def, &m_table));
+      m_converter->setup_field_decoders(
+          m_table.read_set, ha_rocksdb::pk_index(&m_table, m_tbl_def), false,
+          true);
+      m_converter->set_verify_row_debug_checksums(verify_checksums);
+
+      m_batch_records.resize(PK_SCAN_BATCH_ROWS * m_table.s->rec_buff_length);
+      for (uint i = 0; i < PK_SCAN_BATCH_ROWS; i++) {
+        memcpy(batch_record(i), m_table.s->default_values,
+               m_table.s->rec_buff_length);
+      }
+    }
+
+    m_lower_bound = lower_bound;
+    m_upper_bound = upper_bound;
+    m_lower_bound_slice = rocksdb::Slice(m_lower_bound);
+    m_upper_bound_slice = rocksdb::Slice(m_upper_bound);
+    m_scan_it.reset(tx->get_iterator(
+        m_pk_def->get_cf(), true, !THDVAR(m_thd, skip_fill_cache),
+        m_lower_bound_slice, m_upper_bound_slice));
+    m_snapshot_timestamp = tx->m_snapshot_timestamp;
+
+    return prepare_range(table);
+  }
+
+  void run() override {
+    m_result = scan();
+    if (m_result != HA_EXIT_SUCCESS) {
+      m_failed->store(true);
+    }
+  }
+
+  int result() const { return m_result; }
+  const rocksdb::Status &status() const { return m_status; }
+  ulonglong rows_read() const { return m_rows_read; }
+  ulonglong rows_filtered() const { return m_rows_filtered; }
+
+ protected:
+  /* Setup of the subclass, done in the connection thread */
+  virtual int prepare_range(TABLE *const table MY_ATTRIBUTE((__unused__))) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  /*
+    Handle one visible row of the range. If rows are decoded, record is the
+    decoded row in a record buffer of m_table, otherwise it is nullptr.
+  */
+  virtual int process_row(const rocksdb::Slice &key,
+                          const rocksdb::Slice &value, uchar *const record) = 0;
+
+  THD *const m_thd;
+  const Rdb_tbl_def *const m_tbl_def;
+  const std::shared_ptr<Rdb_key_def> m_pk_def;
+  TABLE m_table;
+  std::unique_ptr<Rdb_converter> m_converter;
+
+ private:
+  int scan() {
+    const rocksdb::Comparator *const cmp =
+        m_pk_def->get_cf()->GetComparator();
+
+    DBUG_EXECUTE_IF("rocksdb_pk_scan_thread_fail",
+                    { return HA_ERR_INTERNAL_ERROR; });
+
+    for (m_scan_it->Seek(m_lower_bound_slice);
+         is_valid_iterator(m_scan_it.get()); m_scan_it->Next()) {
+      if (m_thd->killed) {
+        return HA_ERR_QUERY_INTERRUPTED;
+      }
+      /* Another thread failed, it reports the error */
+      if (m_failed->load()) {
+        return HA_EXIT_SUCCESS;
+      }
+
+      const rocksdb::Slice key = m_scan_it->key();
+      if (!m_pk_def->covers_key(key) ||
+          cmp->Compare(key, m_upper_bound_slice) >= 0) {
+        break;
+      }
+
+      const rocksdb::Slice value = m_scan_it->value();
+      if (m_pk_def->has_ttl() &&
+          rdb_is_ttl_rec_expired(*m_pk_def, value, m_snapshot_timestamp)) {
+        m_rows_filtered++;
+        continue;
+      }
+
+      int res;
+      if (!m_decode_rows) {
+        if ((res = process_row(key, value, nullptr))) {
+          return res;
+        }
+        m_rows_read++;
+        continue;
+      }
+
+      // The iterator's slices only live until Next(), keep copies
+      m_batch_rows.push_back(
+          std::make_tuple(m_batch_data.size(), key.size(), value.size()));
+      m_batch_data.append(key.data(), key.size());
+      m_batch_data.append(value.data(), value.size());
+      if (m_batch_rows.size() == PK_SCAN_BATCH_ROWS &&
+          (res = process_batch())) {
+        return res;
+      }
+    }
+
+    int res;
+    if (!m_batch_rows.empty() && (res = process_batch())) {
+      return res;
+    }
+
+    m_status = m_scan_it->status();
+    if (!m_status.ok()) {
+      // NO_LINT_DEBUG
+      sql_print_error("Error retrieving index entry from primary key.");
+      return HA_EXIT_FAILURE;
+    }
+    return HA_EXIT_SUCCESS;
+  }
+
+  /* Decode the collected rows and process them */
+  int process_batch() {
+    const uint n_rows = m_batch_rows.size();
+    m_batch_keys.clear();
+    m_batch_values.clear();
+    for (const auto &row : m_batch_rows) {
+      size_t offset, key_len, value_len;
+      std::tie(offset, key_len, value_len) = row;
+      m_batch_keys.emplace_back(m_batch_data.data() + offset, key_len);
+      m_batch_values.emplace_back(m_batch_data.data() + offset + key_len,
+                                  value_len);
+    }
+
+    int res = m_converter->decode_batch(
+        m_pk_def, n_rows, m_batch_keys.data(), m_batch_values.data(),
+        batch_record(0), m_table.s->rec_buff_length);
+    for (uint i = 0; i < n_rows && res == HA_EXIT_SUCCESS; i++) {
+      if ((res = process_row(m_batch_keys[i], m_batch_values[i],
+                             batch_record(i))) == HA_EXIT_SUCCESS) {
+        m_rows_read++;
+      }
+    }
+
+    m_batch_rows.clear();
+    m_batch_data.clear();
+    return res;
+  }
+
+  uchar *batch_record(const uint i) {
+    return m_batch_records.data() + i * m_table.s->rec_buff_length;
+  }
+
+  static const uint PK_SCAN_BATCH_ROWS = 64;
+
+  const bool m_decode_rows;
+  bool m_table_opened = false;
+  std::atomic<bool> *m_failed = nullptr;
+
+  std::string m_lower_bound;
+  std::string m_upper_bound;
+  rocksdb::Slice m_lower_bound_slice;
+  rocksdb::Slice m_upper_bound_slice;
+  std::unique_ptr<rocksdb::Iterator> m_scan_it;
+  int64_t m_snapshot_timestamp = 0;
+
+  // Rows collected for the next batch, as offset, key and value length
+  std::vector<std::tuple<size_t, size_t, size_t>> m_batch_rows;
+  std::string m_batch_data;
+  std::vector<rocksdb::Slice> m_batch_keys;
+  std::vector<rocksdb::Slice> m_batch_values;
+  std::vector<uchar> m_batch_records;
+
+  int m_result = HA_EXIT_SUCCESS;
+  rocksdb::Status m_status;
+  ulonglong m_rows_read = 0;
+  ulonglong m_rows_filtered = 0;
+};
+
+/* Counts the rows of its range, for ha_rocksdb::records() */
+class Rdb_pk_count_thread : public Rdb_pk_scan_thread {
+ public:
+  Rdb_pk_count_thread(THD *const thd, const Rdb_tbl_def *const tbl_def,
+                      const std::shared_ptr<Rdb_key_def> &pk_def)
+      : Rdb_pk_scan_thread(thd, tbl_def, pk_def, false) {}
+
+ protected:
+  int process_row(const rocksdb::Slice &key MY_ATTRIBUTE((__unused__)),
+                  const rocksdb::Slice &value MY_ATTRIBUTE((__unused__)),
+                  uchar *const record MY_ATTRIBUTE((__unused__))) override {
+    return HA_EXIT_SUCCESS;
+  }
+};
+
+/*
+  Adds up the row checksums of its range, for ha_rocksdb::checksum(). The
+  rows are checksummed by calc_row_checksum(), as mysql_checksum_table()
+  does for engines without a live checksum, so that CHECKSUM TABLE gives
+  the same result either way.
+*/
+class Rdb_pk_checksum_thread : public Rdb_pk_scan_thread {
+ public:
+  Rdb_pk_checksum_thread(THD *const thd, const Rdb_tbl_def *const tbl_def,
+                         const std::shared_ptr<Rdb_key_def> &pk_def)
+      : Rdb_pk_scan_thread(thd, tbl_def, pk_def, true) {}
+
+  ha_checksum checksum() const { return m_checksum; }
+
+ protected:
+  int process_row(const rocksdb::Slice &key MY_ATTRIBUTE((__unused__)),
+                  const rocksdb::Slice &value MY_ATTRIBUTE((__unused__)),
+                  uchar *const record) override {
+    m_checksum += calc_row_checksum(&m_table, record);
+    return HA_EXIT_SUCCESS;
+  }
+
+ private:
+  ha_checksum m_checksum = 0;
+};
+
+/**
+  Scan the primary key with the given threads, one per key range between
+  the split keys, and wait for all of them to finish. The rows they read
+  are accounted to this handler.
+*/
+int ha_rocksdb::run_parallel_pk_scan(
+    const std::vector<std::string> &splits,
+    const std::vector<std::unique_ptr<Rdb_pk_scan_thread>> &threads) {
+  DBUG_ENTER_FUNC();
+  DBUG_ASSERT(threads.size() == splits.size() + 1);
+
+  THD *const thd = ha_thd();
+  Rdb_transaction *const tx = get_or_create_tx(thd);
+  const Rdb_key_def &pk_def = *m_key_descr_arr[pk_index(table, m_tbl_def)];
+
+  /* Range boundaries: the whole primary key, cut at the split keys */
+  uchar lower_buf[Rdb_key_def::INDEX_NUMBER_SIZE];
+  uchar upper_buf[Rdb_key_def::INDEX_NUMBER_SIZE];
+  uint size;
+  pk_def.get_infimum_key(lower_buf, &size);
+  rocksdb::Slice lower_slice;
+  rocksdb::Slice upper_slice;
+  setup_iterator_bounds(pk_def,
+                        rocksdb::Slice(reinterpret_cast<char *>(lower_buf),
+                                       Rdb_key_def::INDEX_NUMBER_SIZE),
+                        Rdb_key_def::INDEX_NUMBER_SIZE, lower_buf, upper_buf,
+                        &lower_slice, &upper_slice);
+  std::vector<std::string> bounds;
+  bounds.push_back(lower_slice.ToString());
+  bounds.insert(bounds.end(), splits.begin(), splits.end());
+  bounds.push_back(upper_slice.ToString());
+
+  std::atomic<bool> failed(false);
+  size_t n_started = 0;
+  int res = HA_EXIT_SUCCESS;
+  for (; n_started < threads.size(); n_started++) {
+    Rdb_pk_scan_thread *const thread = threads[n_started].get();
+    if ((res = thread->prepare(
+             table, tx, bounds[n_started], bounds[n_started + 1],
+             m_converter->get_verify_row_debug_checksums(), &failed))) {
+      break;
+    }
+
+#ifdef HAVE_PSI_INTERFACE
+    thread->init(rdb_signal_pk_scan_psi_mutex_key,
+                 rdb_signal_pk_scan_psi_cond_key);
+    const int err = thread->create_thread(PK_SCAN_THREAD_NAME,
+                                          rdb_pk_scan_psi_thread_key);
+#else
+    thread->init();
+    const int err = thread->create_thread(PK_SCAN_THREAD_NAME);
+#endif
+    if (err != 0) {
+      // NO_LINT_DEBUG
+      sql_print_error(
+          "RocksDB: Couldn't start the parallel scan thread: (errno=%d)",
+          err);
+      thread->uninit();
+      res = HA_EXIT_FAILURE;
+      break;
+    }
+  }
+
+  /* Stop the threads that were started if not all of them could be */
+  if (res != HA_EXIT_SUCCESS) {
+    failed.store(true);
+  }
+
+  ulonglong rows_read = 0;
+  ulonglong rows_filtered = 0;
+  for (size_t i = 0; i < n_started; i++) {
+    Rdb_pk_scan_thread *const thread = threads[i].get();
+    thread->join();
+    rows_read += thread->rows_read();
+    rows_filtered += thread->rows_filtered();
+    if (res == HA_EXIT_SUCCESS && thread->result() != HA_EXIT_SUCCESS) {
+      res = thread->status().ok() ? thread->result()
+                                  : rdb_error_to_mysql(thread->status());
+    }
+  }
+
+  update_row_read(rows_read);
+  thd->inc_examined_row_count(rows_read + rows_filtered);
+  if (rows_filtered > 0) {
+    update_row_stats(ROWS_FILTERED, rows_filtered);
+  }
+  DBUG_RETURN(res);
+}
+
+/*
+  Table flags for the statements that a parallel primary key scan serves:
+  COUNT(*) without conditions through records(), and CHECKSUM TABLE through
+  checksum(). The flags are read again whenever the table is locked, so
+  they follow the session variable and the statement.
+*/
+ulonglong ha_rocksdb::parallel_scan_flags() const {
+  THD *const thd = ha_thd();
+  if (thd == nullptr || THDVAR(thd, parallel_scan_threads) <= 1) {
+    return 0;
+  }
+  return HA_HAS_RECORDS |
+         (my_core::thd_sql_command(thd) == SQLCOM_CHECKSUM ? HA_HAS_CHECKSUM
+                                                           : 0);
+}
+
+/*
+  Exact number of rows, counted by scanning the primary key in parallel.
+  Only offered (see parallel_scan_flags()) when
+  rocksdb_parallel_scan_threads > 1.
+*/
+ha_rows ha_rocksdb::records() {
+  DBUG_ENTER_FUNC();
+
+  THD *const thd = ha_thd();
+  const std::shared_ptr<Rdb_key_def> &pk_def =
+      m_key_descr_arr[pk_index(table, m_tbl_def)];
+  const std::vector<std::string> splits =
+      rdb_split_index(*pk_def, THDVAR(thd, parallel_scan_threads));
+
+  std::vector<std::unique_ptr<Rdb_pk_scan_thread>> threads;
+  for (size_t i = 0; i <= splits.size(); i++) {
+    threads.emplace_back(new Rdb_pk_count_thread(thd, m_tbl_def, pk_def));
+  }
+  if (run_parallel_pk_scan(splits, threads)) {
+    /* The optimizer then counts the rows itself */
+    DBUG_RETURN(HA_POS_ERROR);
+  }
+
+  ha_rows count = 0;
+  for (const auto &thread : threads) {
+    count += thread->rows_read();
+  }
+  DBUG_RETURN(count);
+}
+
+/*
+  Table checksum for CHECKSUM TABLE, computed by scanning the primary key
+  in parallel. Only offered (see parallel_scan_flags()) for that statement
+  when rocksdb_parallel_scan_threads > 1; CHECKSUM TABLE ... EXTENDED still
+  reads the rows through rnd_next() and gives the same result. If the scan
+  fails, the handler error is raised on the connection and the returned
+  checksum is meaningless.
+*/
+uint ha_rocksdb::checksum() const {
+  DBUG_ENTER_FUNC();
+
+  /* handler::checksum() is const, but scanning updates the statistics */
+  ha_rocksdb *const self = const_cast<ha_rocksdb *>(this);
+  THD *const thd = ha_thd();
+  const std::shared_ptr<Rdb_key_def> &pk_def =
+      m_key_descr_arr[pk_index(table, m_tbl_def)];
+  const std::vector<std::string> splits =
+      rdb_split_index(*pk_def, THDVAR(thd, parallel_scan_threads));
+
+  std::vector<std::unique_ptr<Rdb_pk_scan_thread>> threads;
+  for (size_t i = 0; i <= splits.size(); i++) {
+    threads.emplace_back(new Rdb_pk_checksum_thread(thd, m_tbl_def, pk_def));
+  }
+  const int res = self->run_parallel_pk_scan(splits, threads);
+  if (res) {
+    /* checksum() can only return the checksum, report the error here */
+    self->print_error(res, MYF(0));
+    DBUG_RETURN(0);
+  }
+
+  ha_checksum crc = 0;
+  for (const auto &thread : threads) {
+    crc += static_cast<const Rdb_pk_checksum_thread *>(thread.get())
+               ->checksum();
+  }
+  DBUG_RETURN(crc);
+}
+
+/*
+  Thread that packs the keys of a new secondary key for the rows of its
+  range of the primary key and sorts them in its own Rdb_index_merge, for
+  ha_rocksdb::inplace_populate_sk(). Packing the key moves the Field objects
+  of the new table, so the thread packs with its own copy of it.
+*/
+class Rdb_sk_build_thread : public Rdb_pk_scan_thread {
+ public:
+  Rdb_sk_build_thread(THD *const thd, const Rdb_tbl_def *const tbl_def,
+                      const std::shared_ptr<Rdb_key_def> &pk_def,
+                      TABLE *const new_table,
+                      const std::shared_ptr<Rdb_key_def> &index,
+                      std::unique_ptr<Rdb_index_merge> &&merge,
+                      const bool store_checksums, const int checksums_pct)
+      : Rdb_pk_scan_thread(thd, tbl_def, pk_def, true),
+        m_new_table_arg(new_table),
+        m_index(index),
+        m_merge(std::move(merge)),
+        m_store_checksums(store_checksums),
+        m_checksums_pct(checksums_pct) {}
+
+  ~Rdb_sk_build_thread() override {
+    if (m_new_table_opened) {
+      closefrm(&m_new_table, false);
+    }
+    my_free(m_pack_buffer);
+    my_free(m_sk_packed_tuple);
+  }
+
+  std::unique_ptr<Rdb_index_merge> release_merge() {
+    return std::move(m_merge);
+  }
+
+  /* The entry that failed with ER_DUP_ENTRY, see process_row() */
+  const std::string &dup_key() const { return m_dup_key; }
+  const std::string &dup_val() const { return m_dup_val; }
+
+ protected:
+  int prepare_range(TABLE *const table MY_ATTRIBUTE((__unused__))) override {
+    int res;
+    if ((res = m_merge->init())) {
+      return res;
+    }
+
+    if (open_table_from_share(m_thd, m_new_table_arg->s, "", 0,
+                              (uint)(OPEN_FRM_FILE_ONLY | READ_ALL), 0,
+                              &m_new_table, false)) {
+      return HA_EXIT_FAILURE;
+    }
+    m_new_table_opened = true;
+    restore_record(&m_new_table, s->default_values);
+
+    const uint max_packed_len = m_index->max_storage_fmt_length();
+    m_pack_buffer =
+        reinterpret_cast<uchar *>(my_malloc(max_packed_len, MYF(0)));
+    m_sk_packed_tuple =
+        reinterpret_cast<uchar *>(my_malloc(max_packed_len, MYF(0)));
+    if (m_pack_buffer == nullptr || m_sk_packed_tuple == nullptr) {
+      return HA_ERR_OUT_OF_MEM;
+    }
+
+    m_hidden_pk_exists = Rdb_key_def::table_has_hidden_pk(&m_table);
+    return HA_EXIT_SUCCESS;
+  }
+
+  int process_row(const rocksdb::Slice &key, const rocksdb::Slice &value,
+                  uchar *const record) override {
+    int res;
+    longlong hidden_pk_id = 0;
+    if (m_hidden_pk_exists &&
+        (res = rdb_read_hidden_pk_id(key, &hidden_pk_id))) {
+      // NO_LINT_DEBUG
+      sql_print_error("Error retrieving hidden pk id.");
+      return res;
+    }
+
+    const bool store_checksums =
+        m_store_checksums && (rand() % 100 < m_checksums_pct);
+    const int new_packed_size = m_index->pack_record(
+        &m_new_table, m_pack_buffer, record, m_sk_packed_tuple, &m_sk_tails,
+        store_checksums, hidden_pk_id, 0, nullptr,
+        m_pk_def->has_ttl() ? value.data() : nullptr);
+
+    const rocksdb::Slice sk_key = rocksdb::Slice(
+        reinterpret_cast<const char *>(m_sk_packed_tuple), new_packed_size);
+    const rocksdb::Slice sk_val =
+        rocksdb::Slice(reinterpret_cast<const char *>(m_sk_tails.ptr()),
+                       m_sk_tails.get_current_pos());
+    res = m_merge->add(sk_key, sk_val);
+    DBUG_EXECUTE_IF("rocksdb_sk_build_thread_dup_key", {
+      if (res == HA_EXIT_SUCCESS) {
+        res = m_merge->add(sk_key, sk_val);
+      }
+    });
+
+    /*
+      This thread has no connection to report the duplicate to, keep the
+      entry for ha_rocksdb::inplace_populate_sk_parallel() to report it.
+    */
+    if (res == ER_DUP_ENTRY) {
+      m_dup_key.assign(sk_key.data(), sk_key.size());
+      m_dup_val.assign(sk_val.data(), sk_val.size());
+    }
+    return res;
+  }
+
+ private:
+  TABLE *const m_new_table_arg;
+  const std::shared_ptr<Rdb_key_def> m_index;
+  std::unique_ptr<Rdb_index_merge> m_merge;
+  const bool m_store_checksums;
+  const int m_checksums_pct;
+
+  TABLE m_new_table;
+  bool m_new_table_opened = false;
+  bool m_hidden_pk_exists = false;
+  uchar *m_pack_buffer = nullptr;
+  uchar *m_sk_packed_tuple = nullptr;
+  Rdb_string_writer m_sk_tails;
+  std::string m_dup_key;
+  std::string m_dup_val;
+};
+
+/**
+  Scan the primary key with one thread per key range between the given split
+  keys, and sort the entries of the new secondary key index in one
+  Rdb_index_merge per range. The merges are returned in key range order.
+  A duplicate entry that a thread runs into is reported here, as the
+  connection thread is the one that can raise the error.
+*/
+int ha_rocksdb::inplace_populate_sk_parallel(
+    TABLE *const new_table_arg, const std::shared_ptr<Rdb_key_def> &index,
+    const std::vector<std::string> &splits,
+    std::vector<std::unique_ptr<Rdb_index_merge>> *const merges) {
+  DBUG_ENTER_FUNC();
+
+  THD *const thd = ha_thd();
+  Rdb_transaction *const tx = get_or_create_tx(thd);
+  const std::shared_ptr<Rdb_key_def> &pk_def =
+      m_key_descr_arr[pk_index(table, m_tbl_def)];
+
+  /* The memory budget for reading the sorted runs back is shared */
+  const uint n_threads = splits.size() + 1;
+  const ulonglong combine_read_size = std::max<ulonglong>(
+      THDVAR(thd, merge_combine_read_size) / n_threads,
+      RDB_MIN_MERGE_COMBINE_READ_SIZE);
+
+  std::vector<std::unique_ptr<Rdb_pk_scan_thread>> threads;
+  for (uint i = 0; i < n_threads; i++) {
+    std::unique_ptr<Rdb_index_merge> merge(new Rdb_index_merge(
+        tx->get_rocksdb_tmpdir(), THDVAR(thd, merge_buf_size),
+        combine_read_size, THDVAR(thd, merge_tmp_file_removal_delay_ms),
+        index->get_cf()));
+    threads.emplace_back(new Rdb_sk_build_thread(
+        thd, m_tbl_def, pk_def, new_table_arg, index, std::move(merge),
+        m_store_row_debug_checksums, m_checksums_pct));
+  }
+
+  const int res = run_parallel_pk_scan(splits, threads);
+  if (res == HA_EXIT_SUCCESS) {
+    for (const auto &thread : threads) {
+      merges->push_back(
+          static_cast<Rdb_sk_build_thread *>(thread.get())->release_merge());
+    }
+  } else if (res == ER_DUP_ENTRY) {
+    for (const auto &thread : threads) {
+      const Rdb_sk_build_thread *const sk_thread =
+          static_cast<const Rdb_sk_build_thread *>(thread.get());
+      if (sk_thread->result() != ER_DUP_ENTRY) {
+        continue;
+      }
+
+      /* print_keydup_error() shows the row in new_table_arg->record[0] */
+      const rocksdb::Slice dup_key(sk_thread->dup_key());
+      const rocksdb::Slice dup_val(sk_thread->dup_val());
+      if (index->unpack_record(new_table_arg, new_table_arg->record[0],
+                               &dup_key, &dup_val,
+                               m_converter->get_verify_row_debug_checksums())) {
+        /* Should never reach here */
+        DBUG_ASSERT(0);
+      }
+      print_keydup_error(new_table_arg,
+                         &new_table_arg->key_info[index->get_keyno()], MYF(0),
+                         thd);
+      break;
+    }
+  }
+  DBUG_RETURN(res);
+}
+
+/**
+ Scan the Primary Key index entries and populate the new secondary keys.
 */
 int ha_rocksdb::inplace_populate_sk(
     TABLE *const new_table_arg,
@@ -13711,70 +15418,89 @@ int ha_rocksdb::inplace_populate_sk(
   const ulonglong rdb_merge_tmp_file_removal_delay =
       THDVAR(ha_thd(), merge_tmp_file_removal_delay_ms);
 
+  /*
+    Note: We pass in the currently existing table + tbl_def object here,
+    as the pk index position may have changed in the case of hidden primary
+    keys.
+  */
+  const uint pk = pk_index(table, m_tbl_def);
+
+  /*
+    With rocksdb_merge_threads > 1, large primary keys are cut into ranges
+    that are scanned in parallel, see inplace_populate_sk_parallel().
+  */
+  const std::vector<std::string> splits =
+      rdb_split_index(*m_key_descr_arr[pk], THDVAR(ha_thd(), merge_threads));
+
   for (const auto &index : indexes) {
     bool is_unique_index =
         new_table_arg->key_info[index->get_keyno()].flags & HA_NOSAME;
 
-    Rdb_index_merge rdb_merge(tx->get_rocksdb_tmpdir(), rdb_merge_buf_size,
-                              rdb_merge_combine_read_size,
-                              rdb_merge_tmp_file_removal_delay,
-                              index->get_cf());
-
-    if ((res = rdb_merge.init())) {
-      DBUG_RETURN(res);
-    }
+    std::vector<std::unique_ptr<Rdb_index_merge>> merges;
+    if (!splits.empty()) {
+      if ((res = inplace_populate_sk_parallel(new_table_arg, index, splits,
+                                              &merges))) {
+        DBUG_RETURN(res);
+      }
+    } else {
+      std::unique_ptr<Rdb_index_merge> scan_merge(new Rdb_index_merge(
+          tx->get_rocksdb_tmpdir(), rdb_merge_buf_size,
+          rdb_merge_combine_read_size, rdb_merge_tmp_file_removal_delay,
+          index->get_cf()));
 
-    /*
-      Note: We pass in the currently existing table + tbl_def object here,
-      as the pk index position may have changed in the case of hidden primary
-      keys.
-    */
-    const uint pk = pk_index(table, m_tbl_def);
-    res = ha_index_init(pk, true);
-    if (res) DBUG_RETURN(res);
-
-    /* Scan each record in the primary key in order */
-    for (res = index_first(table->record[0]); res == 0;
-         res = index_next(table->record[0])) {
-      longlong hidden_pk_id = 0;
-      if (hidden_pk_exists &&
-          (res = read_hidden_pk_id_from_rowkey(&hidden_pk_id))) {
-        // NO_LINT_DEBUG
-        sql_print_error("Error retrieving hidden pk id.");
-        ha_index_end();
+      if ((res = scan_merge->init())) {
         DBUG_RETURN(res);
       }
 
-      /* Create new secondary index entry */
-      const int new_packed_size = index->pack_record(
-          new_table_arg, m_pack_buffer, table->record[0], m_sk_packed_tuple,
-          &m_sk_tails, should_store_row_debug_checksums(), hidden_pk_id, 0,
-          nullptr, m_ttl_bytes);
+      res = ha_index_init(pk, true);
+      if (res) DBUG_RETURN(res);
+
+      /* Scan each record in the primary key in order */
+      for (res = index_first(table->record[0]); res == 0;
+           res = index_next(table->record[0])) {
+        longlong hidden_pk_id = 0;
+        if (hidden_pk_exists &&
+            (res = read_hidden_pk_id_from_rowkey(&hidden_pk_id))) {
+          // NO_LINT_DEBUG
+          sql_print_error("Error retrieving hidden pk id.");
+          ha_index_end();
+          DBUG_RETURN(res);
+        }
+
+        /* Create new secondary index entry */
+        const int new_packed_size = index->pack_record(
+            new_table_arg, m_pack_buffer, table->record[0], m_sk_packed_tuple,
+            &m_sk_tails, should_store_row_debug_checksums(), hidden_pk_id, 0,
+            nullptr, m_ttl_bytes);
 
-      const rocksdb::Slice key = rocksdb::Slice(
-          reinterpret_cast<const char *>(m_sk_packed_tuple), new_packed_size);
-      const rocksdb::Slice val =
-          rocksdb::Slice(reinterpret_cast<const char *>(m_sk_tails.ptr()),
-                         m_sk_tails.get_current_pos());
+        const rocksdb::Slice key = rocksdb::Slice(
+            reinterpret_cast<const char *>(m_sk_packed_tuple), new_packed_size);
+        const rocksdb::Slice val =
+            rocksdb::Slice(reinterpret_cast<const char *>(m_sk_tails.ptr()),
+                           m_sk_tails.get_current_pos());
 
-      /*
-        Add record to offset tree in preparation for writing out to
-        disk in sorted chunks.
-      */
-      if ((res = rdb_merge.add(key, val))) {
+        /*
+          Add record to offset tree in preparation for writing out to
+          disk in sorted chunks.
+        */
+        if ((res = scan_merge->add(key, val))) {
+          ha_index_end();
+          DBUG_RETURN(res);
+        }
+      }
+
+      if (res != HA_ERR_END_OF_FILE) {
+        // NO_LINT_DEBUG
+        sql_print_error("Error retrieving index entry from primary key.");
         ha_index_end();
         DBUG_RETURN(res);
       }
-    }
 
-    if (res != HA_ERR_END_OF_FILE) {
-      // NO_LINT_DEBUG
-      sql_print_error("Error retrieving index entry from primary key.");
       ha_index_end();
-      DBUG_RETURN(res);
+      merges.push_back(std::move(scan_merge));
     }
 
-    ha_index_end();
+    Rdb_index_merge_union rdb_merge(std::move(merges));
 
     /*
       Perform an n-way merge of n sorted buffers on disk, then writes all
@@ -14535,6 +16261,20 @@ static SHOW_VAR rocksdb_status_vars[] = {
                        &rocksdb_select_bypass_rejected, SHOW_LONGLONG),
     DEF_STATUS_VAR_PTR("select_bypass_failed", &rocksdb_select_bypass_failed,
                        SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("scan_readahead_iterators",
+                       &rocksdb_scan_readahead_iterators, SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("scan_readahead_bytes", &rocksdb_scan_readahead_bytes,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("sk_lookup_batches", &rocksdb_sk_lookup_batches,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("sk_lookup_batched_rows",
+                       &rocksdb_sk_lookup_batched_rows, SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("pk_scan_batches", &rocksdb_pk_scan_batches,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("pk_scan_batched_rows", &rocksdb_pk_scan_batched_rows,
+                       SHOW_LONGLONG),
+    DEF_STATUS_VAR_PTR("write_batch_reads_skipped",
+                       &rocksdb_write_batch_reads_skipped, SHOW_LONGLONG),
     // the variables generated by SHOW_FUNC are sorted only by prefix (first
     // arg in the tuple below), so make sure it is unique to make sorting
     // deterministic as quick sort is not stable
@@ -14625,6 +16365,10 @@ void Rdb_background_thread::run() {
       }
     }
 
+    if (rdb) {
+      schedule_index_compactions();
+    }
+
     // Set the next timestamp for mysql_cond_timedwait() (which ends up calling
     // pthread_cond_timedwait()) to wait on.
     ts_next_sync.tv_sec = ts.tv_sec + WAKE_UP_INTERVAL;
@@ -14634,6 +16378,189 @@ void Rdb_background_thread::run() {
   ddl_manager.persist_stats();
 }
 
+void Rdb_background_thread::update_index_compaction_stats(
+    const Rdb_index_compaction_stats &stats) {
+  const GL_INDEX_ID gl_index_id = {stats.cf_id, stats.index_id};
+
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  auto it = m_index_compaction_stats.find(gl_index_id);
+  if (it == m_index_compaction_stats.end()) {
+    m_index_compaction_stats.emplace(gl_index_id, stats);
+  } else {
+    Rdb_index_compaction_stats &total = it->second;
+    total.rows_kept += stats.rows_kept;
+    total.bytes_kept += stats.bytes_kept;
+    total.rows_expired += stats.rows_expired;
+    total.bytes_expired += stats.bytes_expired;
+    total.rows_dropped += stats.rows_dropped;
+    total.bytes_dropped += stats.bytes_dropped;
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+}
+
+void Rdb_background_thread::update_cf_compaction_stats(
+    const Rdb_cf_compaction_stats &stats) {
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  auto it = m_cf_compaction_stats.find(stats.cf_id);
+  if (it == m_cf_compaction_stats.end()) {
+    m_cf_compaction_stats.emplace(stats.cf_id, stats);
+  } else {
+    Rdb_cf_compaction_stats &total = it->second;
+    total.compactions += stats.compactions;
+    total.cpu_micros += stats.cpu_micros;
+    total.input_records += stats.input_records;
+    total.output_records += stats.output_records;
+    total.input_deletions += stats.input_deletions;
+    total.dropped_deletions += stats.dropped_deletions;
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+}
+
+std::vector<Rdb_index_compaction_stats>
+Rdb_background_thread::get_index_compaction_stats() {
+  std::vector<Rdb_index_compaction_stats> stats;
+
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  for (const auto &it : m_index_compaction_stats) {
+    stats.push_back(it.second);
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+  return stats;
+}
+
+std::vector<Rdb_cf_compaction_stats>
+Rdb_background_thread::get_cf_compaction_stats() {
+  std::vector<Rdb_cf_compaction_stats> stats;
+
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  for (const auto &it : m_cf_compaction_stats) {
+    stats.push_back(it.second);
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+  return stats;
+}
+
+void Rdb_background_thread::remove_index_compaction_stats(
+    const GL_INDEX_ID &gl_index_id) {
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  m_index_compaction_stats.erase(gl_index_id);
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+}
+
+/*
+  Compact the whole of the indexes whose rows expire quickly.
+
+  Once rocksdb_auto_compact_index_min_rows rows of an index have gone
+  through the compaction filter since the last decision about it, the index
+  is compacted if at least rocksdb_auto_compact_index_expired_pct percent of
+  them had expired. The rest of the index then likely holds many expired
+  rows too, that regular compactions would only reach much later.
+
+  The compactions are run by the manual compaction thread one at a time, so
+  that they leave room for the ones users request, and the rows they filter
+  do not count for the next decision.
+*/
+void Rdb_background_thread::schedule_index_compactions() {
+  for (auto it = m_index_compactions.begin();
+       it != m_index_compactions.end();) {
+    const auto state = rdb_mc_thread.manual_compaction_state(it->second.mc_id);
+    if (state == Rdb_manual_compaction_thread::Manual_compaction_request::
+                     PENDING ||
+        state == Rdb_manual_compaction_thread::Manual_compaction_request::
+                     RUNNING) {
+      ++it;
+      continue;
+    }
+    rdb_mc_thread.set_client_done(it->second.mc_id);
+
+    RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+    const auto stats = m_index_compaction_stats.find(it->first);
+    if (stats != m_index_compaction_stats.end()) {
+      m_index_compaction_checks[it->first] = {
+          stats->second.rows_kept + stats->second.rows_expired,
+          stats->second.rows_expired};
+    }
+    RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+    it = m_index_compactions.erase(it);
+  }
+
+  const uint expired_pct = rocksdb_auto_compact_index_expired_pct;
+  if (expired_pct == 0) {
+    m_index_compaction_checks.clear();
+    return;
+  }
+
+  // Indexes that are gone are forgotten
+  std::map<GL_INDEX_ID, Rdb_index_compaction_check> checks;
+  for (const auto &stats : get_index_compaction_stats()) {
+    const GL_INDEX_ID gl_index_id = {stats.cf_id, stats.index_id};
+    const ulonglong rows = stats.rows_kept + stats.rows_expired;
+    Rdb_index_compaction_check &check = checks[gl_index_id];
+    check = {0, 0};
+
+    auto it = m_index_compaction_checks.find(gl_index_id);
+    if (it != m_index_compaction_checks.end()) {
+      check = it->second;
+    }
+    const ulonglong new_rows = rows - check.rows;
+    const ulonglong new_expired = stats.rows_expired - check.rows_expired;
+    if (new_rows < rocksdb_auto_compact_index_min_rows) {
+      continue;
+    }
+    check = {rows, stats.rows_expired};
+
+    if (new_expired * 100 >= new_rows * expired_pct &&
+        m_index_compactions.empty()) {
+      request_index_compaction(gl_index_id);
+    }
+  }
+  m_index_compaction_checks.swap(checks);
+}
+
+void Rdb_background_thread::request_index_compaction(
+    const GL_INDEX_ID &gl_index_id) {
+  const std::shared_ptr<const Rdb_key_def> kd =
+      ddl_manager.safe_find(gl_index_id);
+  if (!kd || dict_manager.is_drop_index_ongoing(gl_index_id)) {
+    return;
+  }
+  std::shared_ptr<rocksdb::ColumnFamilyHandle> cfh =
+      cf_manager.get_cf(gl_index_id.cf_id);
+  if (!cfh) {
+    return;
+  }
+
+  uchar buf[Rdb_key_def::INDEX_NUMBER_SIZE * 2];
+  const rocksdb::Range range = get_range(*kd, buf);
+
+  Rdb_index_compaction &compaction = m_index_compactions[gl_index_id];
+  compaction.start = range.start.ToString();
+  compaction.limit = range.limit.ToString();
+  compaction.start_slice = rocksdb::Slice(compaction.start);
+  compaction.limit_slice = rocksdb::Slice(compaction.limit);
+  compaction.mc_id = rdb_mc_thread.request_manual_compaction(
+      cfh, &compaction.start_slice, &compaction.limit_slice,
+      THDVAR(nullptr, manual_compaction_threads),
+      static_cast<rocksdb::BottommostLevelCompaction>(
+          THDVAR(nullptr, manual_compaction_bottommost_level)));
+  if (compaction.mc_id < 0) {
+    m_index_compactions.erase(gl_index_id);
+    return;
+  }
+
+  RDB_MUTEX_LOCK_CHECK(m_compaction_stats_mutex);
+  auto it = m_index_compaction_stats.find(gl_index_id);
+  if (it != m_index_compaction_stats.end()) {
+    it->second.auto_compactions++;
+  }
+  RDB_MUTEX_UNLOCK_CHECK(m_compaction_stats_mutex);
+
+  // NO_LINT_DEBUG
+  sql_print_information(
+      "RocksDB: Compacting index (%u,%u), manual compaction id %d",
+      gl_index_id.cf_id, gl_index_id.index_id, compaction.mc_id);
+}
+
 void Rdb_index_stats_thread::run() {
   const int WAKE_UP_INTERVAL = 1;
 #ifdef TARGET_OS_LINUX
@@ -15479,6 +17406,17 @@ void rocksdb_set_rate_limiter_bytes_per_sec(
   }
 }
 
+void rocksdb_set_drop_index_bytes_per_sec(
+    my_core::THD *const thd MY_ATTRIBUTE((__unused__)),
+    my_core::st_mysql_sys_var *const var MY_ATTRIBUTE((__unused__)),
+    void *const var_ptr MY_ATTRIBUTE((__unused__)), const void *const save) {
+  const uint64_t new_val = *static_cast<const uint64_t *>(save);
+  if (new_val != 0 && rocksdb_drop_index_rate_limiter != nullptr) {
+    rocksdb_drop_index_rate_limiter->SetBytesPerSecond(new_val);
+  }
+  rocksdb_drop_index_bytes_per_sec = new_val;
+}
+
 void rocksdb_set_sst_mgr_rate_bytes_per_sec(
     my_core::THD *const thd,
     my_core::st_mysql_sys_var *const var MY_ATTRIBUTE((__unused__)),
@@ -16714,4 +18652,7 @@ mysql_declare_plugin(rocksdb_se){
     myrocks::rdb_i_s_sst_props, myrocks::rdb_i_s_index_file_map,
     myrocks::rdb_i_s_lock_info, myrocks::rdb_i_s_trx_info,
     myrocks::rdb_i_s_deadlock_info,
-    myrocks::rdb_i_s_bypass_rejected_query_history mysql_declare_plugin_end;
+    myrocks::rdb_i_s_bypass_rejected_query_history,
+    myrocks::rdb_i_s_drop_index_progress,
+    myrocks::rdb_i_s_index_compaction_stats,
+    myrocks::rdb_i_s_cf_compaction_stats mysql_declare_plugin_end;
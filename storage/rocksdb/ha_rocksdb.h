@@ -22,6 +22,7 @@
 /* C++ standard header files */
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -70,6 +71,7 @@ namespace myrocks {
 
 class Rdb_converter;
 class Rdb_key_def;
+class Rdb_pk_scan_thread;
 class Rdb_tbl_def;
 class Rdb_transaction;
 class Rdb_transaction_impl;
@@ -158,6 +160,65 @@ class ha_rocksdb : public my_core::handler {
   rocksdb::Slice m_scan_it_lower_bound_slice;
   rocksdb::Slice m_scan_it_upper_bound_slice;
 
+  /*
+    Number of forward moves of m_scan_it since it was positioned, whether
+    start_scan_readahead() has decided about reading ahead for the scan,
+    and whether m_scan_it has been replaced by an iterator that reads ahead.
+  */
+  uint m_scan_it_nexts;
+  bool m_scan_it_readahead_checked;
+  bool m_scan_it_reads_ahead;
+
+  /*
+    Secondary index entries that a non-covering scan has read ahead of the
+    row it returned last, with their rows read by one MultiGet. See
+    fill_sk_batch().
+  */
+  struct Rdb_sk_batch_entry {
+    std::string m_sk_key;
+    std::string m_sk_value;
+    std::string m_pk;
+    /* The row is unpacked from the index entry and not read */
+    bool m_covered;
+    /* Index of the row in m_sk_batch_values */
+    uint m_slot;
+  };
+  std::vector<Rdb_sk_batch_entry> m_sk_batch;
+  std::unique_ptr<rocksdb::PinnableSlice[]> m_sk_batch_values;
+  std::vector<rocksdb::Status> m_sk_batch_statuses;
+  std::vector<rocksdb::Slice> m_sk_batch_keys;
+  /* Number of entries in m_sk_batch, and the next one to return */
+  uint m_sk_batch_size;
+  uint m_sk_batch_pos;
+  /* Number of entries to read ahead next time */
+  uint m_sk_batch_window;
+  bool m_sk_batch_forward;
+  /* Error that ended the batch, returned after its rows */
+  int m_sk_batch_rc;
+
+  /*
+    Rows of the primary key that a scan has read ahead of the row it
+    returned last, decoded together by Rdb_converter::decode_batch(). See
+    fill_pk_batch().
+  */
+  // Rows read ahead, as offset, key and value length in m_pk_batch_data
+  std::vector<std::tuple<size_t, size_t, size_t>> m_pk_batch_rows;
+  std::string m_pk_batch_data;
+  std::vector<rocksdb::Slice> m_pk_batch_keys;
+  std::vector<rocksdb::Slice> m_pk_batch_values;
+  /* One record buffer per row, rec_buff_length bytes apart */
+  std::vector<uchar> m_pk_batch_records;
+  /* Number of rows read ahead, and the next one to return */
+  uint m_pk_batch_size;
+  uint m_pk_batch_pos;
+  /* Number of rows to read ahead next time */
+  uint m_pk_batch_window;
+  bool m_pk_batch_forward;
+  /* The rows are in m_pk_batch_records, else they are decoded one by one */
+  bool m_pk_batch_decoded;
+  /* Error that ended the batch, returned after its rows */
+  int m_pk_batch_rc;
+
   Rdb_tbl_def *m_tbl_def;
 
   /* Primary Key encoder from KeyTupleFormat to StorageFormat */
@@ -327,6 +388,22 @@ class ha_rocksdb : public my_core::handler {
                            const bool use_all_keys, const uint eq_cond_len)
       MY_ATTRIBUTE((__nonnull__));
   void release_scan_iterator(void);
+  bool start_scan_readahead(const Rdb_key_def &kd, const bool move_forward);
+  bool use_sk_batch(const Rdb_key_def &kd) const;
+  int fill_sk_batch(const Rdb_key_def &kd, uchar *const buf,
+                    const bool move_forward)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  int read_sk_batch_row(const Rdb_key_def &kd, uchar *const buf)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  void reset_sk_batch();
+  bool use_pk_batch() const;
+  int fill_pk_batch(const bool move_forward)
+      MY_ATTRIBUTE((__warn_unused_result__));
+  int read_pk_batch_row(uchar *const buf)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  int next_pk_batch_row(uchar *const buf, const bool move_forward)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  void reset_pk_batch();
 
   rocksdb::Status get_for_update(Rdb_transaction *const tx,
                                  const Rdb_key_def &kd,
@@ -455,7 +532,8 @@ class ha_rocksdb : public my_core::handler {
                 HA_REC_NOT_IN_SEQ | HA_CAN_INDEX_BLOBS |
                 (m_pk_can_be_decoded ? HA_PRIMARY_KEY_IN_READ_INDEX : 0) |
                 HA_PRIMARY_KEY_REQUIRED_FOR_POSITION | HA_NULL_IN_KEY |
-                HA_PARTIAL_COLUMN_READ | HA_ONLINE_ANALYZE);
+                HA_PARTIAL_COLUMN_READ | HA_ONLINE_ANALYZE |
+                parallel_scan_flags());
   }
 
   bool init_with_fields() override;
@@ -883,6 +961,16 @@ class ha_rocksdb : public my_core::handler {
       TABLE *const table_arg,
       const std::unordered_set<std::shared_ptr<Rdb_key_def>> &indexes)
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  ulonglong parallel_scan_flags() const;
+  int run_parallel_pk_scan(
+      const std::vector<std::string> &splits,
+      const std::vector<std::unique_ptr<Rdb_pk_scan_thread>> &threads)
+      MY_ATTRIBUTE((__warn_unused_result__));
+  int inplace_populate_sk_parallel(
+      TABLE *const new_table_arg, const std::shared_ptr<Rdb_key_def> &index,
+      const std::vector<std::string> &splits,
+      std::vector<std::unique_ptr<Rdb_index_merge>> *const merges)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
 
   int finalize_bulk_load(bool print_client_error = true)
       MY_ATTRIBUTE((__warn_unused_result__));
@@ -953,6 +1041,9 @@ class ha_rocksdb : public my_core::handler {
                                   key_range *const max_key) override
       MY_ATTRIBUTE((__warn_unused_result__));
 
+  ha_rows records() override MY_ATTRIBUTE((__warn_unused_result__));
+  uint checksum() const override MY_ATTRIBUTE((__warn_unused_result__));
+
   int delete_table(Rdb_tbl_def *const tbl);
   int delete_table(const char *const from) override
       MY_ATTRIBUTE((__warn_unused_result__));
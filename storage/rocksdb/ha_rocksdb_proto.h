@@ -75,6 +75,9 @@ void rdb_get_global_perf_counters(Rdb_perf_counters *counters)
 
 void rdb_queue_save_stats_request();
 
+void rdb_update_index_compaction_stats(const Rdb_index_compaction_stats &stats);
+void rdb_update_cf_compaction_stats(const Rdb_cf_compaction_stats &stats);
+
 extern const std::string TRUNCATE_TABLE_PREFIX;
 
 /*
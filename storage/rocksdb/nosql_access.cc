@@ -56,6 +56,31 @@ static const size_t KEY_WRITER_DEFAULT_SIZE = 16;
 
 namespace myrocks {
 
+/* Whether a comparison result satisfies op_type, which is not IN */
+bool inline cmp_matches(Item_func::Functype op_type, int cmp) {
+  switch (op_type) {
+    case Item_func::EQ_FUNC:
+      return cmp == 0;
+    case Item_func::LT_FUNC:
+      return cmp < 0;
+    case Item_func::LE_FUNC:
+      return cmp <= 0;
+    case Item_func::GT_FUNC:
+      return cmp > 0;
+    case Item_func::GE_FUNC:
+      return cmp >= 0;
+    default:
+      DBUG_ASSERT(false);
+      return true;
+  }
+}
+
+/* Integer types whose conditions are checked without evaluating the Item */
+bool inline is_int_filter_type(enum_field_types type) {
+  return type == MYSQL_TYPE_LONGLONG || type == MYSQL_TYPE_LONG ||
+         type == MYSQL_TYPE_SHORT || type == MYSQL_TYPE_TINY;
+}
+
 /* We only support simple equal / comparison functions */
 bool inline is_supported_item_func(Item_func::Functype type) {
   // TODO(yzha) - Support EQUAL_FUNC <=>
@@ -725,13 +750,43 @@ class select_exec {
     }
   };
 
+  /*
+    Filter on a key part of the index whose image is at the same offset in
+    every key, checked by comparing the packed key bytes with the packed
+    operands before the row is unpacked
+   */
+  struct key_filter {
+    Item_func::Functype op_type;
+    uint offset;
+    uint length;
+    // Packed operands, length bytes each
+    Rdb_string_writer operands;
+    uint operand_count;
+  };
+
+  /*
+    Filter on an integer column, checked by comparing Field::val_int() with
+    the operands rather than by evaluating the Item
+   */
+  struct int_filter {
+    Item_func::Functype op_type;
+    Field *field;
+    bool is_unsigned;
+    std::vector<longlong> operands;
+  };
+
   bool scan_where();
+  bool get_int_operands(const sql_cond &cond,
+                        std::vector<longlong> *operands) const;
+  bool add_key_filter(const sql_cond &cond);
+  bool add_int_filter(const sql_cond &cond);
   void scan_value();
   bool run_query();
   bool run_range_query(txn_wrapper *txn);
   bool unpack_for_sk(txn_wrapper *txn, const rocksdb::Slice &rkey,
                      const rocksdb::Slice &rvalue);
   bool unpack_for_pk(const rocksdb::Slice &rkey, const rocksdb::Slice &rvalue);
+  bool eval_key_filters(const rocksdb::Slice &rkey) const;
   bool eval_cond();
   int eval_and_send();
   bool run_pk_point_query(txn_wrapper *txn);
@@ -772,10 +827,20 @@ class select_exec {
   bool m_unsupported;
   const char *m_error_msg;
 
-  // All filters (such as A=1)
+  // All filters (such as A=1) that are not key or int filters
   uint m_filter_list[MAX_NOSQL_COND_COUNT];
   uint m_filter_count = 0;
 
+  // Filters checked on the packed key before unpacking
+  std::vector<key_filter> m_key_filters;
+
+  // Filters on integer columns checked after unpacking
+  std::vector<int_filter> m_int_filters;
+
+  // Offset of the image of each key part in the key, or -1 when it is not
+  // at the same offset in every key
+  std::vector<int> m_key_part_offsets;
+
   // All key index tuples we packed during scanning the WHERE clause
   std::vector<key_index_tuple_writer> m_key_index_tuples;
 
@@ -1248,10 +1313,31 @@ bool INLINE_ATTR select_exec::scan_where() {
   m_start_full_key = (start_key_count == m_key_def->get_key_parts());
   m_end_full_key = (end_key_count == m_key_def->get_key_parts());
 
+  // Key parts up to the first one that is nullable or not an integer are
+  // at the same offset in every key
+  m_key_part_offsets.assign(m_index_info->actual_key_parts, -1);
+  uint key_part_offset = Rdb_key_def::INDEX_NUMBER_SIZE;
+  for (uint i = 0; i < m_index_info->actual_key_parts; ++i) {
+    const Rdb_field_packing *const fpi = m_key_def->get_pack_info(i);
+    if (fpi->m_field_maybe_null ||
+        !is_int_filter_type(fpi->m_field_real_type)) {
+      break;
+    }
+    m_key_part_offsets[i] = key_part_offset;
+    key_part_offset += fpi->m_max_image_len;
+  }
+
   // Build list of all filters
-  // Any condition we haven't processed in prefix key are filters
+  // Any condition we haven't processed in prefix key are filters. Those on
+  // integer columns compared with integer constants are checked directly:
+  // on the packed key if the column is in the key, on the field otherwise
+  uint filter_count = 0;
   for (uint i = 0; i < where_list_count; ++i) {
     if (!where_list_processed[i]) {
+      filter_count++;
+      if (add_key_filter(where_list[i]) || add_int_filter(where_list[i])) {
+        continue;
+      }
       if (!where_list[i].cond_item->fixed) {
         if (where_list[i].cond_item->fix_fields(
                 m_thd, const_cast<Item **>(&where_list[i].cond_item))) {
@@ -1262,7 +1348,7 @@ bool INLINE_ATTR select_exec::scan_where() {
     }
   }
 
-  if (!should_allow_filters_select_bypass() && m_filter_count > 0 &&
+  if (!should_allow_filters_select_bypass() && filter_count > 0 &&
       key_part_no < m_index_info->user_defined_key_parts) {
     // Only support filter usage in well supported cases such as point query
     // or simple range query where key is fully specified with well defined
@@ -1275,6 +1361,107 @@ bool INLINE_ATTR select_exec::scan_where() {
   return false;
 }
 
+/*
+  Get the operands of an integer column condition as integers, if they are
+  all integer constants within the range of the column
+ */
+bool select_exec::get_int_operands(const sql_cond &cond,
+                                   std::vector<longlong> *operands) const {
+  if (!is_int_filter_type(cond.field->type())) {
+    return false;
+  }
+
+  Item *const *args = &cond.val_item;
+  uint arg_count = 1;
+  if (cond.op_type == Item_func::IN_FUNC) {
+    auto in_func = static_cast<Item_func_in *>(cond.cond_item);
+    args = in_func->arguments() + 1;
+    arg_count = in_func->argument_count() - 1;
+  }
+
+  const bool is_unsigned = cond.field->flags & UNSIGNED_FLAG;
+  const uint bits = cond.field->pack_length() * 8;
+  const ulonglong unsigned_max = bits == 64
+                                     ? std::numeric_limits<ulonglong>::max()
+                                     : (1ULL << bits) - 1;
+  const longlong signed_max = unsigned_max >> 1;
+  for (uint i = 0; i < arg_count; ++i) {
+    if (args[i]->type() != Item::INT_ITEM) {
+      return false;
+    }
+    const longlong val = args[i]->val_int();
+    const bool is_negative = !args[i]->unsigned_flag && val < 0;
+    if (is_unsigned) {
+      if (is_negative || static_cast<ulonglong>(val) > unsigned_max) {
+        return false;
+      }
+    } else if (is_negative ? val < -signed_max - 1
+                           : static_cast<ulonglong>(val) >
+                                 static_cast<ulonglong>(signed_max)) {
+      return false;
+    }
+    operands->push_back(val);
+  }
+  return true;
+}
+
+/*
+  Turn the condition into a key filter if its column is a key part at a
+  fixed offset. Returns true if it did
+ */
+bool select_exec::add_key_filter(const sql_cond &cond) {
+  uint key_part_no = 0;
+  while (key_part_no < m_index_info->actual_key_parts &&
+         m_index_info->key_part[key_part_no].field->field_index !=
+             cond.field->field_index) {
+    key_part_no++;
+  }
+  if (key_part_no == m_index_info->actual_key_parts ||
+      m_key_part_offsets[key_part_no] < 0) {
+    return false;
+  }
+
+  std::vector<longlong> operands;
+  if (!get_int_operands(cond, &operands)) {
+    return false;
+  }
+
+  m_key_filters.emplace_back();
+  key_filter &filter = m_key_filters.back();
+  filter.op_type = cond.op_type;
+  filter.offset = m_key_part_offsets[key_part_no];
+  filter.length = m_key_def->get_pack_info(key_part_no)->m_max_image_len;
+  filter.operand_count = operands.size();
+
+  Item *const *args = &cond.val_item;
+  if (cond.op_type == Item_func::IN_FUNC) {
+    args = static_cast<Item_func_in *>(cond.cond_item)->arguments() + 1;
+  }
+  for (uint i = 0; i < filter.operand_count; ++i) {
+    if (pack_index_tuple(key_part_no, &filter.operands, cond.field, args[i])) {
+      m_key_filters.pop_back();
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  Turn the condition into an int filter if it compares an integer column
+  with integer constants. Returns true if it did
+ */
+bool select_exec::add_int_filter(const sql_cond &cond) {
+  std::vector<longlong> operands;
+  if (!get_int_operands(cond, &operands)) {
+    return false;
+  }
+
+  m_int_filters.push_back({cond.op_type, cond.field,
+                           (cond.field->flags & UNSIGNED_FLAG) != 0,
+                           std::move(operands)});
+  return true;
+}
+
 /*
   Scan all the fields that going to be unpacked in SELECT, and figure out
   do we need to just unpack the index or need to unpack the value as well
@@ -1470,6 +1657,11 @@ bool INLINE_ATTR select_exec::run_pk_point_query(txn_wrapper *txn) {
         return true;
       }
 
+      if (!eval_key_filters(key_slices[i])) {
+        m_examined_rows++;
+        continue;
+      }
+
       if (unpack_for_pk(key_slices[i], value_slices[i])) {
         return true;
       }
@@ -1500,6 +1692,11 @@ bool INLINE_ATTR select_exec::run_pk_point_query(txn_wrapper *txn) {
         return true;
       }
 
+      if (!eval_key_filters(key_slice)) {
+        m_examined_rows++;
+        continue;
+      }
+
       if (unpack_for_pk(key_slice, value_slice)) {
         return true;
       }
@@ -1558,6 +1755,11 @@ bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
       continue;
     }
 
+    if (!eval_key_filters(rkey_slice)) {
+      m_examined_rows++;
+      continue;
+    }
+
     if (unpack_for_sk(txn, rkey_slice, m_scan_it->value())) {
       return true;
     }
@@ -1574,12 +1776,63 @@ bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
   return false;
 }
 
+/*
+  Evaluate the key filters on the packed key, before unpacking the row
+ */
+bool INLINE_ATTR select_exec::eval_key_filters(
+    const rocksdb::Slice &rkey) const {
+  for (const auto &filter : m_key_filters) {
+    DBUG_ASSERT(rkey.size() >= filter.offset + filter.length);
+    const uchar *const image =
+        reinterpret_cast<const uchar *>(rkey.data()) + filter.offset;
+    const uchar *operand = filter.operands.ptr();
+    if (filter.op_type == Item_func::IN_FUNC) {
+      bool found = false;
+      for (uint i = 0; i < filter.operand_count && !found; ++i) {
+        found = memcmp(image, operand, filter.length) == 0;
+        operand += filter.length;
+      }
+      if (!found) {
+        return false;
+      }
+    } else if (!cmp_matches(filter.op_type,
+                            memcmp(image, operand, filter.length))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*
   Evaluate the condition using item->val_int, assuming item pointing
   to record[0] and is already unpacked.
-  This is the slow path as we need to unpack into record[0]
+  This is the slow path as we need to unpack into record[0]. Int filters
+  skip the Item and compare the field values directly
  */
 bool INLINE_ATTR select_exec::eval_cond() {
+  for (const auto &filter : m_int_filters) {
+    const longlong val = filter.field->val_int();
+    if (filter.op_type == Item_func::IN_FUNC) {
+      if (std::find(filter.operands.begin(), filter.operands.end(), val) ==
+          filter.operands.end()) {
+        return false;
+      }
+    } else {
+      const longlong operand = filter.operands[0];
+      int cmp;
+      if (filter.is_unsigned) {
+        const ulonglong uval = val;
+        const ulonglong uoperand = operand;
+        cmp = (uval > uoperand) - (uval < uoperand);
+      } else {
+        cmp = (val > operand) - (val < operand);
+      }
+      if (!cmp_matches(filter.op_type, cmp)) {
+        return false;
+      }
+    }
+  }
+
   if (unlikely(m_filter_count > 0)) {
     auto where_list = m_parser.get_cond_list();
     for (uint i = 0; i < m_filter_count; ++i) {
@@ -1836,6 +2089,14 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
         }
       }
 
+      // Rows that fail a key filter are not unpacked, nor looked up in
+      // the PK
+      if (!eval_key_filters(rkey)) {
+        m_examined_rows++;
+        rocksdb_smart_next(reverse_seek, m_scan_it.get());
+        continue;
+      }
+
       // TODO: We could skip unpacking if m_filter_count=0 and we are
       // skipping the first N items in LIMIT, but this is low priority
       // for now
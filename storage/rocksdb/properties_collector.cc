@@ -19,6 +19,7 @@
 
 /* Standard C++ header files */
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -189,6 +190,7 @@ void Rdb_tbl_prop_coll::CollectStatsForRow(const rocksdb::Slice &key,
 
   if (m_keydef != nullptr && type == rocksdb::kEntryPut) {
     m_cardinality_collector.ProcessKey(key, m_keydef.get(), stats);
+    stats->m_histogram.add_key(key);
   }
 }
 
@@ -237,6 +239,7 @@ rocksdb::Status Rdb_tbl_prop_coll::Finish(
     }
 
     for (Rdb_index_stats &stat : m_stats) {
+      stat.m_histogram.finish();
       m_cardinality_collector.SetCardinality(&stat);
       m_cardinality_collector.AdjustStats(&stat);
 
@@ -339,7 +342,9 @@ std::string Rdb_tbl_prop_coll::GetReadableStats(const Rdb_index_stats &it) {
     s.append(std::to_string(num));
     s.append(" ");
   }
-  s.append("]}");
+  s.append("], histogram buckets: ");
+  s.append(std::to_string(it.m_histogram.size()));
+  s.append("}");
   return s;
 }
 
@@ -361,12 +366,236 @@ void Rdb_tbl_prop_coll::read_stats_from_tbl_props(
 }
 
 /*
-  Serializes an array of Rdb_index_stats into a network string.
+  Adds the next key of the SST file. Every m_step-th key is kept as a bound,
+  and every other bound is dropped, doubling m_step, when there are twice as
+  many as needed.
+*/
+void Rdb_key_histogram::add_key(const rocksdb::Slice &key) {
+  m_last_key.assign(key.data(),
+                    key.size() < MAX_BOUND_LEN ? key.size() : MAX_BOUND_LEN);
+  if (m_seen % m_step == 0) {
+    m_buckets.emplace_back(m_last_key, m_seen);
+    if (m_buckets.size() > 2 * MAX_BUCKETS) {
+      size_t kept = 0;
+      for (size_t i = 0; i < m_buckets.size(); i += 2) {
+        m_buckets[kept++] = std::move(m_buckets[i]);
+      }
+      m_buckets.resize(kept);
+      m_step *= 2;
+    }
+  }
+  m_seen++;
+}
+
+/*
+  Turns the kept keys into buckets, once all keys of the SST file have been
+  added. In a reverse ordered column family they arrived in descending
+  order.
+*/
+void Rdb_key_histogram::finish() {
+  if (m_seen == 0) {
+    return;
+  }
+
+  if (m_buckets.back().second != m_seen - 1) {
+    m_buckets.emplace_back(m_last_key, m_seen - 1);
+  }
+  if (m_buckets.front().first > m_buckets.back().first) {
+    std::reverse(m_buckets.begin(), m_buckets.end());
+    for (auto &bucket : m_buckets) {
+      bucket.second = m_seen - 1 - bucket.second;
+    }
+  }
+
+  std::vector<std::pair<std::string, double>> points;
+  for (const auto &bucket : m_buckets) {
+    points.emplace_back(bucket.first, bucket.second + 1);
+  }
+  set_buckets(points);
+
+  m_step = 1;
+  m_seen = 0;
+  m_last_key.clear();
+}
+
+/*
+  Sets the buckets from rows up to and including each of the given keys,
+  which must be in ascending order with non-decreasing row counts. Keeps
+  the first and last keys and, between them, the first key past each
+  multiple of rows() / MAX_BUCKETS.
+*/
+void Rdb_key_histogram::set_buckets(
+    const std::vector<std::pair<std::string, double>> &points) {
+  m_buckets.clear();
+  if (points.empty() || points.back().second < 1) {
+    return;
+  }
+
+  const double total = points.back().second;
+  uint next_bucket = 1;
+  for (size_t i = 0; i < points.size(); i++) {
+    const double rows = points[i].second;
+    // Only the last of the keys with no rows up to them is a useful bound
+    if (i + 1 < points.size() && points[i + 1].second <= 0) {
+      continue;
+    }
+    if (i == 0 || i + 1 == points.size() ||
+        rows >= total * next_bucket / MAX_BUCKETS) {
+      m_buckets.emplace_back(points[i].first, std::llround(rows));
+      while (next_bucket <= MAX_BUCKETS &&
+             rows >= total * next_bucket / MAX_BUCKETS) {
+        next_bucket++;
+      }
+    }
+  }
+}
+
+/*
+  Position of key between the bounds lo < key <= hi, from 0 to 1, taken from
+  the eight bytes after the prefix the bounds have in common.
+*/
+static double rdb_key_fraction(const std::string &lo, const std::string &hi,
+                               const rocksdb::Slice &key) {
+  size_t prefix = 0;
+  while (prefix < lo.size() && prefix < hi.size() &&
+         lo[prefix] == hi[prefix]) {
+    prefix++;
+  }
+
+  const auto read_uint64 = [prefix](const char *const data,
+                                    const size_t size) {
+    uint64_t val = 0;
+    for (size_t i = prefix; i < prefix + 8; i++) {
+      val = (val << 8) | (i < size ? static_cast<uchar>(data[i]) : 0);
+    }
+    return val;
+  };
+  const uint64_t lo_val = read_uint64(lo.data(), lo.size());
+  const uint64_t hi_val = read_uint64(hi.data(), hi.size());
+  const uint64_t key_val =
+      std::min(std::max(read_uint64(key.data(), key.size()), lo_val), hi_val);
+  if (hi_val <= lo_val) {
+    return 1;
+  }
+  return static_cast<double>(key_val - lo_val) / (hi_val - lo_val);
+}
+
+double Rdb_key_histogram::rows_upto(const rocksdb::Slice &key) const {
+  const auto it = std::lower_bound(
+      m_buckets.begin(), m_buckets.end(), key,
+      [](const std::pair<std::string, int64_t> &bucket,
+         const rocksdb::Slice &k) { return k.compare(bucket.first) > 0; });
+  if (it == m_buckets.end()) {
+    return rows();
+  }
+  if (key.compare(it->first) == 0) {
+    return it->second;
+  }
+  if (it == m_buckets.begin()) {
+    return 0;
+  }
+
+  const auto prev = it - 1;
+  return prev->second +
+         (it->second - prev->second) * rdb_key_fraction(prev->first,
+                                                        it->first, key);
+}
+
+/*
+  Adds (or, with increment == false, removes) the rows of histogram h. The
+  rows up to each bound of either histogram are estimated from both, and
+  the buckets picked again from these.
+*/
+void Rdb_key_histogram::merge(const Rdb_key_histogram &h,
+                              const bool increment) {
+  if (h.empty()) {
+    return;
+  }
+  if (empty()) {
+    if (increment) {
+      m_buckets = h.m_buckets;
+    }
+    return;
+  }
+
+  std::vector<std::string> keys;
+  keys.reserve(m_buckets.size() + h.m_buckets.size());
+  for (const auto &bucket : m_buckets) {
+    keys.push_back(bucket.first);
+  }
+  for (const auto &bucket : h.m_buckets) {
+    keys.push_back(bucket.first);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<std::pair<std::string, double>> points;
+  points.reserve(keys.size());
+  double prev_rows = 0;
+  for (const auto &key : keys) {
+    double rows = increment ? rows_upto(key) + h.rows_upto(key)
+                            : rows_upto(key) - h.rows_upto(key);
+    // Removing estimates can make the counts go down, which they can't
+    rows = std::max(rows, prev_rows);
+    points.emplace_back(key, rows);
+    prev_rows = rows;
+  }
+  set_buckets(points);
+}
+
+void Rdb_key_histogram::materialize(String *const s) const {
+  rdb_netstr_append_uint64(s, m_buckets.size());
+  for (const auto &bucket : m_buckets) {
+    rdb_netstr_append_uint64(s, bucket.second);
+    rdb_netstr_append_uint16(s, bucket.first.size());
+    s->append(bucket.first.data(), bucket.first.size());
+  }
+}
+
+/*
+  Reads a histogram written by materialize() from p, which is moved past it.
+  @return false if it runs past p2
+*/
+bool Rdb_key_histogram::unmaterialize(const uchar **p,
+                                      const uchar *const p2) {
+  m_buckets.clear();
+  if (*p + sizeof(uint64) > p2) {
+    return false;
+  }
+  const uint64 n_buckets = rdb_netbuf_read_uint64(p);
+  for (uint64 i = 0; i < n_buckets; i++) {
+    if (*p + sizeof(uint64) + sizeof(uint16) > p2) {
+      return false;
+    }
+    const int64_t rows = rdb_netbuf_read_uint64(p);
+    const uint16 len = rdb_netbuf_read_uint16(p);
+    if (*p + len > p2) {
+      return false;
+    }
+    m_buckets.emplace_back(
+        std::string(reinterpret_cast<const char *>(*p), len), rows);
+    *p += len;
+  }
+  return true;
+}
+
+/*
+  Serializes an array of Rdb_index_stats into a network string. Histograms
+  are only written, as version INDEX_STATS_VERSION_HISTOGRAM, if any of the
+  indexes has one, so that stats without them stay readable by servers that
+  do not know that version.
 */
 std::string Rdb_index_stats::materialize(
     const std::vector<Rdb_index_stats> &stats) {
+  const bool has_histograms =
+      std::any_of(stats.begin(), stats.end(), [](const Rdb_index_stats &i) {
+        return !i.m_histogram.empty();
+      });
+
   String ret;
-  rdb_netstr_append_uint16(&ret, INDEX_STATS_VERSION_ENTRY_TYPES);
+  rdb_netstr_append_uint16(&ret, has_histograms
+                                     ? INDEX_STATS_VERSION_HISTOGRAM
+                                     : INDEX_STATS_VERSION_ENTRY_TYPES);
   for (const auto &i : stats) {
     rdb_netstr_append_uint32(&ret, i.m_gl_index_id.cf_id);
     rdb_netstr_append_uint32(&ret, i.m_gl_index_id.index_id);
@@ -382,6 +611,9 @@ std::string Rdb_index_stats::materialize(
     for (const auto &num_keys : i.m_distinct_keys_per_prefix) {
       rdb_netstr_append_uint64(&ret, num_keys);
     }
+    if (has_histograms) {
+      i.m_histogram.materialize(&ret);
+    }
   }
 
   return std::string((char *)ret.ptr(), ret.length());
@@ -408,7 +640,7 @@ int Rdb_index_stats::unmaterialize(const std::string &s,
   Rdb_index_stats stats;
   // Make sure version is within supported range.
   if (version < INDEX_STATS_VERSION_INITIAL ||
-      version > INDEX_STATS_VERSION_ENTRY_TYPES) {
+      version > INDEX_STATS_VERSION_HISTOGRAM) {
     // NO_LINT_DEBUG
     sql_print_error(
         "Index stats version %d was outside of supported range. "
@@ -450,6 +682,10 @@ int Rdb_index_stats::unmaterialize(const std::string &s,
     for (std::size_t i = 0; i < stats.m_distinct_keys_per_prefix.size(); i++) {
       stats.m_distinct_keys_per_prefix[i] = rdb_netbuf_read_uint64(&p);
     }
+    if (version >= INDEX_STATS_VERSION_HISTOGRAM &&
+        !stats.m_histogram.unmaterialize(&p, p2)) {
+      return HA_EXIT_FAILURE;
+    }
     ret->push_back(stats);
   }
   return HA_EXIT_SUCCESS;
@@ -495,6 +731,7 @@ void Rdb_index_stats::merge(const Rdb_index_stats &s, const bool increment,
     for (i = 0; i < s.m_distinct_keys_per_prefix.size(); i++) {
       m_distinct_keys_per_prefix[i] += s.m_distinct_keys_per_prefix[i];
     }
+    m_histogram.merge(s.m_histogram, true);
   } else {
     m_rows -= s.m_rows;
     m_data_size -= s.m_data_size;
@@ -507,6 +744,7 @@ void Rdb_index_stats::merge(const Rdb_index_stats &s, const bool increment,
     for (i = 0; i < s.m_distinct_keys_per_prefix.size(); i++) {
       m_distinct_keys_per_prefix[i] -= s.m_distinct_keys_per_prefix[i];
     }
+    m_histogram.merge(s.m_histogram, false);
   }
 }
 
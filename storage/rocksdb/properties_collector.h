@@ -45,16 +45,64 @@ struct Rdb_compact_params {
   uint64_t m_deletes, m_window, m_file_size;
 };
 
+/*
+  Equi-depth histogram of the keys of an index, in bytewise key order. Each
+  bucket is an upper bound key and the number of rows with keys up to and
+  including it, so that the number of rows below a key can be estimated by
+  interpolating between the bounds around it.
+
+  Histograms are built per SST file by Rdb_tbl_prop_coll, from the keys it
+  sees in column family order (add_key() and finish()), and merged into the
+  histogram of the index by Rdb_index_stats::merge().
+*/
+class Rdb_key_histogram {
+ public:
+  /* Number of buckets kept */
+  static const size_t MAX_BUCKETS = 32;
+  /* Bounds are cut to this length, that is enough to tell keys apart */
+  static const size_t MAX_BOUND_LEN = 64;
+
+  void add_key(const rocksdb::Slice &key);
+  void finish();
+
+  void merge(const Rdb_key_histogram &h, const bool increment);
+
+  bool empty() const { return m_buckets.empty(); }
+  size_t size() const { return m_buckets.size(); }
+  int64_t rows() const { return empty() ? 0 : m_buckets.back().second; }
+  /* Estimated number of rows with keys up to and including key */
+  double rows_upto(const rocksdb::Slice &key) const;
+
+  void materialize(String *const s) const;
+  bool unmaterialize(const uchar **p, const uchar *const p2);
+
+ private:
+  void set_buckets(const std::vector<std::pair<std::string, double>> &points);
+
+  /* Bounds in ascending order, and rows up to and including them */
+  std::vector<std::pair<std::string, int64_t>> m_buckets;
+
+  /*
+    While the histogram is built, m_buckets holds every m_step-th key as it
+    arrived, with its position among the m_seen keys added so far.
+  */
+  int64_t m_step = 1;
+  int64_t m_seen = 0;
+  std::string m_last_key;
+};
+
 struct Rdb_index_stats {
   enum {
     INDEX_STATS_VERSION_INITIAL = 1,
     INDEX_STATS_VERSION_ENTRY_TYPES = 2,
+    INDEX_STATS_VERSION_HISTOGRAM = 3,
   };
   GL_INDEX_ID m_gl_index_id;
   int64_t m_data_size, m_rows, m_actual_disk_size;
   int64_t m_entry_deletes, m_entry_single_deletes;
   int64_t m_entry_merges, m_entry_others;
   std::vector<int64_t> m_distinct_keys_per_prefix;
+  Rdb_key_histogram m_histogram;
   std::string m_name;  // name is not persisted
 
   static std::string materialize(const std::vector<Rdb_index_stats> &stats);
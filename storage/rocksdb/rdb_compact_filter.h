@@ -42,6 +42,7 @@ class Rdb_compact_filter : public rocksdb::CompactionFilter {
   ~Rdb_compact_filter() {
     // Increment stats by num expired at the end of compaction
     rdb_update_global_stats(ROWS_EXPIRED, m_num_expired);
+    flush_index_stats();
   }
 
   // keys are passed in sorted order within the same sst.
@@ -60,6 +61,11 @@ class Rdb_compact_filter : public rocksdb::CompactionFilter {
     DBUG_ASSERT(gl_index_id.index_id >= 1);
 
     if (gl_index_id != m_prev_index) {
+      flush_index_stats();
+      m_index_stats = {};
+      m_index_stats.cf_id = gl_index_id.cf_id;
+      m_index_stats.index_id = gl_index_id.index_id;
+
       m_should_delete =
           rdb_get_dict_manager()->is_drop_index_ongoing(gl_index_id);
 
@@ -92,15 +98,22 @@ class Rdb_compact_filter : public rocksdb::CompactionFilter {
       m_prev_index = gl_index_id;
     }
 
+    const ulonglong bytes = key.size() + existing_value.size();
     if (m_should_delete) {
       m_num_deleted++;
+      m_index_stats.rows_dropped++;
+      m_index_stats.bytes_dropped += bytes;
       return true;
     } else if (m_ttl_duration > 0 &&
                should_filter_ttl_rec(key, existing_value)) {
       m_num_expired++;
+      m_index_stats.rows_expired++;
+      m_index_stats.bytes_expired += bytes;
       return true;
     }
 
+    m_index_stats.rows_kept++;
+    m_index_stats.bytes_kept += bytes;
     return false;
   }
 
@@ -179,6 +192,14 @@ class Rdb_compact_filter : public rocksdb::CompactionFilter {
     return ttl_timestamp + m_ttl_duration <= m_snapshot_timestamp;
   }
 
+  // Add what the filter did to the index of the previous record to the
+  // stats of the index
+  void flush_index_stats() const {
+    if (m_prev_index.index_id != 0) {
+      rdb_update_index_compaction_stats(m_index_stats);
+    }
+  }
+
  private:
   // Column family for this compaction filter
   const uint32_t m_cf_id;
@@ -196,6 +217,8 @@ class Rdb_compact_filter : public rocksdb::CompactionFilter {
   mutable uint32 m_ttl_offset = 0;
   // Oldest snapshot timestamp at the time a TTL index is discovered
   mutable uint64_t m_snapshot_timestamp = 0;
+  // Rows and bytes kept and removed for the current index
+  mutable Rdb_index_compaction_stats m_index_stats = {};
 };
 
 class Rdb_compact_filter_factory : public rocksdb::CompactionFilterFactory {
@@ -639,6 +639,208 @@ int Rdb_converter::convert_record_from_storage_format(
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  Decode a fixed length column of a batch of rows: skip the given number of
+  bytes in each row's value and copy the next len bytes to the row's record
+  buffer. Instantiated with the widths of the integer types, so that each
+  copy is a single load and store, and unrolled by four rows.
+  @param    readers     IN/OUT       value slice reader of each row
+  @param    n_rows      IN           number of rows
+  @param    skip        IN           bytes to skip before the field
+  @param    dst         OUT          field in the record buffer of row 0
+  @param    dst_stride  IN           distance between two record buffers
+  @return
+    0      OK
+    other  HA_ERR error code (can be SE-specific)
+*/
+template <uint len>
+static int rdb_decode_fixed_column(Rdb_string_reader *const readers,
+                                   const uint n_rows, const uint skip,
+                                   uchar *dst, const size_t dst_stride) {
+  uint i = 0;
+  for (; i + 4 <= n_rows; i += 4) {
+    const char *const data0 = readers[i].read(skip + len);
+    const char *const data1 = readers[i + 1].read(skip + len);
+    const char *const data2 = readers[i + 2].read(skip + len);
+    const char *const data3 = readers[i + 3].read(skip + len);
+    if (!data0 || !data1 || !data2 || !data3) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+
+    memcpy(dst, data0 + skip, len);
+    memcpy(dst + dst_stride, data1 + skip, len);
+    memcpy(dst + 2 * dst_stride, data2 + skip, len);
+    memcpy(dst + 3 * dst_stride, data3 + skip, len);
+    dst += 4 * dst_stride;
+  }
+
+  for (; i < n_rows; i++) {
+    const char *const data = readers[i].read(skip + len);
+    if (!data) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+    memcpy(dst, data + skip, len);
+    dst += dst_stride;
+  }
+  return HA_EXIT_SUCCESS;
+}
+
+/* rdb_decode_fixed_column() for the other widths */
+static int rdb_decode_fixed_column(Rdb_string_reader *const readers,
+                                   const uint n_rows, const uint skip,
+                                   const uint len, uchar *dst,
+                                   const size_t dst_stride) {
+  for (uint i = 0; i < n_rows; i++) {
+    const char *const data = readers[i].read(skip + len);
+    if (!data) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+    memcpy(dst, data + skip, len);
+    dst += dst_stride;
+  }
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  EntryPoint for batch Decode:
+  Decode a batch of primary key rows into consecutive record buffers, like
+  decode() does for one row. The value slices are decoded column by column:
+  each requested field is decoded for all rows before the next one, which
+  keeps the field's decoding instructions in registers and lets the fixed
+  length columns that can never be NULL go through the type specialized
+  rdb_decode_fixed_column() kernels.
+  Fields are decoded as setup_field_decoders() set them up. Record buffers
+  must have been initialized (see restore_record()), and blob fields point
+  into the value slices, as with decode().
+  @param     pk_def         IN          primary key definition
+  @param     n_rows         IN          number of rows in the batch
+  @param     key_slices     IN          RocksDB key slice of each row
+  @param     value_slices   IN          RocksDB value slice of each row
+  @param     dst            OUT         record buffer of the first row
+  @param     dst_stride     IN          distance between two record buffers
+  @return
+    0      OK
+    other  HA_ERR error code (can be SE-specific)
+*/
+int Rdb_converter::decode_batch(const std::shared_ptr<Rdb_key_def> &pk_def,
+                                const uint n_rows,
+                                const rocksdb::Slice *const key_slices,
+                                const rocksdb::Slice *const value_slices,
+                                uchar *dst, const size_t dst_stride) {
+  DBUG_ASSERT(pk_def->m_index_type == Rdb_key_def::INDEX_TYPE_PRIMARY ||
+              pk_def->m_index_type == Rdb_key_def::INDEX_TYPE_HIDDEN_PRIMARY);
+
+  const bool skip_value = get_decode_fields()->size() == 0;
+  if (!m_key_requested && skip_value) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  int err = HA_EXIT_SUCCESS;
+
+  // Read the value headers and decode the PK fields row by row
+  m_batch_readers.clear();
+  m_batch_null_bytes.clear();
+  for (uint i = 0; i < n_rows; i++) {
+    m_batch_readers.emplace_back(&value_slices[i]);
+    rocksdb::Slice unpack_slice;
+    err = decode_value_header_for_pk(&m_batch_readers.back(), pk_def,
+                                     &unpack_slice);
+    if (err != HA_EXIT_SUCCESS) {
+      return err;
+    }
+    m_batch_null_bytes.push_back(m_null_bytes);
+
+    if (m_key_requested) {
+      err = pk_def->unpack_record(
+          m_table, dst + i * dst_stride, &key_slices[i],
+          !unpack_slice.empty() ? &unpack_slice : nullptr,
+          false /* verify_checksum */);
+      if (err != HA_EXIT_SUCCESS) {
+        return err;
+      }
+    }
+  }
+
+  if (skip_value) {
+    // We are done
+    return HA_EXIT_SUCCESS;
+  }
+
+  // Decode value slices, column by column
+  Rdb_string_reader *const readers = m_batch_readers.data();
+  for (const auto &read_field : m_decoders_vect) {
+    Rdb_field_encoder *const field_dec = read_field.m_field_enc;
+    const uint skip = read_field.m_skip;
+
+    if (read_field.m_decode && !field_dec->maybe_null() &&
+        !field_dec->uses_variable_len_encoding()) {
+      uchar *const column = dst + field_dec->m_field_offset;
+      switch (field_dec->m_field_pack_length) {
+        case 1:
+          err = rdb_decode_fixed_column<1>(readers, n_rows, skip, column,
+                                           dst_stride);
+          break;
+        case 2:
+          err = rdb_decode_fixed_column<2>(readers, n_rows, skip, column,
+                                           dst_stride);
+          break;
+        case 3:
+          err = rdb_decode_fixed_column<3>(readers, n_rows, skip, column,
+                                           dst_stride);
+          break;
+        case 4:
+          err = rdb_decode_fixed_column<4>(readers, n_rows, skip, column,
+                                           dst_stride);
+          break;
+        case 8:
+          err = rdb_decode_fixed_column<8>(readers, n_rows, skip, column,
+                                           dst_stride);
+          break;
+        default:
+          err = rdb_decode_fixed_column(readers, n_rows, skip,
+                                        field_dec->m_field_pack_length,
+                                        column, dst_stride);
+          break;
+      }
+      if (err != HA_EXIT_SUCCESS) {
+        return err;
+      }
+      continue;
+    }
+
+    for (uint i = 0; i < n_rows; i++) {
+      // This is_null value is bind to how stroage format store its value
+      const bool is_null =
+          field_dec->maybe_null() &&
+          ((m_batch_null_bytes[i][field_dec->m_null_offset] &
+            field_dec->m_null_mask) != 0);
+
+      // Skip the bytes we need to skip
+      if (skip && !readers[i].read(skip)) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+
+      err = Rdb_convert_to_record_value_decoder::decode(
+          dst + i * dst_stride, m_table, field_dec, &readers[i],
+          read_field.m_decode, is_null);
+      if (err != HA_EXIT_SUCCESS) {
+        return err;
+      }
+    }
+  }
+
+  if (m_verify_row_debug_checksums) {
+    for (uint i = 0; i < n_rows; i++) {
+      err = verify_row_debug_checksum(pk_def, &readers[i], &key_slices[i],
+                                      &value_slices[i]);
+      if (err != HA_EXIT_SUCCESS) {
+        return err;
+      }
+    }
+  }
+  return HA_EXIT_SUCCESS;
+}
+
 /*
   Verify checksum for row
   @param      pk_def   IN     key def
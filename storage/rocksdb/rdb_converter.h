@@ -143,6 +143,11 @@ class Rdb_converter {
              const rocksdb::Slice *key_slice, const rocksdb::Slice *value_slice,
              bool decode_value = true);
 
+  int decode_batch(const std::shared_ptr<Rdb_key_def> &pk_def,
+                   const uint n_rows, const rocksdb::Slice *const key_slices,
+                   const rocksdb::Slice *const value_slices, uchar *dst,
+                   const size_t dst_stride);
+
   int encode_value_slice(const std::shared_ptr<Rdb_key_def> &pk_def,
                          const rocksdb::Slice &pk_packed_slice,
                          Rdb_string_writer *pk_unpack_info, bool is_update_row,
@@ -251,5 +256,11 @@ class Rdb_converter {
     index does not cover the current lookup for any record.
    */
   MY_BITMAP m_lookup_bitmap;
+  /*
+    Per row value slice readers and null bytes of the batch being decoded by
+    decode_batch()
+  */
+  std::vector<Rdb_string_reader> m_batch_readers;
+  std::vector<const char *> m_batch_null_bytes;
 };
 }  // namespace myrocks
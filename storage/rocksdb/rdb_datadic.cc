@@ -278,10 +278,11 @@ Rdb_key_def::Rdb_key_def(
       m_partial_index_keyparts(0),
       m_partial_index_threshold(0),
       m_prefix_extractor(nullptr),
-      m_maxlength(0)  // means 'not intialized'
-{
+      m_maxlength(0),  // means 'not intialized'
+      m_integer_key(false) {
   mysql_mutex_init(0, &m_mutex, MY_MUTEX_INIT_FAST);
   rdb_netbuf_store_index(m_index_number_storage_form, m_index_number);
+  publish_histogram();
   m_total_index_flags_length =
       calculate_index_flag_offset(m_index_flags_bitmap, MAX_FLAG);
   DBUG_ASSERT_IMP(m_index_type == INDEX_TYPE_SECONDARY &&
@@ -313,7 +314,9 @@ Rdb_key_def::Rdb_key_def(const Rdb_key_def &k)
       m_partial_index_keyparts(k.m_partial_index_keyparts),
       m_partial_index_threshold(k.m_partial_index_threshold),
       m_prefix_extractor(k.m_prefix_extractor),
-      m_maxlength(k.m_maxlength) {
+      m_maxlength(k.m_maxlength),
+      m_integer_key(k.m_integer_key),
+      m_histogram(k.get_histogram()) {
   mysql_mutex_init(0, &m_mutex, MY_MUTEX_INIT_FAST);
   rdb_netbuf_store_index(m_index_number_storage_form, m_index_number);
   m_total_index_flags_length =
@@ -533,6 +536,21 @@ void Rdb_key_def::setup(const TABLE *const tbl,
     /* Initialize the memory needed by the stats structure */
     m_stats.m_distinct_keys_per_prefix.resize(get_key_parts());
 
+    m_integer_key = true;
+    for (uint i = 0; i < m_key_parts; i++) {
+      switch (m_pack_info[i].m_field_real_type) {
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_TINY:
+          break;
+        default:
+          m_integer_key = false;
+          break;
+      }
+    }
+
     /* Cache prefix extractor for bloom filter usage later */
     rocksdb::Options opt = rdb_get_rocksdb_db()->GetOptions(get_cf());
     m_prefix_extractor = opt.prefix_extractor;
@@ -1260,6 +1278,86 @@ uchar *Rdb_key_def::pack_field(Field *const field, Rdb_field_packing *pack_info,
   return tuple;
 }
 
+/*
+  Mem-comparable image of an integer field, the same as the one that
+  Field_*::make_sort_key() makes for the integer types: the bytes from the
+  most significant one down, with the sign bit reversed for signed types.
+  This is what pack_with_make_sort_key() stores, see unpack_integer() for
+  the inverse.
+*/
+template <int length>
+static inline void rdb_pack_integer(const uchar *const from, uchar *const to,
+                                    const bool unsigned_flag) {
+#ifdef WORDS_BIGENDIAN
+  to[0] = unsigned_flag ? from[0] : static_cast<uchar>(from[0] ^ 128);
+  /* Parameterized length should enable loop unrolling */
+  for (int i = 1; i < length; i++) to[i] = from[i];
+#else
+  to[0] = unsigned_flag ? from[length - 1]
+                        : static_cast<uchar>(from[length - 1] ^ 128);
+  /* Parameterized length should enable loop unrolling */
+  for (int i = 1, j = length - 2; i < length; ++i, --j) to[i] = from[j];
+#endif
+}
+
+/*
+  The key part loop of pack_record() for keys where m_integer_key is set.
+  The fields are read at their offsets in record, so unlike pack_field()
+  this needs neither the Field objects nor the per part pack functions.
+
+  @return
+    The end of the packed key parts
+*/
+uchar *Rdb_key_def::pack_integer_parts(const uchar *const record,
+                                       uchar *tuple, const uint n_key_parts,
+                                       const longlong hidden_pk_id,
+                                       uint *const n_null_fields) const {
+  for (uint i = 0; i < n_key_parts; i++) {
+    const Rdb_field_packing *const fpi = &m_pack_info[i];
+
+    // Fill hidden pk id into the last key part for secondary keys for tables
+    // with no pk
+    if (hidden_pk_id && i + 1 == n_key_parts) {
+      fpi->fill_hidden_pk_val(&tuple, hidden_pk_id);
+      break;
+    }
+
+    if (fpi->m_field_maybe_null) {
+      if (record[fpi->m_field_null_offset] & fpi->m_field_null_bit_mask) {
+        /* NULL value. store '\0' so that it sorts before non-NULL values */
+        *tuple++ = 0;
+        if (n_null_fields) (*n_null_fields)++;
+        continue;
+      }
+      /* Not a NULL value. Store '1' */
+      *tuple++ = 1;
+    }
+
+    const uchar *const from = record + fpi->m_field_offset;
+    const bool unsigned_flag = fpi->m_field_unsigned_flag;
+    switch (fpi->m_max_image_len) {
+      case 8:
+        rdb_pack_integer<8>(from, tuple, unsigned_flag);
+        break;
+      case 4:
+        rdb_pack_integer<4>(from, tuple, unsigned_flag);
+        break;
+      case 3:
+        rdb_pack_integer<3>(from, tuple, unsigned_flag);
+        break;
+      case 2:
+        rdb_pack_integer<2>(from, tuple, unsigned_flag);
+        break;
+      default:
+        DBUG_ASSERT(fpi->m_max_image_len == 1);
+        rdb_pack_integer<1>(from, tuple, unsigned_flag);
+        break;
+    }
+    tuple += fpi->m_max_image_len;
+  }
+  return tuple;
+}
+
 /**
   Get index columns from the record and pack them into mem-comparable form.
 
@@ -1376,53 +1474,62 @@ uint Rdb_key_def::pack_record(const TABLE *const tbl, uchar *const pack_buffer,
   uint curr_bitmap_pos = 0;
   bitmap_init(&covered_bitmap, &covered_bits, MAX_REF_PARTS, false);
 
-  for (uint i = 0; i < n_key_parts; i++) {
-    // Fill hidden pk id into the last key part for secondary keys for tables
-    // with no pk
-    if (hidden_pk_exists && hidden_pk_id && i + 1 == n_key_parts) {
-      m_pack_info[i].fill_hidden_pk_val(&tuple, hidden_pk_id);
-      break;
-    }
-
-    Field *const field = m_pack_info[i].get_field_in_table(tbl);
-    DBUG_ASSERT(field != nullptr);
-
-    uint field_offset = field->ptr - tbl->record[0];
-    uint null_offset = field->null_offset(tbl->record[0]);
-    bool maybe_null = field->real_maybe_null();
-
-    field->move_field(
-        const_cast<uchar *>(record) + field_offset,
-        maybe_null ? const_cast<uchar *>(record) + null_offset : nullptr,
-        field->null_bit);
-    // WARNING! Don't return without restoring field->ptr and field->null_ptr
+  if (m_integer_key) {
+    // Integers have no unpack info and are always covered
+    DBUG_ASSERT(!store_covered_bitmap);
+    tuple = pack_integer_parts(record, tuple, n_key_parts,
+                               hidden_pk_exists ? hidden_pk_id : 0,
+                               n_null_fields);
+  } else {
+    for (uint i = 0; i < n_key_parts; i++) {
+      // Fill hidden pk id into the last key part for secondary keys for tables
+      // with no pk
+      if (hidden_pk_exists && hidden_pk_id && i + 1 == n_key_parts) {
+        m_pack_info[i].fill_hidden_pk_val(&tuple, hidden_pk_id);
+        break;
+      }
 
-    tuple = pack_field(field, &m_pack_info[i], tuple, packed_tuple, pack_buffer,
-                       unpack_info, n_null_fields);
+      Field *const field = m_pack_info[i].get_field_in_table(tbl);
+      DBUG_ASSERT(field != nullptr);
+
+      uint field_offset = field->ptr - tbl->record[0];
+      uint null_offset = field->null_offset(tbl->record[0]);
+      bool maybe_null = field->real_maybe_null();
+
+      field->move_field(
+          const_cast<uchar *>(record) + field_offset,
+          maybe_null ? const_cast<uchar *>(record) + null_offset : nullptr,
+          field->null_bit);
+      // WARNING! Don't return without restoring field->ptr and field->null_ptr
+
+      tuple = pack_field(field, &m_pack_info[i], tuple, packed_tuple,
+                         pack_buffer, unpack_info, n_null_fields);
+
+      // If this key part is a prefix of a VARCHAR field, check if it's covered.
+      if (store_covered_bitmap && field->real_type() == MYSQL_TYPE_VARCHAR &&
+          !m_pack_info[i].m_covered && curr_bitmap_pos < MAX_REF_PARTS) {
+        size_t data_length = field->data_length();
+        uint16 key_length;
+        if (m_pk_part_no[i] == (uint)-1) {
+          key_length = tbl->key_info[get_keyno()].key_part[i].length;
+        } else {
+          key_length = tbl->key_info[tbl->s->primary_key]
+                           .key_part[m_pk_part_no[i]]
+                           .length;
+        }
 
-    // If this key part is a prefix of a VARCHAR field, check if it's covered.
-    if (store_covered_bitmap && field->real_type() == MYSQL_TYPE_VARCHAR &&
-        !m_pack_info[i].m_covered && curr_bitmap_pos < MAX_REF_PARTS) {
-      size_t data_length = field->data_length();
-      uint16 key_length;
-      if (m_pk_part_no[i] == (uint)-1) {
-        key_length = tbl->key_info[get_keyno()].key_part[i].length;
-      } else {
-        key_length =
-            tbl->key_info[tbl->s->primary_key].key_part[m_pk_part_no[i]].length;
+        if (m_pack_info[i].m_unpack_func != nullptr &&
+            data_length <= key_length) {
+          bitmap_set_bit(&covered_bitmap, curr_bitmap_pos);
+        }
+        curr_bitmap_pos++;
       }
 
-      if (m_pack_info[i].m_unpack_func != nullptr &&
-          data_length <= key_length) {
-        bitmap_set_bit(&covered_bitmap, curr_bitmap_pos);
-      }
-      curr_bitmap_pos++;
+      // Restore field->ptr and field->null_ptr
+      field->move_field(tbl->record[0] + field_offset,
+                        maybe_null ? tbl->record[0] + null_offset : nullptr,
+                        field->null_bit);
     }
-
-    // Restore field->ptr and field->null_ptr
-    field->move_field(tbl->record[0] + field_offset,
-                      maybe_null ? tbl->record[0] + null_offset : nullptr,
-                      field->null_bit);
   }
 
   if (unpack_info) {
@@ -1652,6 +1759,84 @@ int Rdb_key_def::decode_unpack_info(Rdb_string_reader *unp_reader,
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  The key part loop of unpack_record() for keys where m_integer_key is set,
+  calling unpack_integer() directly rather than going through
+  Rdb_key_field_iterator and the per part unpack functions.
+
+  @return
+    HA_EXIT_SUCCESS    OK
+    other              HA_ERR error code
+*/
+int Rdb_key_def::unpack_integer_parts(TABLE *const table, uchar *const buf,
+                                      Rdb_string_reader *const reader) const {
+  const bool hidden_pk_part =
+      m_index_type == INDEX_TYPE_HIDDEN_PRIMARY ||
+      (m_index_type == INDEX_TYPE_SECONDARY && table_has_hidden_pk(table));
+  const uint n_fields = hidden_pk_part ? m_key_parts - 1 : m_key_parts;
+
+  for (uint i = 0; i < n_fields; i++) {
+    Rdb_field_packing *const fpi = &m_pack_info[i];
+
+    if (fpi->m_field_maybe_null) {
+      const char *nullp;
+      if (!(nullp = reader->read(1))) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+
+      if (likely(*nullp == 1)) {
+        /* Clear the NULL-bit of this field */
+        buf[fpi->m_field_null_offset] &= (uchar) ~(fpi->m_field_null_bit_mask);
+      } else if (*nullp == 0) {
+        /* Set the NULL-bit of this field */
+        buf[fpi->m_field_null_offset] |= fpi->m_field_null_bit_mask;
+
+        /* Also set the field to its default value */
+        memcpy(buf + fpi->m_field_offset,
+               table->s->default_values + fpi->m_field_offset,
+               fpi->m_field_pack_length);
+        continue;
+      } else {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+    }
+
+    uchar *const to = buf + fpi->m_field_offset;
+    int res;
+    switch (fpi->m_max_image_len) {
+      case 8:
+        res = unpack_integer<8>(fpi, to, reader, nullptr);
+        break;
+      case 4:
+        res = unpack_integer<4>(fpi, to, reader, nullptr);
+        break;
+      case 3:
+        res = unpack_integer<3>(fpi, to, reader, nullptr);
+        break;
+      case 2:
+        res = unpack_integer<2>(fpi, to, reader, nullptr);
+        break;
+      default:
+        DBUG_ASSERT(fpi->m_max_image_len == 1);
+        res = unpack_integer<1>(fpi, to, reader, nullptr);
+        break;
+    }
+    if (res != UNPACK_SUCCESS) {
+      return HA_ERR_ROCKSDB_CORRUPT_DATA;
+    }
+  }
+
+  /*
+    Hidden pk field is packed at the end of the secondary keys, but the SQL
+    layer does not know about it. Skip it.
+  */
+  if (hidden_pk_part &&
+      !reader->read(m_pack_info[m_key_parts - 1].m_max_image_len)) {
+    return HA_ERR_ROCKSDB_CORRUPT_DATA;
+  }
+  return HA_EXIT_SUCCESS;
+}
+
 /*
   Take mem-comparable form and unpack_info and unpack it to Table->record
 
@@ -1701,14 +1886,21 @@ int Rdb_key_def::unpack_record(TABLE *const table, uchar *const buf,
                                         RDB_UNPACK_COVERED_DATA_LEN_SIZE);
   }
 
-  Rdb_key_field_iterator iter(
-      this, m_pack_info, &reader, &unp_reader, table, has_unpack_info,
-      has_covered_bitmap ? &covered_bitmap : nullptr, buf);
-  while (iter.has_next()) {
-    err = iter.next();
+  if (m_integer_key) {
+    err = unpack_integer_parts(table, buf, &reader);
     if (unlikely(err)) {
       return err;
     }
+  } else {
+    Rdb_key_field_iterator iter(
+        this, m_pack_info, &reader, &unp_reader, table, has_unpack_info,
+        has_covered_bitmap ? &covered_bitmap : nullptr, buf);
+    while (iter.has_next()) {
+      err = iter.next();
+      if (unlikely(err)) {
+        return err;
+      }
+    }
   }
 
   /*
@@ -4401,6 +4593,7 @@ void Rdb_ddl_manager::set_stats(
     const auto &keydef = find(src.second.m_gl_index_id);
     if (keydef) {
       keydef->m_stats = src.second;
+      keydef->publish_histogram();
       m_stats2store[keydef->m_stats.m_gl_index_id] = keydef->m_stats;
     }
   }
@@ -4419,6 +4612,7 @@ void Rdb_ddl_manager::adjust_stats(
         keydef->m_stats.m_distinct_keys_per_prefix.resize(
             keydef->get_key_parts());
         keydef->m_stats.merge(src, i == 0, keydef->max_storage_fmt_length());
+        keydef->publish_histogram();
         m_stats2store[keydef->m_stats.m_gl_index_id] = keydef->m_stats;
       }
     }
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <boost/optional.hpp>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -788,6 +789,19 @@ class Rdb_key_def {
   std::string m_name;
   mutable Rdb_index_stats m_stats;
 
+  /*
+    m_stats is changed under the DDL manager lock, but records_in_range()
+    reads the key histogram without it, so it gets a copy of the histogram
+    that is replaced, not changed, whenever m_stats is.
+  */
+  std::shared_ptr<const Rdb_key_histogram> get_histogram() const {
+    return std::atomic_load(&m_histogram);
+  }
+  void publish_histogram() const {
+    std::atomic_store(&m_histogram, std::make_shared<const Rdb_key_histogram>(
+                                        m_stats.m_histogram));
+  }
+
   /*
     Bitmap containing information about whether TTL or other special fields
     are enabled for the given index.
@@ -853,6 +867,22 @@ class Rdb_key_def {
   /* Maximum length of the mem-comparable form. */
   uint m_maxlength;
 
+  /*
+    TRUE <=> all key parts are integer columns (and possibly the hidden PK),
+    so that pack_record() and unpack_record() handle them with
+    pack_integer_parts() and unpack_integer_parts().
+  */
+  bool m_integer_key;
+
+  mutable std::shared_ptr<const Rdb_key_histogram> m_histogram;
+
+  uchar *pack_integer_parts(const uchar *const record, uchar *tuple,
+                            const uint n_key_parts,
+                            const longlong hidden_pk_id,
+                            uint *const n_null_fields) const;
+  int unpack_integer_parts(TABLE *const table, uchar *const buf,
+                           Rdb_string_reader *const reader) const;
+
   /* mutex to protect setup */
   mysql_mutex_t m_mutex;
 };
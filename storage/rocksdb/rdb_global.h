@@ -57,6 +57,10 @@ struct Rdb_trx_info {
   int num_ongoing_bulk_load;
   ulong thread_id;
   std::string query_str;
+  /* Bytes of data in the write batch */
+  ulonglong write_batch_size;
+  /* Bytes used to track the keys written, see rocksdb_track_written_keys */
+  ulonglong written_keys_memory;
 };
 
 std::vector<Rdb_trx_info> rdb_get_all_trx_info();
@@ -81,6 +85,62 @@ struct Rdb_deadlock_info {
 
 std::vector<Rdb_deadlock_info> rdb_get_deadlock_info();
 
+/*
+ * class for exporting the progress of index drops for
+ * information_schema.rocksdb_drop_index_progress
+ */
+struct Rdb_drop_index_progress {
+  uint32_t cf_id;
+  uint32_t index_id;
+  /* Slices deleted so far, see rocksdb_drop_index_slice_size */
+  ulonglong slices;
+  /* Estimated from the entries of the SST files of the index */
+  ulonglong keys_deleted;
+  /* Approximate bytes covered by the deleted slices */
+  ulonglong bytes_reclaimed;
+};
+
+std::vector<Rdb_drop_index_progress> rdb_get_drop_index_progress();
+
+/*
+ * class for exporting the work compactions did on an index for
+ * information_schema.rocksdb_index_compaction_stats
+ */
+struct Rdb_index_compaction_stats {
+  uint32_t cf_id;
+  uint32_t index_id;
+  /* Entries the compaction filter kept, and their bytes */
+  ulonglong rows_kept;
+  ulonglong bytes_kept;
+  /* Entries the compaction filter removed because their TTL expired */
+  ulonglong rows_expired;
+  ulonglong bytes_expired;
+  /* Entries the compaction filter removed because the index was dropped */
+  ulonglong rows_dropped;
+  ulonglong bytes_dropped;
+  /* Compactions of the index requested by the background thread */
+  ulonglong auto_compactions;
+};
+
+std::vector<Rdb_index_compaction_stats> rdb_get_index_compaction_stats();
+
+/*
+ * class for exporting the work compactions did on a column family for
+ * information_schema.rocksdb_cf_compaction_stats
+ */
+struct Rdb_cf_compaction_stats {
+  uint32_t cf_id;
+  ulonglong compactions;
+  ulonglong cpu_micros;
+  ulonglong input_records;
+  ulonglong output_records;
+  /* Deletion markers read, and the ones dropped for good */
+  ulonglong input_deletions;
+  ulonglong dropped_deletions;
+};
+
+std::vector<Rdb_cf_compaction_stats> rdb_get_cf_compaction_stats();
+
 /*
   This is
   - the name of the default Column Family (the CF which stores indexes which
@@ -126,6 +186,11 @@ const char *const INDEX_STATS_THREAD_NAME = "myrocks-is";
 */
 const char *const MANUAL_COMPACTION_THREAD_NAME = "myrocks-mc";
 
+/*
+  Name for the threads of a parallel primary key scan.
+*/
+const char *const PK_SCAN_THREAD_NAME = "myrocks-scan";
+
 /*
   Separator between partition name and the qualifier. Sample usage:
 
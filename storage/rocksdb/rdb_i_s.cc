@@ -1629,7 +1629,9 @@ enum {
   HAS_DEADLOCK_DETECTION,
   NUM_ONGOING_BULKLOAD,
   THREAD_ID,
-  QUERY
+  QUERY,
+  WRITE_BATCH_SIZE,
+  WRITTEN_KEYS_MEMORY
 };
 }  // namespace RDB_TRX_FIELD
 
@@ -1654,6 +1656,10 @@ static ST_FIELD_INFO rdb_i_s_trx_info_fields_info[] = {
                        MYSQL_TYPE_LONG, 0),
     ROCKSDB_FIELD_INFO("THREAD_ID", sizeof(ulong), MYSQL_TYPE_LONG, 0),
     ROCKSDB_FIELD_INFO("QUERY", NAME_LEN + 1, MYSQL_TYPE_STRING, 0),
+    ROCKSDB_FIELD_INFO("WRITE_BATCH_SIZE", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("WRITTEN_KEYS_MEMORY", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
     ROCKSDB_FIELD_INFO_END};
 
 /* Fill the information_schema.rocksdb_trx virtual table */
@@ -1711,6 +1717,10 @@ static int rdb_i_s_trx_info_fill_table(
     tables->table->field[RDB_TRX_FIELD::THREAD_ID]->store(info.thread_id, true);
     tables->table->field[RDB_TRX_FIELD::QUERY]->store(
         info.query_str.c_str(), info.query_str.length(), system_charset_info);
+    tables->table->field[RDB_TRX_FIELD::WRITE_BATCH_SIZE]->store(
+        info.write_batch_size, true);
+    tables->table->field[RDB_TRX_FIELD::WRITTEN_KEYS_MEMORY]->store(
+        info.written_keys_memory, true);
 
     /* Tell MySQL about this row in the virtual table */
     ret = static_cast<int>(
@@ -1856,6 +1866,282 @@ static int rdb_i_s_deadlock_info_init(void *const p) {
   DBUG_RETURN(0);
 }
 
+/*
+  Support for INFORMATION_SCHEMA.ROCKSDB_DROP_INDEX_PROGRESS dynamic table
+ */
+namespace RDB_DROP_INDEX_PROGRESS_FIELD {
+enum {
+  COLUMN_FAMILY = 0,
+  INDEX_NUMBER,
+  SLICES,
+  KEYS_DELETED,
+  BYTES_RECLAIMED
+};
+}  // namespace RDB_DROP_INDEX_PROGRESS_FIELD
+
+static ST_FIELD_INFO rdb_i_s_drop_index_progress_fields_info[] = {
+    ROCKSDB_FIELD_INFO("COLUMN_FAMILY", sizeof(uint32_t), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("INDEX_NUMBER", sizeof(uint32_t), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("SLICES", sizeof(ulonglong), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("KEYS_DELETED", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("BYTES_RECLAIMED", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO_END};
+
+/* Fill the information_schema.rocksdb_drop_index_progress virtual table */
+static int rdb_i_s_drop_index_progress_fill_table(
+    my_core::THD *const thd, my_core::TABLE_LIST *const tables,
+    my_core::Item *const cond MY_ATTRIBUTE((__unused__))) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(thd != nullptr);
+  DBUG_ASSERT(tables != nullptr);
+  DBUG_ASSERT(tables->table != nullptr);
+  DBUG_ASSERT(tables->table->field != nullptr);
+
+  int ret = 0;
+  rocksdb::DB *const rdb = rdb_get_rocksdb_db();
+
+  if (!rdb) {
+    DBUG_RETURN(ret);
+  }
+
+  for (const auto &info : rdb_get_drop_index_progress()) {
+    tables->table->field[RDB_DROP_INDEX_PROGRESS_FIELD::COLUMN_FAMILY]->store(
+        info.cf_id, true);
+    tables->table->field[RDB_DROP_INDEX_PROGRESS_FIELD::INDEX_NUMBER]->store(
+        info.index_id, true);
+    tables->table->field[RDB_DROP_INDEX_PROGRESS_FIELD::SLICES]->store(
+        info.slices, true);
+    tables->table->field[RDB_DROP_INDEX_PROGRESS_FIELD::KEYS_DELETED]->store(
+        info.keys_deleted, true);
+    tables->table->field[RDB_DROP_INDEX_PROGRESS_FIELD::BYTES_RECLAIMED]
+        ->store(info.bytes_reclaimed, true);
+
+    /* Tell MySQL about this row in the virtual table */
+    ret = static_cast<int>(
+        my_core::schema_table_store_record(thd, tables->table));
+
+    if (ret != 0) {
+      break;
+    }
+  }
+
+  DBUG_RETURN(ret);
+}
+
+/* Initialize the information_schema.rocksdb_drop_index_progress table */
+static int rdb_i_s_drop_index_progress_init(void *const p) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(p != nullptr);
+
+  my_core::ST_SCHEMA_TABLE *schema;
+
+  schema = (my_core::ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info = rdb_i_s_drop_index_progress_fields_info;
+  schema->fill_table = rdb_i_s_drop_index_progress_fill_table;
+
+  DBUG_RETURN(0);
+}
+
+/*
+  Support for INFORMATION_SCHEMA.ROCKSDB_INDEX_COMPACTION_STATS dynamic table
+ */
+namespace RDB_INDEX_COMPACTION_STATS_FIELD {
+enum {
+  COLUMN_FAMILY = 0,
+  INDEX_NUMBER,
+  ROWS_KEPT,
+  BYTES_KEPT,
+  ROWS_EXPIRED,
+  BYTES_EXPIRED,
+  ROWS_DROPPED,
+  BYTES_DROPPED,
+  AUTO_COMPACTIONS
+};
+}  // namespace RDB_INDEX_COMPACTION_STATS_FIELD
+
+static ST_FIELD_INFO rdb_i_s_index_compaction_stats_fields_info[] = {
+    ROCKSDB_FIELD_INFO("COLUMN_FAMILY", sizeof(uint32_t), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("INDEX_NUMBER", sizeof(uint32_t), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("ROWS_KEPT", sizeof(ulonglong), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("BYTES_KEPT", sizeof(ulonglong), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("ROWS_EXPIRED", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("BYTES_EXPIRED", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("ROWS_DROPPED", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("BYTES_DROPPED", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("AUTO_COMPACTIONS", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO_END};
+
+/* Fill the information_schema.rocksdb_index_compaction_stats virtual table */
+static int rdb_i_s_index_compaction_stats_fill_table(
+    my_core::THD *const thd, my_core::TABLE_LIST *const tables,
+    my_core::Item *const cond MY_ATTRIBUTE((__unused__))) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(thd != nullptr);
+  DBUG_ASSERT(tables != nullptr);
+  DBUG_ASSERT(tables->table != nullptr);
+  DBUG_ASSERT(tables->table->field != nullptr);
+
+  int ret = 0;
+  rocksdb::DB *const rdb = rdb_get_rocksdb_db();
+
+  if (!rdb) {
+    DBUG_RETURN(ret);
+  }
+
+  Field **field = tables->table->field;
+  for (const auto &info : rdb_get_index_compaction_stats()) {
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::COLUMN_FAMILY]->store(info.cf_id,
+                                                                  true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::INDEX_NUMBER]->store(
+        info.index_id, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::ROWS_KEPT]->store(info.rows_kept,
+                                                              true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::BYTES_KEPT]->store(
+        info.bytes_kept, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::ROWS_EXPIRED]->store(
+        info.rows_expired, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::BYTES_EXPIRED]->store(
+        info.bytes_expired, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::ROWS_DROPPED]->store(
+        info.rows_dropped, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::BYTES_DROPPED]->store(
+        info.bytes_dropped, true);
+    field[RDB_INDEX_COMPACTION_STATS_FIELD::AUTO_COMPACTIONS]->store(
+        info.auto_compactions, true);
+
+    /* Tell MySQL about this row in the virtual table */
+    ret = static_cast<int>(
+        my_core::schema_table_store_record(thd, tables->table));
+
+    if (ret != 0) {
+      break;
+    }
+  }
+
+  DBUG_RETURN(ret);
+}
+
+/* Initialize the information_schema.rocksdb_index_compaction_stats table */
+static int rdb_i_s_index_compaction_stats_init(void *const p) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(p != nullptr);
+
+  my_core::ST_SCHEMA_TABLE *schema;
+
+  schema = (my_core::ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info = rdb_i_s_index_compaction_stats_fields_info;
+  schema->fill_table = rdb_i_s_index_compaction_stats_fill_table;
+
+  DBUG_RETURN(0);
+}
+
+/*
+  Support for INFORMATION_SCHEMA.ROCKSDB_CF_COMPACTION_STATS dynamic table
+ */
+namespace RDB_CF_COMPACTION_STATS_FIELD {
+enum {
+  COLUMN_FAMILY = 0,
+  COMPACTIONS,
+  CPU_MICROS,
+  INPUT_RECORDS,
+  OUTPUT_RECORDS,
+  INPUT_DELETIONS,
+  DROPPED_DELETIONS
+};
+}  // namespace RDB_CF_COMPACTION_STATS_FIELD
+
+static ST_FIELD_INFO rdb_i_s_cf_compaction_stats_fields_info[] = {
+    ROCKSDB_FIELD_INFO("COLUMN_FAMILY", sizeof(uint32_t), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("COMPACTIONS", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("CPU_MICROS", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("INPUT_RECORDS", sizeof(ulonglong), MYSQL_TYPE_LONGLONG,
+                       0),
+    ROCKSDB_FIELD_INFO("OUTPUT_RECORDS", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("INPUT_DELETIONS", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("DROPPED_DELETIONS", sizeof(ulonglong),
+                       MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO_END};
+
+/* Fill the information_schema.rocksdb_cf_compaction_stats virtual table */
+static int rdb_i_s_cf_compaction_stats_fill_table(
+    my_core::THD *const thd, my_core::TABLE_LIST *const tables,
+    my_core::Item *const cond MY_ATTRIBUTE((__unused__))) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(thd != nullptr);
+  DBUG_ASSERT(tables != nullptr);
+  DBUG_ASSERT(tables->table != nullptr);
+  DBUG_ASSERT(tables->table->field != nullptr);
+
+  int ret = 0;
+  rocksdb::DB *const rdb = rdb_get_rocksdb_db();
+
+  if (!rdb) {
+    DBUG_RETURN(ret);
+  }
+
+  Field **field = tables->table->field;
+  for (const auto &info : rdb_get_cf_compaction_stats()) {
+    field[RDB_CF_COMPACTION_STATS_FIELD::COLUMN_FAMILY]->store(info.cf_id,
+                                                               true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::COMPACTIONS]->store(info.compactions,
+                                                             true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::CPU_MICROS]->store(info.cpu_micros,
+                                                            true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::INPUT_RECORDS]->store(
+        info.input_records, true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::OUTPUT_RECORDS]->store(
+        info.output_records, true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::INPUT_DELETIONS]->store(
+        info.input_deletions, true);
+    field[RDB_CF_COMPACTION_STATS_FIELD::DROPPED_DELETIONS]->store(
+        info.dropped_deletions, true);
+
+    /* Tell MySQL about this row in the virtual table */
+    ret = static_cast<int>(
+        my_core::schema_table_store_record(thd, tables->table));
+
+    if (ret != 0) {
+      break;
+    }
+  }
+
+  DBUG_RETURN(ret);
+}
+
+/* Initialize the information_schema.rocksdb_cf_compaction_stats table */
+static int rdb_i_s_cf_compaction_stats_init(void *const p) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(p != nullptr);
+
+  my_core::ST_SCHEMA_TABLE *schema;
+
+  schema = (my_core::ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info = rdb_i_s_cf_compaction_stats_fields_info;
+  schema->fill_table = rdb_i_s_cf_compaction_stats_fill_table;
+
+  DBUG_RETURN(0);
+}
+
 static int rdb_i_s_deinit(void *p MY_ATTRIBUTE((__unused__))) {
   DBUG_ENTER_FUNC();
   DBUG_RETURN(0);
@@ -2087,4 +2373,52 @@ struct st_mysql_plugin rdb_i_s_bypass_rejected_query_history = {
     nullptr, /* config options */
     0,       /* flags */
 };
+
+struct st_mysql_plugin rdb_i_s_drop_index_progress = {
+    MYSQL_INFORMATION_SCHEMA_PLUGIN,
+    &rdb_i_s_info,
+    "ROCKSDB_DROP_INDEX_PROGRESS",
+    "Facebook",
+    "RocksDB progress of ongoing index drops",
+    PLUGIN_LICENSE_GPL,
+    rdb_i_s_drop_index_progress_init,
+    rdb_i_s_deinit,
+    0x0001,  /* version number (0.1) */
+    nullptr, /* status variables */
+    nullptr, /* system variables */
+    nullptr, /* config options */
+    0,       /* flags */
+};
+
+struct st_mysql_plugin rdb_i_s_index_compaction_stats = {
+    MYSQL_INFORMATION_SCHEMA_PLUGIN,
+    &rdb_i_s_info,
+    "ROCKSDB_INDEX_COMPACTION_STATS",
+    "Facebook",
+    "RocksDB rows kept and removed by compactions, by index",
+    PLUGIN_LICENSE_GPL,
+    rdb_i_s_index_compaction_stats_init,
+    rdb_i_s_deinit,
+    0x0001,  /* version number (0.1) */
+    nullptr, /* status variables */
+    nullptr, /* system variables */
+    nullptr, /* config options */
+    0,       /* flags */
+};
+
+struct st_mysql_plugin rdb_i_s_cf_compaction_stats = {
+    MYSQL_INFORMATION_SCHEMA_PLUGIN,
+    &rdb_i_s_info,
+    "ROCKSDB_CF_COMPACTION_STATS",
+    "Facebook",
+    "RocksDB work done by compactions, by column family",
+    PLUGIN_LICENSE_GPL,
+    rdb_i_s_cf_compaction_stats_init,
+    rdb_i_s_deinit,
+    0x0001,  /* version number (0.1) */
+    nullptr, /* status variables */
+    nullptr, /* system variables */
+    nullptr, /* config options */
+    0,       /* flags */
+};
 }  // namespace myrocks
@@ -35,4 +35,7 @@ extern struct st_mysql_plugin rdb_i_s_lock_info;
 extern struct st_mysql_plugin rdb_i_s_trx_info;
 extern struct st_mysql_plugin rdb_i_s_deadlock_info;
 extern struct st_mysql_plugin rdb_i_s_bypass_rejected_query_history;
+extern struct st_mysql_plugin rdb_i_s_drop_index_progress;
+extern struct st_mysql_plugin rdb_i_s_index_compaction_stats;
+extern struct st_mysql_plugin rdb_i_s_cf_compaction_stats;
 }  // namespace myrocks
@@ -622,4 +622,51 @@ void Rdb_index_merge::merge_reset() {
   }
 }
 
+Rdb_index_merge_union::Rdb_index_merge_union(
+    std::vector<std::unique_ptr<Rdb_index_merge>> &&merges)
+    : m_merges(std::move(merges)),
+      m_heap(union_entry_comparator{
+          m_merges.empty() ? nullptr : m_merges[0]->get_cf()->GetComparator()}),
+      m_last_merge(SIZE_MAX) {}
+
+/**
+  Read the next record of a merge and put it on the heap, unless the merge
+  is finished.
+*/
+int Rdb_index_merge_union::read_next(const size_t merge) {
+  union_entry entry;
+  entry.m_merge = merge;
+  const int res = m_merges[merge]->next(&entry.m_key, &entry.m_val);
+  if (res == HA_EXIT_SUCCESS) {
+    m_heap.push(entry);
+  }
+  return res > 0 ? res : HA_EXIT_SUCCESS;
+}
+
+int Rdb_index_merge_union::next(rocksdb::Slice *const key,
+                                rocksdb::Slice *const val) {
+  int res;
+  if (m_last_merge == SIZE_MAX) {
+    /* First call, start every merge */
+    for (size_t i = 0; i < m_merges.size(); i++) {
+      if ((res = read_next(i))) {
+        return res;
+      }
+    }
+  } else if ((res = read_next(m_last_merge))) {
+    return res;
+  }
+
+  if (m_heap.empty()) {
+    return -1;
+  }
+
+  const union_entry &top = m_heap.top();
+  *key = top.m_key;
+  *val = top.m_val;
+  m_last_merge = top.m_merge;
+  m_heap.pop();
+  return HA_EXIT_SUCCESS;
+}
+
 }  // namespace myrocks
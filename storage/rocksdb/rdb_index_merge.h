@@ -22,6 +22,7 @@
 #include "./my_global.h" /* ulonglong */
 
 /* C++ standard header files */
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -224,4 +225,55 @@ class Rdb_index_merge {
   rocksdb::ColumnFamilyHandle *get_cf() const { return m_cf_handle; }
 };
 
+/*
+  Merges the output of several Rdb_index_merge objects, each holding the
+  keys of a different part of the same table, into one stream in key order.
+  Used when the rows of a table are scanned and sorted in parallel.
+*/
+class Rdb_index_merge_union {
+  Rdb_index_merge_union(const Rdb_index_merge_union &p) = delete;
+  Rdb_index_merge_union &operator=(const Rdb_index_merge_union &p) = delete;
+
+ public:
+  explicit Rdb_index_merge_union(
+      std::vector<std::unique_ptr<Rdb_index_merge>> &&merges);
+
+  /*
+    Same as Rdb_index_merge::next(): returns 0 with the next record, -1 at
+    the end and an error code otherwise
+  */
+  int next(rocksdb::Slice *const key, rocksdb::Slice *const val)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+
+ private:
+  /* Current record of one of the merges */
+  struct union_entry {
+    size_t m_merge;
+    rocksdb::Slice m_key;
+    rocksdb::Slice m_val;
+  };
+
+  struct union_entry_comparator {
+    const rocksdb::Comparator *m_comparator;
+
+    bool operator()(const union_entry &lhs, const union_entry &rhs) const {
+      return m_comparator->Compare(rhs.m_key, lhs.m_key) < 0;
+    }
+  };
+
+  int read_next(const size_t merge)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+
+  std::vector<std::unique_ptr<Rdb_index_merge>> m_merges;
+  std::priority_queue<union_entry, std::vector<union_entry>,
+                      union_entry_comparator>
+      m_heap;
+
+  /*
+    Merge the last returned record came from. Its slices stay valid until
+    that merge is read again, so it is only advanced by the following call.
+  */
+  size_t m_last_merge;
+};
+
 }  // namespace myrocks
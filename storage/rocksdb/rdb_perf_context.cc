@@ -93,7 +93,9 @@ std::string rdb_pc_stat_types[] = {
     "IO_WRITE_NANOS",
     "IO_READ_NANOS",
     "IO_RANGE_SYNC_NANOS",
-    "IO_LOGGER_NANOS"};
+    "IO_LOGGER_NANOS",
+    "SCAN_READAHEAD_ITERATORS",
+    "SCAN_READAHEAD_BYTES"};
 
 #define IO_PERF_RECORD(_field_)                                       \
   do {                                                                \
@@ -215,6 +217,23 @@ void Rdb_io_perf::update_bytes_written(const uint32_t perf_context_level,
   }
 }
 
+void Rdb_io_perf::update_scan_readahead(const uint32_t perf_context_level,
+                                        ulonglong readahead_size) {
+  const rocksdb::PerfLevel perf_level =
+      static_cast<rocksdb::PerfLevel>(perf_context_level);
+  if (perf_level != rocksdb::kDisable) {
+    scan_readahead_iterators += 1;
+    scan_readahead_bytes += readahead_size;
+  }
+}
+
+static void record_scan_readahead(Rdb_atomic_perf_counters *const counters,
+                                  const uint64_t iterators,
+                                  const uint64_t bytes) {
+  counters->m_value[PC_SCAN_READAHEAD_ITERATORS] += iterators;
+  counters->m_value[PC_SCAN_READAHEAD_BYTES] += bytes;
+}
+
 void Rdb_io_perf::end_and_record(const uint32_t perf_context_level) {
   const rocksdb::PerfLevel perf_level =
       static_cast<rocksdb::PerfLevel>(perf_context_level);
@@ -228,6 +247,17 @@ void Rdb_io_perf::end_and_record(const uint32_t perf_context_level) {
   }
   harvest_diffs(&rdb_global_perf_counters);
 
+  if (scan_readahead_iterators != 0) {
+    if (m_atomic_counters) {
+      record_scan_readahead(m_atomic_counters, scan_readahead_iterators,
+                            scan_readahead_bytes);
+    }
+    record_scan_readahead(&rdb_global_perf_counters, scan_readahead_iterators,
+                          scan_readahead_bytes);
+    scan_readahead_iterators = 0;
+    scan_readahead_bytes = 0;
+  }
+
   if (m_shared_io_perf_read &&
       (rocksdb::get_perf_context()->block_read_byte != 0 ||
        rocksdb::get_perf_context()->block_read_count != 0 ||
@@ -85,6 +85,9 @@ enum {
   PC_IO_READ_NANOS,
   PC_IO_RANGE_SYNC_NANOS,
   PC_IO_LOGGER_NANOS,
+  /* Counted by MyRocks, see ha_rocksdb::start_scan_readahead() */
+  PC_SCAN_READAHEAD_ITERATORS,
+  PC_SCAN_READAHEAD_BYTES,
   PC_MAX_IDX
 };
 
@@ -127,6 +130,8 @@ class Rdb_io_perf {
 
   uint64_t io_write_bytes;
   uint64_t io_write_requests;
+  uint64_t scan_readahead_iterators;
+  uint64_t scan_readahead_bytes;
 
  public:
   Rdb_io_perf(const Rdb_io_perf &) = delete;
@@ -148,11 +153,15 @@ class Rdb_io_perf {
 
     io_write_bytes = 0;
     io_write_requests = 0;
+    scan_readahead_iterators = 0;
+    scan_readahead_bytes = 0;
   }
 
   bool start(const uint32_t perf_context_level);
   void update_bytes_written(const uint32_t perf_context_level,
                             ulonglong bytes_written);
+  void update_scan_readahead(const uint32_t perf_context_level,
+                             ulonglong readahead_size);
   void end_and_record(const uint32_t perf_context_level);
 
   explicit Rdb_io_perf()
@@ -160,7 +169,9 @@ class Rdb_io_perf {
         m_shared_io_perf_read(nullptr),
         m_stats(nullptr),
         io_write_bytes(0),
-        io_write_requests(0) {}
+        io_write_requests(0),
+        scan_readahead_iterators(0),
+        scan_readahead_bytes(0) {}
 };
 
 }  // namespace myrocks
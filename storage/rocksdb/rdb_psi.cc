@@ -35,13 +35,15 @@ my_core::PSI_stage_info stage_waiting_on_row_lock = {0, "Waiting for row lock",
 my_core::PSI_stage_info *all_rocksdb_stages[] = {&stage_waiting_on_row_lock};
 
 my_core::PSI_thread_key rdb_background_psi_thread_key,
-    rdb_drop_idx_psi_thread_key, rdb_is_psi_thread_key, rdb_mc_psi_thread_key;
+    rdb_drop_idx_psi_thread_key, rdb_is_psi_thread_key, rdb_mc_psi_thread_key,
+    rdb_pk_scan_psi_thread_key;
 
 my_core::PSI_thread_info all_rocksdb_threads[] = {
     {&rdb_background_psi_thread_key, "background", PSI_FLAG_GLOBAL},
     {&rdb_drop_idx_psi_thread_key, "drop index", PSI_FLAG_GLOBAL},
     {&rdb_is_psi_thread_key, "index stats calculation", PSI_FLAG_GLOBAL},
     {&rdb_mc_psi_thread_key, "manual compaction", PSI_FLAG_GLOBAL},
+    {&rdb_pk_scan_psi_thread_key, "parallel scan", PSI_FLAG_GLOBAL},
 };
 
 my_core::PSI_mutex_key rdb_psi_open_tbls_mutex_key, rdb_signal_bg_psi_mutex_key,
@@ -49,7 +51,8 @@ my_core::PSI_mutex_key rdb_psi_open_tbls_mutex_key, rdb_signal_bg_psi_mutex_key,
     rdb_signal_mc_psi_mutex_key, rdb_collation_data_mutex_key,
     rdb_mem_cmp_space_mutex_key, key_mutex_tx_list, rdb_sysvars_psi_mutex_key,
     rdb_cfm_mutex_key, rdb_sst_commit_key, rdb_block_cache_resize_mutex_key,
-    rdb_bottom_pri_background_compactions_resize_mutex_key;
+    rdb_bottom_pri_background_compactions_resize_mutex_key,
+    rdb_signal_pk_scan_psi_mutex_key;
 
 my_core::PSI_mutex_info all_rocksdb_mutexes[] = {
     {&rdb_psi_open_tbls_mutex_key, "open tables", PSI_FLAG_GLOBAL},
@@ -69,6 +72,8 @@ my_core::PSI_mutex_info all_rocksdb_mutexes[] = {
      PSI_FLAG_GLOBAL},
     {&rdb_bottom_pri_background_compactions_resize_mutex_key,
      "resizing bottom pri compaction threads", PSI_FLAG_GLOBAL},
+    {&rdb_signal_pk_scan_psi_mutex_key, "signal parallel scan",
+     PSI_FLAG_GLOBAL},
 };
 
 my_core::PSI_rwlock_key key_rwlock_collation_exception_list,
@@ -84,7 +89,7 @@ my_core::PSI_rwlock_info all_rocksdb_rwlocks[] = {
 
 my_core::PSI_cond_key rdb_signal_bg_psi_cond_key,
     rdb_signal_drop_idx_psi_cond_key, rdb_signal_is_psi_cond_key,
-    rdb_signal_mc_psi_cond_key;
+    rdb_signal_mc_psi_cond_key, rdb_signal_pk_scan_psi_cond_key;
 
 my_core::PSI_cond_info all_rocksdb_conds[] = {
     {&rdb_signal_bg_psi_cond_key, "cond signal background", PSI_FLAG_GLOBAL},
@@ -94,6 +99,8 @@ my_core::PSI_cond_info all_rocksdb_conds[] = {
      PSI_FLAG_GLOBAL},
     {&rdb_signal_mc_psi_cond_key, "cond signal manual compaction",
      PSI_FLAG_GLOBAL},
+    {&rdb_signal_pk_scan_psi_cond_key, "cond signal parallel scan",
+     PSI_FLAG_GLOBAL},
 };
 
 void init_rocksdb_psi_keys() {
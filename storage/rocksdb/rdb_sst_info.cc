@@ -159,32 +159,25 @@ rocksdb::Status Rdb_sst_file_ordered::Rdb_sst_file::commit() {
 
 void Rdb_sst_file_ordered::Rdb_sst_stack::push(const rocksdb::Slice &key,
                                                const rocksdb::Slice &value) {
-  if (m_buffer == nullptr) {
-    m_buffer = new char[m_buffer_size];
-  }
-
   // Put the actual key and value data unto our stack
-  size_t key_offset = m_offset;
-  memcpy(m_buffer + m_offset, key.data(), key.size());
-  m_offset += key.size();
-  memcpy(m_buffer + m_offset, value.data(), value.size());
-  m_offset += value.size();
+  size_t key_offset = m_buffer.size();
+  m_buffer.append(key.data(), key.size());
+  m_buffer.append(value.data(), value.size());
 
   // Push just the offset, the key length and the value length onto the stack
-  m_stack.push(std::make_tuple(key_offset, key.size(), value.size()));
+  m_stack.push_back(std::make_tuple(key_offset, key.size(), value.size()));
 }
 
 std::pair<rocksdb::Slice, rocksdb::Slice>
-Rdb_sst_file_ordered::Rdb_sst_stack::top() {
+Rdb_sst_file_ordered::Rdb_sst_stack::at(size_t pos) {
   size_t offset, key_len, value_len;
-  // Pop the next item off the internal stack
-  std::tie(offset, key_len, value_len) = m_stack.top();
+  // Get the entry from the internal stack
+  std::tie(offset, key_len, value_len) = m_stack[pos];
 
   // Make slices from the offset (first), key length (second), and value
   // length (third)
-  DBUG_ASSERT(m_buffer != nullptr);
-  rocksdb::Slice key(m_buffer + offset, key_len);
-  rocksdb::Slice value(m_buffer + offset + key_len, value_len);
+  rocksdb::Slice key(m_buffer.data() + offset, key_len);
+  rocksdb::Slice value(m_buffer.data() + offset + key_len, value_len);
 
   return std::make_pair(key, value);
 }
@@ -192,13 +185,11 @@ Rdb_sst_file_ordered::Rdb_sst_stack::top() {
 Rdb_sst_file_ordered::Rdb_sst_file_ordered(
     rocksdb::DB *const db, rocksdb::ColumnFamilyHandle *const cf,
     const rocksdb::DBOptions &db_options, const std::string &name,
-    const bool tracing, size_t max_size)
+    const bool tracing, const bool buffered)
     : m_use_stack(false),
+      m_buffered(buffered),
       m_first(true),
-      m_stack(max_size),
-      m_file(db, cf, db_options, name, tracing) {
-  m_stack.reset();
-}
+      m_file(db, cf, db_options, name, tracing) {}
 
 rocksdb::Status Rdb_sst_file_ordered::apply_first() {
   rocksdb::Slice first_key_slice(m_first_key);
@@ -227,6 +218,11 @@ rocksdb::Status Rdb_sst_file_ordered::put(const rocksdb::Slice &key,
                                           const rocksdb::Slice &value) {
   rocksdb::Status s;
 
+  if (m_buffered) {
+    m_stack.push(key, value);
+    return s;
+  }
+
   // If this is the first key, just store a copy of the key and value
   if (m_first) {
     m_first_key = key.ToString();
@@ -260,9 +256,45 @@ rocksdb::Status Rdb_sst_file_ordered::put(const rocksdb::Slice &key,
   return s;
 }
 
+/*
+  Write out the rows of a buffered file. As for unbuffered files, the first
+  two keys tell whether the rows come in ascending or descending order.
+*/
+rocksdb::Status Rdb_sst_file_ordered::put_buffered() {
+  rocksdb::Status s;
+  rocksdb::Slice key;
+  rocksdb::Slice value;
+
+  const size_t n_rows = m_stack.size();
+  if (n_rows > 1 && m_file.compare(m_stack.at(0).first,
+                                   m_stack.at(1).first) > 0) {
+    for (size_t i = n_rows; i > 0 && s.ok(); i--) {
+      std::tie(key, value) = m_stack.at(i - 1);
+      s = m_file.put(key, value);
+    }
+  } else {
+    for (size_t i = 0; i < n_rows && s.ok(); i++) {
+      std::tie(key, value) = m_stack.at(i);
+      s = m_file.put(key, value);
+    }
+  }
+
+  m_stack.reset();
+  return s;
+}
+
+// This function is run by a writer thread for buffered files
 rocksdb::Status Rdb_sst_file_ordered::commit() {
   rocksdb::Status s;
 
+  if (m_buffered) {
+    s = put_buffered();
+    if (!s.ok()) {
+      return s;
+    }
+    return m_file.commit();
+  }
+
   // Make sure we get the first key if it was the only key given to us.
   if (!m_first_key.empty()) {
     s = apply_first();
@@ -302,7 +334,8 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
                            const std::string &indexname,
                            rocksdb::ColumnFamilyHandle *const cf,
                            const rocksdb::DBOptions &db_options,
-                           const bool tracing)
+                           const bool tracing, const uint writer_threads,
+                           const uint64_t max_pending_size)
     : m_db(db),
       m_cf(cf),
       m_db_options(db_options),
@@ -312,7 +345,11 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
       m_done(false),
       m_sst_file(nullptr),
       m_tracing(tracing),
-      m_print_client_error(true) {
+      m_print_client_error(true),
+      m_writer_threads(writer_threads),
+      m_max_pending_size(max_pending_size),
+      m_pending_size(0),
+      m_stop_writers(false) {
   m_prefix = db->GetName() + "/";
 
   std::string normalized_table;
@@ -346,6 +383,8 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
 Rdb_sst_info::~Rdb_sst_info() {
   DBUG_ASSERT(m_sst_file == nullptr);
 
+  stop_writers();
+
   for (const auto &sst_file : m_committed_files) {
     // In case something went wrong attempt to delete the temporary file.
     // If everything went fine that file will have been renamed and this
@@ -365,7 +404,7 @@ int Rdb_sst_info::open_new_sst_file() {
 
   // Create the new sst file object
   m_sst_file = new Rdb_sst_file_ordered(m_db, m_cf, m_db_options, name,
-                                        m_tracing, m_max_size);
+                                        m_tracing, m_writer_threads > 0);
 
   // Open the sst file
   const rocksdb::Status s = m_sst_file->open();
@@ -393,11 +432,103 @@ void Rdb_sst_info::commit_sst_file(Rdb_sst_file_ordered *sst_file) {
   delete sst_file;
 }
 
+/*
+  Hand a full file over to the writer threads, which replay its rows into
+  the SST file writer (building and compressing the blocks) and finish the
+  file while the loading thread fills the next one. Waits while the rows
+  already queued would take more than m_max_pending_size of memory, so that
+  a loader faster than the writers is held back.
+*/
+void Rdb_sst_info::queue_sst_file(Rdb_sst_file_ordered *sst_file,
+                                  uint64_t size) {
+  m_committed_files.push_back(sst_file->get_name());
+
+  std::unique_lock<std::mutex> lock(m_writer_mutex);
+  if (m_writers.empty()) {
+    for (uint i = 0; i < m_writer_threads; i++) {
+      m_writers.emplace_back(&Rdb_sst_info::run_writer, this);
+    }
+  }
+
+  m_pending_cond.wait(lock, [this, size]() {
+    return m_pending_size == 0 || m_pending_size + size <= m_max_pending_size;
+  });
+  m_queue.push(std::make_pair(sst_file, size));
+  m_pending_size += size;
+  m_queue_cond.notify_one();
+}
+
+// This function is run by the writer threads
+void Rdb_sst_info::run_writer() {
+  std::unique_lock<std::mutex> lock(m_writer_mutex);
+  for (;;) {
+    m_queue_cond.wait(lock,
+                      [this]() { return !m_queue.empty() || m_stop_writers; });
+    // Only stop once everything queued has been written
+    if (m_queue.empty()) {
+      break;
+    }
+
+    Rdb_sst_file_ordered *const sst_file = m_queue.front().first;
+    const uint64_t size = m_queue.front().second;
+    m_queue.pop();
+
+    // Release the lock - we don't want to hold it while committing the file
+    lock.unlock();
+    const rocksdb::Status s = sst_file->commit();
+    const std::string name = sst_file->get_name();
+    delete sst_file;
+    lock.lock();
+
+    if (!s.ok() && m_writer_status.ok()) {
+      // Error messages need the client connection, leave them to the
+      // loading thread
+      m_writer_status = s;
+      m_writer_error_file = name;
+      set_background_error(HA_ERR_ROCKSDB_BULK_LOAD);
+    }
+
+    m_pending_size -= size;
+    m_pending_cond.notify_all();
+  }
+}
+
+/* Wait for the writers to finish all queued files, and end them */
+void Rdb_sst_info::stop_writers() {
+  {
+    std::lock_guard<std::mutex> lock(m_writer_mutex);
+    m_stop_writers = true;
+  }
+  m_queue_cond.notify_all();
+
+  for (auto &writer : m_writers) {
+    writer.join();
+  }
+  m_writers.clear();
+  m_stop_writers = false;
+}
+
+/* Report the error of a writer to the client and return its code */
+int Rdb_sst_info::report_background_error() {
+  {
+    std::lock_guard<std::mutex> lock(m_writer_mutex);
+    if (!m_writer_status.ok()) {
+      set_error_msg(m_writer_error_file, m_writer_status);
+      m_writer_status = rocksdb::Status::OK();
+    }
+  }
+  return get_and_reset_background_error();
+}
+
 void Rdb_sst_info::close_curr_sst_file() {
   DBUG_ASSERT(m_sst_file != nullptr);
   DBUG_ASSERT(m_curr_size > 0);
 
-  commit_sst_file(m_sst_file);
+  if (m_writer_threads > 0) {
+    queue_sst_file(m_sst_file, m_curr_size);
+  } else {
+    commit_sst_file(m_sst_file);
+  }
 
   // Reset for next sst file
   m_sst_file = nullptr;
@@ -416,7 +547,7 @@ int Rdb_sst_info::put(const rocksdb::Slice &key, const rocksdb::Slice &value) {
     // While we are here, check to see if we have had any errors from the
     // background thread - we don't want to wait for the end to report them
     if (have_background_error()) {
-      return get_and_reset_background_error();
+      return report_background_error();
     }
   }
 
@@ -469,6 +600,9 @@ int Rdb_sst_info::finish(Rdb_sst_commit_info *commit_info,
     close_curr_sst_file();
   }
 
+  // Wait for the writers to finish the files they were handed
+  stop_writers();
+
   // This checks out the list of files so that the caller can collect/group
   // them and ingest them all in one go, and any racing calls to commit
   // won't see them at all
@@ -480,7 +614,7 @@ int Rdb_sst_info::finish(Rdb_sst_commit_info *commit_info,
 
   // Did we get any errors?
   if (have_background_error()) {
-    ret = get_and_reset_background_error();
+    ret = report_background_error();
   }
 
   m_print_client_error = true;
@@ -21,7 +21,6 @@
 #include <condition_variable>
 #include <mutex>
 #include <queue>
-#include <stack>
 #include <string>
 #include <thread>
 #include <utility>
@@ -71,25 +70,26 @@ class Rdb_sst_file_ordered {
 
   class Rdb_sst_stack {
    private:
-    char *m_buffer;
-    size_t m_buffer_size;
-    size_t m_offset;
-    std::stack<std::tuple<size_t, size_t, size_t>> m_stack;
+    std::string m_buffer;
+    std::vector<std::tuple<size_t, size_t, size_t>> m_stack;
 
    public:
-    explicit Rdb_sst_stack(size_t max_size)
-        : m_buffer(nullptr), m_buffer_size(max_size) {}
-    ~Rdb_sst_stack() { delete[] m_buffer; }
-
-    void reset() { m_offset = 0; }
+    void reset() {
+      m_buffer.clear();
+      m_stack.clear();
+    }
     bool empty() { return m_stack.empty(); }
     void push(const rocksdb::Slice &key, const rocksdb::Slice &value);
-    std::pair<rocksdb::Slice, rocksdb::Slice> top();
-    void pop() { m_stack.pop(); }
+    std::pair<rocksdb::Slice, rocksdb::Slice> top() { return at(size() - 1); }
+    /* Entry at position pos, counted from the first one pushed */
+    std::pair<rocksdb::Slice, rocksdb::Slice> at(size_t pos);
+    void pop() { m_stack.pop_back(); }
     size_t size() { return m_stack.size(); }
   };
 
   bool m_use_stack;
+  // All rows are kept in m_stack until commit(), see Rdb_sst_info::put()
+  const bool m_buffered;
   bool m_first;
   std::string m_first_key;
   std::string m_first_value;
@@ -97,13 +97,14 @@ class Rdb_sst_file_ordered {
   Rdb_sst_file m_file;
 
   rocksdb::Status apply_first();
+  rocksdb::Status put_buffered();
 
  public:
   Rdb_sst_file_ordered(rocksdb::DB *const db,
                        rocksdb::ColumnFamilyHandle *const cf,
                        const rocksdb::DBOptions &db_options,
                        const std::string &name, const bool tracing,
-                       size_t max_size);
+                       const bool buffered);
 
   inline rocksdb::Status open() { return m_file.open(); }
   rocksdb::Status put(const rocksdb::Slice &key, const rocksdb::Slice &value);
@@ -136,9 +137,30 @@ class Rdb_sst_info {
   const bool m_tracing;
   bool m_print_client_error;
 
+  // Writer threads that commit the full SST files, see put()
+  const uint m_writer_threads;
+  const uint64_t m_max_pending_size;
+  std::vector<std::thread> m_writers;
+  std::mutex m_writer_mutex;
+  // Signaled when a file is queued or the writers must stop
+  std::condition_variable m_queue_cond;
+  // Signaled when a writer finished a file
+  std::condition_variable m_pending_cond;
+  std::queue<std::pair<Rdb_sst_file_ordered *, uint64_t>> m_queue;
+  // Size of the rows in the files queued or being committed
+  uint64_t m_pending_size;
+  bool m_stop_writers;
+  // First failure of a writer, reported by the loading thread
+  std::string m_writer_error_file;
+  rocksdb::Status m_writer_status;
+
   int open_new_sst_file();
   void close_curr_sst_file();
   void commit_sst_file(Rdb_sst_file_ordered *sst_file);
+  void queue_sst_file(Rdb_sst_file_ordered *sst_file, uint64_t size);
+  void run_writer();
+  void stop_writers();
+  int report_background_error();
 
   void set_error_msg(const std::string &sst_file_name,
                      const rocksdb::Status &s);
@@ -147,7 +169,9 @@ class Rdb_sst_info {
   Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
                const std::string &indexname,
                rocksdb::ColumnFamilyHandle *const cf,
-               const rocksdb::DBOptions &db_options, const bool tracing);
+               const rocksdb::DBOptions &db_options, const bool tracing,
+               const uint writer_threads = 0,
+               const uint64_t max_pending_size = 0);
   ~Rdb_sst_info();
 
   /*
@@ -21,6 +21,7 @@
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 /* MySQL includes */
 #include "./my_global.h"
@@ -118,15 +119,60 @@ class Rdb_background_thread : public Rdb_thread {
  private:
   bool m_save_stats = false;
 
+  /* Work done by compactions, by index and by column family */
+  mysql_mutex_t m_compaction_stats_mutex;
+  std::map<GL_INDEX_ID, Rdb_index_compaction_stats> m_index_compaction_stats;
+  std::map<uint32_t, Rdb_cf_compaction_stats> m_cf_compaction_stats;
+
+  /*
+    Rows of an index the compaction filter had seen, and the expired ones,
+    when schedule_index_compactions() last decided about the index
+  */
+  struct Rdb_index_compaction_check {
+    ulonglong rows;
+    ulonglong rows_expired;
+  };
+  std::map<GL_INDEX_ID, Rdb_index_compaction_check> m_index_compaction_checks;
+
+  /*
+    Compactions of indexes requested from the manual compaction thread. The
+    request points to the bounds, which are kept here until it has ended.
+  */
+  struct Rdb_index_compaction {
+    int mc_id;
+    std::string start;
+    std::string limit;
+    rocksdb::Slice start_slice;
+    rocksdb::Slice limit_slice;
+  };
+  std::map<GL_INDEX_ID, Rdb_index_compaction> m_index_compactions;
+
   void reset() {
     mysql_mutex_assert_owner(&m_signal_mutex);
     m_killed = THD::NOT_KILLED;
     m_save_stats = false;
   }
 
+  void schedule_index_compactions();
+  void request_index_compaction(const GL_INDEX_ID &gl_index_id);
+
  public:
+  Rdb_background_thread() {
+    mysql_mutex_init(0, &m_compaction_stats_mutex, MY_MUTEX_INIT_FAST);
+  }
+
+  virtual ~Rdb_background_thread() override {
+    mysql_mutex_destroy(&m_compaction_stats_mutex);
+  }
+
   virtual void run() override;
 
+  void update_index_compaction_stats(const Rdb_index_compaction_stats &stats);
+  void update_cf_compaction_stats(const Rdb_cf_compaction_stats &stats);
+  std::vector<Rdb_index_compaction_stats> get_index_compaction_stats();
+  std::vector<Rdb_cf_compaction_stats> get_cf_compaction_stats();
+  void remove_index_compaction_stats(const GL_INDEX_ID &gl_index_id);
+
   void request_save_stats() {
     RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
 
@@ -214,7 +260,25 @@ class Rdb_manual_compaction_thread : public Rdb_thread {
 */
 
 struct Rdb_drop_index_thread : public Rdb_thread {
+  Rdb_drop_index_thread() {
+    mysql_mutex_init(0, &m_progress_mutex, MY_MUTEX_INIT_FAST);
+  }
+
+  virtual ~Rdb_drop_index_thread() override {
+    mysql_mutex_destroy(&m_progress_mutex);
+  }
+
   virtual void run() override;
+
+  Rdb_drop_index_progress get_progress(const GL_INDEX_ID &gl_index_id);
+
+ private:
+  rocksdb::Status delete_index_slices(const GL_INDEX_ID gl_index_id,
+                                      rocksdb::ColumnFamilyHandle *const cfh,
+                                      const rocksdb::Range &range);
+
+  mysql_mutex_t m_progress_mutex;
+  std::map<GL_INDEX_ID, Rdb_drop_index_progress> m_progress;
 };
 
 }  // namespace myrocks
@@ -0,0 +1,205 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_written_keys.h"
+
+/* C++ standard header files */
+#include <algorithm>
+
+/* RocksDB header files */
+#include "util/hash.h"
+
+namespace myrocks {
+
+namespace {
+
+/* About 1% false positives */
+const size_t BLOOM_BITS_PER_KEY = 10;
+const uint BLOOM_PROBES = 6;
+
+/* Bytes a key takes in the hash set, besides its own */
+const size_t RECENT_KEY_OVERHEAD = sizeof(std::string) + 2 * sizeof(void *);
+
+/*
+  Bit positions of a key are h, h + delta, h + 2 * delta, ..., as in the
+  RocksDB bloom filters.
+*/
+void rdb_bloom_add(std::vector<uint64_t> *const bloom,
+                   const rocksdb::Slice &key) {
+  const uint64_t bits = bloom->size() * 64;
+  uint32_t h = rocksdb::Hash(key.data(), key.size(), 0xbc9f1d34);
+  const uint32_t delta = (h >> 17) | (h << 15);
+  for (uint i = 0; i < BLOOM_PROBES; i++) {
+    const uint64_t bit = h % bits;
+    (*bloom)[bit / 64] |= uint64_t(1) << (bit % 64);
+    h += delta;
+  }
+}
+
+bool rdb_bloom_may_contain(const std::vector<uint64_t> &bloom,
+                           const rocksdb::Slice &key) {
+  const uint64_t bits = bloom.size() * 64;
+  uint32_t h = rocksdb::Hash(key.data(), key.size(), 0xbc9f1d34);
+  const uint32_t delta = (h >> 17) | (h << 15);
+  for (uint i = 0; i < BLOOM_PROBES; i++) {
+    const uint64_t bit = h % bits;
+    if ((bloom[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+      return false;
+    }
+    h += delta;
+  }
+  return true;
+}
+
+}  // namespace
+
+void Rdb_written_keys::Rdb_segment::build(
+    const std::vector<rocksdb::Slice> &keys) {
+  size_t bytes = 0;
+  for (const auto &key : keys) {
+    bytes += key.size();
+  }
+
+  m_arena.reserve(bytes);
+  m_offsets.reserve(keys.size() + 1);
+  for (const auto &key : keys) {
+    m_offsets.push_back(m_arena.size());
+    m_arena.append(key.data(), key.size());
+  }
+  m_offsets.push_back(m_arena.size());
+
+  m_bloom.assign((keys.size() * BLOOM_BITS_PER_KEY + 63) / 64, 0);
+  for (const auto &key : keys) {
+    rdb_bloom_add(&m_bloom, key);
+  }
+}
+
+bool Rdb_written_keys::Rdb_segment::contains(
+    const rocksdb::Slice &key) const {
+  if (!rdb_bloom_may_contain(m_bloom, key)) {
+    return false;
+  }
+
+  size_t lo = 0;
+  size_t hi = size();
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    const int cmp = this->key(mid).compare(key);
+    if (cmp == 0) {
+      return true;
+    }
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return false;
+}
+
+const std::string &Rdb_written_keys::make_key(
+    const uint32_t cf_id, const rocksdb::Slice &key) const {
+  m_lookup_key.clear();
+  m_lookup_key.push_back(static_cast<char>(cf_id >> 24));
+  m_lookup_key.push_back(static_cast<char>(cf_id >> 16));
+  m_lookup_key.push_back(static_cast<char>(cf_id >> 8));
+  m_lookup_key.push_back(static_cast<char>(cf_id));
+  m_lookup_key.append(key.data(), key.size());
+  return m_lookup_key;
+}
+
+void Rdb_written_keys::add(const uint32_t cf_id, const rocksdb::Slice &key) {
+  const std::string &lookup_key = make_key(cf_id, key);
+  if (m_recent.insert(lookup_key).second) {
+    m_memory_usage += lookup_key.size() + RECENT_KEY_OVERHEAD;
+    if (m_recent.size() >= SEGMENT_KEYS) {
+      spill();
+    }
+  }
+}
+
+bool Rdb_written_keys::may_contain(const uint32_t cf_id,
+                                   const rocksdb::Slice &key) const {
+  const std::string &lookup_key = make_key(cf_id, key);
+  if (m_recent.count(lookup_key) > 0) {
+    return true;
+  }
+  for (const auto &segment : m_segments) {
+    if (segment.contains(lookup_key)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+  Move the keys of the hash set into a new segment, then merge the last two
+  segments for as long as the last one is not smaller.
+*/
+void Rdb_written_keys::spill() {
+  std::vector<rocksdb::Slice> keys(m_recent.begin(), m_recent.end());
+  std::sort(keys.begin(), keys.end(),
+            [](const rocksdb::Slice &a, const rocksdb::Slice &b) {
+              return a.compare(b) < 0;
+            });
+  m_segments.emplace_back();
+  m_segments.back().build(keys);
+  m_recent.clear();
+
+  while (m_segments.size() >= 2 &&
+         m_segments.back().size() >= m_segments[m_segments.size() - 2].size()) {
+    const Rdb_segment &a = m_segments[m_segments.size() - 2];
+    const Rdb_segment &b = m_segments.back();
+    keys.clear();
+    keys.reserve(a.size() + b.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() || j < b.size()) {
+      const int cmp = i == a.size()   ? 1
+                      : j == b.size() ? -1
+                                      : a.key(i).compare(b.key(j));
+      if (cmp <= 0) {
+        keys.push_back(a.key(i++));
+        // A key written again after it was spilled is in both
+        j += cmp == 0;
+      } else {
+        keys.push_back(b.key(j++));
+      }
+    }
+
+    Rdb_segment merged;
+    merged.build(keys);
+    m_segments.pop_back();
+    m_segments.back() = std::move(merged);
+  }
+
+  size_t bytes = 0;
+  for (const auto &segment : m_segments) {
+    bytes += segment.m_arena.capacity() +
+             segment.m_offsets.capacity() * sizeof(size_t) +
+             segment.m_bloom.capacity() * sizeof(uint64_t);
+  }
+  m_memory_usage = bytes;
+}
+
+void Rdb_written_keys::clear() {
+  m_recent.clear();
+  m_segments.clear();
+  m_memory_usage = 0;
+}
+
+}  // namespace myrocks
@@ -0,0 +1,86 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* C++ standard header files */
+#include <atomic>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/* RocksDB header files */
+#include "rocksdb/slice.h"
+
+namespace myrocks {
+
+/*
+  The keys a transaction has written, so that it can read the keys it has
+  not written from the database directly, rather than through its
+  WriteBatchWithIndex, whose lookups get slower as the batch grows.
+
+  New keys go to a hash set. When that holds SEGMENT_KEYS keys, they are
+  spilled into a segment: the keys sorted and stored back to back in one
+  arena, with a bloom filter. A segment is merged with the one before it as
+  soon as it is as large, so there are O(log n) segments. A lookup checks
+  the hash set, then the bloom filter of each segment, and searches the
+  segment only when its filter passes.
+
+  Keys are never removed, not even when the transaction rolls back to a
+  savepoint, so may_contain() can answer yes for a key the batch does not
+  have, but never no for one it has.
+*/
+class Rdb_written_keys {
+ public:
+  /* Number of keys in the hash set before they are spilled */
+  static const size_t SEGMENT_KEYS = 4096;
+
+  void add(const uint32_t cf_id, const rocksdb::Slice &key);
+  bool may_contain(const uint32_t cf_id, const rocksdb::Slice &key) const;
+  void clear();
+
+  /* Approximate number of bytes used, may be called by any thread */
+  size_t memory_usage() const { return m_memory_usage; }
+
+ private:
+  struct Rdb_segment {
+    /* Keys in ascending order, back to back */
+    std::string m_arena;
+    /* Offset of every key in m_arena, and the end of the last one */
+    std::vector<size_t> m_offsets;
+    std::vector<uint64_t> m_bloom;
+
+    size_t size() const { return m_offsets.size() - 1; }
+    rocksdb::Slice key(const size_t i) const {
+      return rocksdb::Slice(m_arena.data() + m_offsets[i],
+                            m_offsets[i + 1] - m_offsets[i]);
+    }
+    void build(const std::vector<rocksdb::Slice> &keys);
+    bool contains(const rocksdb::Slice &key) const;
+  };
+
+  void spill();
+
+  /* Key of the column family cf_id, prefixed with the id, in m_lookup_key */
+  const std::string &make_key(const uint32_t cf_id,
+                              const rocksdb::Slice &key) const;
+
+  std::unordered_set<std::string> m_recent;
+  std::vector<Rdb_segment> m_segments;
+  mutable std::string m_lookup_key;
+  std::atomic<size_t> m_memory_usage{0};
+};
+
+}  // namespace myrocks
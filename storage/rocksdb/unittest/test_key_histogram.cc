@@ -0,0 +1,174 @@
+/*
+   Copyright (c) 2015, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* C++ standard header files */
+#include <cmath>
+#include <string>
+#include <vector>
+
+/* MySQL header files */
+#include <tap.h>
+
+/* MyRocks header files */
+#include "../ha_rocksdb.h"
+#include "../properties_collector.h"
+#include "../rdb_datadic.h"
+
+using myrocks::Rdb_index_stats;
+using myrocks::Rdb_key_histogram;
+
+/* Key number n of an index, as a 4 byte index number and a 4 byte value */
+static std::string make_key(const uint n) {
+  uchar buf[8];
+  myrocks::rdb_netbuf_store_index(buf, 256);
+  myrocks::rdb_netbuf_store_uint32(buf + 4, n);
+  return std::string(reinterpret_cast<const char *>(buf), sizeof(buf));
+}
+
+/*
+  Histogram of the keys first, first + step, ... below last, added in
+  descending order as in a reverse ordered column family if asked to
+*/
+static Rdb_key_histogram make_histogram(const uint first, const uint last,
+                                        const uint step,
+                                        const bool descending) {
+  std::vector<std::string> keys;
+  for (uint n = first; n < last; n += step) {
+    keys.push_back(make_key(n));
+  }
+
+  Rdb_key_histogram h;
+  if (descending) {
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+      h.add_key(*it);
+    }
+  } else {
+    for (const auto &key : keys) {
+      h.add_key(key);
+    }
+  }
+  h.finish();
+  return h;
+}
+
+/* Whether the estimated rows up to key n are within tolerance of expected */
+static bool rows_near(const Rdb_key_histogram &h, const uint n,
+                      const double expected, const double tolerance) {
+  return std::fabs(h.rows_upto(make_key(n)) - expected) <= tolerance;
+}
+
+static void test_add_finish() {
+  const Rdb_key_histogram h = make_histogram(0, 10000, 1, false);
+  ok(h.rows() == 10000, "rows of an ascending histogram");
+  ok(h.size() > 1 && h.size() <= Rdb_key_histogram::MAX_BUCKETS + 1,
+     "number of buckets");
+  ok(h.rows_upto(make_key(0)) == 1, "rows up to the first key");
+  ok(h.rows_upto(make_key(9999)) == 10000, "rows up to the last key");
+  ok(rows_near(h, 2500, 2501, 10000 / Rdb_key_histogram::MAX_BUCKETS),
+     "rows up to a quarter of the keys");
+  ok(rows_near(h, 5000, 5001, 10000 / Rdb_key_histogram::MAX_BUCKETS),
+     "rows up to half of the keys");
+
+  Rdb_key_histogram empty;
+  empty.finish();
+  ok(empty.empty() && empty.rows() == 0, "histogram without keys is empty");
+}
+
+/* Keys of a reverse ordered column family arrive in descending order */
+static void test_descending() {
+  const Rdb_key_histogram h = make_histogram(0, 10000, 1, true);
+  ok(h.rows() == 10000, "rows of a descending histogram");
+  ok(h.rows_upto(make_key(0)) == 1, "descending: rows up to the first key");
+  ok(rows_near(h, 5000, 5001, 10000 / Rdb_key_histogram::MAX_BUCKETS),
+     "descending: rows up to half of the keys");
+}
+
+static void test_rows_upto() {
+  const Rdb_key_histogram h = make_histogram(1000, 2000, 1, false);
+  ok(h.rows_upto(make_key(10)) == 0, "no rows below the first key");
+  ok(h.rows_upto(make_key(5000)) == 1000, "all rows below a key past the last");
+
+  /* Estimates never decrease as the key grows */
+  double prev = 0;
+  bool monotonic = true;
+  for (uint n = 900; n < 2100; n += 7) {
+    const double rows = h.rows_upto(make_key(n));
+    monotonic = monotonic && rows >= prev;
+    prev = rows;
+  }
+  ok(monotonic, "rows up to a key grow with the key");
+}
+
+static void test_merge() {
+  Rdb_key_histogram h = make_histogram(0, 10000, 2, false);
+  const Rdb_key_histogram odd = make_histogram(1, 10000, 2, false);
+  h.merge(odd, true);
+  ok(h.rows() == 10000, "rows after adding a histogram");
+  ok(rows_near(h, 5000, 5001, 10000 / Rdb_key_histogram::MAX_BUCKETS),
+     "rows up to half of the keys after adding");
+
+  h.merge(odd, false);
+  ok(std::llabs(h.rows() - 5000) <= 1, "rows after removing a histogram");
+
+  /* Skewed: most of the rows are in the first tenth of the key space */
+  Rdb_key_histogram skewed = make_histogram(0, 1000, 1, false);
+  skewed.merge(make_histogram(1000, 10000, 90, false), true);
+  ok(skewed.rows() == 1100, "rows of a skewed histogram");
+  ok(rows_near(skewed, 999, 1000, 1100 / Rdb_key_histogram::MAX_BUCKETS),
+     "rows up to the dense part of a skewed histogram");
+
+  Rdb_key_histogram empty;
+  empty.merge(skewed, true);
+  ok(empty.rows() == skewed.rows(), "adding to an empty histogram");
+}
+
+static void test_materialize() {
+  std::vector<Rdb_index_stats> stats(1);
+  stats[0].m_gl_index_id.cf_id = 1;
+  stats[0].m_gl_index_id.index_id = 256;
+  stats[0].m_distinct_keys_per_prefix.resize(1);
+
+  /* Without a histogram the stats keep the version before histograms */
+  std::string s = Rdb_index_stats::materialize(stats);
+  ok(myrocks::rdb_netbuf_to_uint16(reinterpret_cast<const uchar *>(s.data())) ==
+         Rdb_index_stats::INDEX_STATS_VERSION_ENTRY_TYPES,
+     "stats without histograms keep version 2");
+
+  stats[0].m_histogram = make_histogram(0, 1000, 1, false);
+  s = Rdb_index_stats::materialize(stats);
+  ok(myrocks::rdb_netbuf_to_uint16(reinterpret_cast<const uchar *>(s.data())) ==
+         Rdb_index_stats::INDEX_STATS_VERSION_HISTOGRAM,
+     "stats with histograms use version 3");
+
+  std::vector<Rdb_index_stats> read;
+  ok(Rdb_index_stats::unmaterialize(s, &read) == HA_EXIT_SUCCESS &&
+         read.size() == 1 && read[0].m_histogram.rows() == 1000 &&
+         read[0].m_histogram.size() == stats[0].m_histogram.size(),
+     "histogram read back");
+}
+
+int main(int argc MY_ATTRIBUTE((__unused__)),
+         char **argv MY_ATTRIBUTE((__unused__))) {
+  plan(22);
+
+  test_add_finish();
+  test_descending();
+  test_rows_upto();
+  test_merge();
+  test_materialize();
+
+  return exit_status();
+}
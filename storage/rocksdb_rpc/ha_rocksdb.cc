@@ -81,6 +81,8 @@
 #include "./rdb_index_merge.h"
 #include "./rdb_mutex_wrapper.h"
 #include "./rdb_psi.h"
+#include "./rdb_rpc_call_stats.h"
+#include "./rdb_rpc_row_cache.h"
 #include "./rdb_threads.h"
 
 // Internal MySQL APIs not exposed in any header.
@@ -293,6 +295,13 @@ static Rdb_index_stats_thread rdb_is_thread;
 static Rdb_manual_compaction_thread rdb_mc_thread;
 
 static Rdb_drop_index_thread rdb_drop_idx_thread;
+
+/* Rows read from the RocksDB RPC server, see Rdb_rpc_row_cache */
+static Rdb_rpc_row_cache rpc_row_cache;
+
+/* RPC calls made by all sessions, see Rdb_rpc_stats_observer */
+static Rdb_rpc_global_call_stats rpc_call_stats;
+
 // List of table names (using regex) that are exceptions to the strict
 // collation check requirement.
 Regex_list_handler *rdb_collation_exceptions;
@@ -544,7 +553,7 @@ static int rocksdb_force_flush_memtable_and_lzero_now(
           // ALTER
           sql_print_information(
               "cf %s has been dropped during CompactFiles.",
-              rocksdb_ColumnFamilyHandle__GetName(cfh).c_str());
+              rdb_cf_name(cfh).c_str());
           break;
         }
 
@@ -660,6 +669,10 @@ static void rocksdb_set_max_latest_deadlocks(THD *thd,
                                              struct st_mysql_sys_var *var,
                                              void *var_ptr, const void *save);
 
+static void rocksdb_set_rpc_row_cache_size(THD *thd,
+                                           struct st_mysql_sys_var *var,
+                                           void *var_ptr, const void *save);
+
 static void rdb_set_collation_exception_list(const char *exception_list);
 static void rocksdb_set_collation_exception_list(THD *thd,
                                                  struct st_mysql_sys_var *var,
@@ -810,6 +823,9 @@ static my_bool rocksdb_select_bypass_fail_unsupported = TRUE;
 static my_bool rocksdb_select_bypass_log_rejected = TRUE;
 static my_bool rocksdb_select_bypass_log_failed = FALSE;
 static my_bool rocksdb_select_bypass_allow_filters = TRUE;
+static unsigned long long  // NOLINT(runtime/int)
+    rocksdb_rpc_row_cache_size = 0;
+static my_bool rocksdb_rpc_call_stats = TRUE;
 static uint32_t rocksdb_select_bypass_rejected_query_history_size = 0;
 static uint32_t rocksdb_select_bypass_debug_row_delay = 0;
 static unsigned long long  // NOLINT(runtime/int)
@@ -920,8 +936,7 @@ static int rocksdb_tracing(THD *const thd MY_ATTRIBUTE((__unused__)),
 
   // ALTER
   // s = rdb->GetEnv()->CreateDirIfMissing(trace_dir);
-  s = rocksdb_Env__CreateDirIfMissing(rocksdb_TransactionDB__GetEnv(rdb),
-                                      trace_dir);
+  s = rocksdb_Env__CreateDirIfMissing(rdb_get_env(rdb), trace_dir);
 
   if (!s.ok()) {
     // NO_LINT_DEBUG
@@ -935,8 +950,7 @@ static int rocksdb_tracing(THD *const thd MY_ATTRIBUTE((__unused__)),
 
   // ALTER
   // s = rdb->GetEnv()->FileExists(trace_file_path);
-  s = rocksdb_Env__FileExists(rocksdb_TransactionDB__GetEnv(rdb),
-                              trace_file_path);
+  s = rocksdb_Env__FileExists(rdb_get_env(rdb), trace_file_path);
 
   if (s.ok() || !s.IsNotFound()) {
     // NO_LINT_DEBUG
@@ -962,8 +976,8 @@ static int rocksdb_tracing(THD *const thd MY_ATTRIBUTE((__unused__)),
   // ALTER
   // s = rocksdb::NewFileTraceWriter(rdb->GetEnv(), env_option, trace_file_path,
   //                                 &trace_writer);
-  s = rocksdb_NewFileTraceWriter(rocksdb_TransactionDB__GetEnv(rdb), env_option,
-                                 trace_file_path, trace_writer_idx);
+  s = rocksdb_NewFileTraceWriter(rdb_get_env(rdb), env_option, trace_file_path,
+                                 trace_writer_idx);
 
   if (!s.ok()) {
     rc = ha_rocksdb::rdb_error_to_mysql(s);
@@ -1198,8 +1212,7 @@ static int rocksdb_validate_flush_log_at_trx_commit(
   // {
   //   return HA_EXIT_FAILURE;
   // }
-  if (rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "allow_mmap_writes") &&
+  if (rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_writes") &&
       new_value != FLUSH_LOG_NEVER) {
     return HA_EXIT_FAILURE;
   }
@@ -1336,6 +1349,12 @@ static MYSQL_THDVAR_BOOL(
     "Enable rocksdb iterator upper/lower bounds in read options.", nullptr,
     nullptr, TRUE);
 
+static MYSQL_THDVAR_BOOL(
+    rpc_scan_key_filter, PLUGIN_VAR_OPCMDARG,
+    "Skip scanned rows whose key fails simple key conditions without "
+    "fetching their values from the RPC server.",
+    nullptr, nullptr, TRUE);
+
 static const char *DEFAULT_READ_FREE_RPL_TABLES = ".*";
 
 rpc_logger l_6(1341, "init SYSVAR");
@@ -1410,9 +1429,9 @@ static void rocksdb_set_max_bottom_pri_background_compactions_internal(
     // ALTER
     // rdb->GetEnv()->SetBackgroundThreads(val, rocksdb::Env::Priority::BOTTOM);
     // rdb->GetEnv()->LowerThreadPoolCPUPriority(rocksdb::Env::Priority::BOTTOM);
-    rocksdb_Env__SetBackgroundThreads(rocksdb_TransactionDB__GetEnv(rdb), val,
+    rocksdb_Env__SetBackgroundThreads(rdb_get_env(rdb), val,
                                       rocksdb::Env::Priority::BOTTOM);
-    rocksdb_Env__LowerThreadPoolCPUPriority(rocksdb_TransactionDB__GetEnv(rdb),
+    rocksdb_Env__LowerThreadPoolCPUPriority(rdb_get_env(rdb),
                                             rocksdb::Env::Priority::BOTTOM);
 
     sql_print_information(
@@ -2482,6 +2501,22 @@ static MYSQL_SYSVAR_STR(datadir, rocksdb_datadir,
 
 rpc_logger l_13(2489, "init datadir");
 
+static MYSQL_SYSVAR_ULONGLONG(
+    rpc_row_cache_size, rocksdb_rpc_row_cache_size, PLUGIN_VAR_RQCMDARG,
+    "Size in bytes of the local cache of rows read with point lookups from "
+    "the RocksDB RPC server. Cached rows are dropped when this server "
+    "commits a change to them, so the cache must not be used if other "
+    "servers write to the same database. 0 disables the cache.",
+    nullptr, rocksdb_set_rpc_row_cache_size, /* default */ 0, /* min */ 0,
+    /* max */ SIZE_T_MAX, 0);
+
+static MYSQL_SYSVAR_BOOL(
+    rpc_call_stats, rocksdb_rpc_call_stats, PLUGIN_VAR_RQCMDARG,
+    "Collect call counts and latencies of RPCs to the RocksDB RPC server, "
+    "per call site and method, globally and for every session. See "
+    "information_schema.rocksdb_rpc_call_stats.",
+    nullptr, nullptr, TRUE);
+
 static MYSQL_SYSVAR_UINT(
     table_stats_sampling_pct, rocksdb_table_stats_sampling_pct,
     PLUGIN_VAR_RQCMDARG,
@@ -2692,7 +2727,9 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(bulk_load_allow_unsorted),
     MYSQL_SYSVAR(skip_unique_check_tables), MYSQL_SYSVAR(trace_sst_api),
     MYSQL_SYSVAR(commit_in_the_middle), MYSQL_SYSVAR(blind_delete_primary_key),
-    MYSQL_SYSVAR(enable_iterate_bounds), MYSQL_SYSVAR(read_free_rpl_tables),
+    MYSQL_SYSVAR(enable_iterate_bounds), MYSQL_SYSVAR(rpc_scan_key_filter),
+    MYSQL_SYSVAR(rpc_row_cache_size), MYSQL_SYSVAR(rpc_call_stats),
+    MYSQL_SYSVAR(read_free_rpl_tables),
     MYSQL_SYSVAR(read_free_rpl), MYSQL_SYSVAR(bulk_load_size),
     MYSQL_SYSVAR(merge_buf_size), MYSQL_SYSVAR(enable_bulk_load_api),
     // MYSQL_SYSVAR(enable_pipelined_write),
@@ -3049,6 +3086,25 @@ class Rdb_snapshot_notifier : public rocksdb::TransactionNotifier {
 class Rdb_transaction {
  protected:
   ulonglong m_write_count = 0;
+  /*
+    Bumped on every change to the transaction's own writes, including
+    statement rollback. Rdb_rpc_iterator compares it with the value seen
+    when it read its current row to tell whether the row may be outdated.
+  */
+  ulonglong m_write_generation = 0;
+  /*
+    Keys written by the transaction, as Rdb_rpc_row_cache keys, to drop from
+    the row cache on commit. If there are too many of them, or a write was
+    made while the cache was off, the whole cache is invalidated instead.
+  */
+  std::vector<std::string> m_row_cache_writes;
+  bool m_row_cache_writes_overflow = false;
+  /* Row cache epoch taken before the read snapshot was requested */
+  uint64_t m_row_cache_epoch = 0;
+  /* Sequence number of the read snapshot, 0 until it has been fetched */
+  mutable uint64_t m_row_cache_seq = 0;
+  /* RPCs made by the session, see Rdb_rpc_stats_observer */
+  Rdb_rpc_call_stats m_rpc_call_stats;
   ulonglong m_insert_count = 0;
   ulonglong m_update_count = 0;
   ulonglong m_delete_count = 0;
@@ -3130,6 +3186,12 @@ class Rdb_transaction {
 
  public:
   rocksdb::ReadOptions *m_read_opts;
+  /*
+    Local copy of the snapshot set in m_read_opts, so that checking for a
+    snapshot does not need a round trip. Only changed through
+    set_read_snapshot() and reset_read_opts().
+  */
+  const rocksdb::Snapshot *m_read_snapshot = nullptr;
   const char *m_mysql_log_file_name;
   my_off_t m_mysql_log_offset;
   const char *m_mysql_gtid;
@@ -3241,6 +3303,15 @@ class Rdb_transaction {
     return m_thd;
   }
 
+  /*
+    Not virtual: RPCs made by the destructors of the derived classes are
+    still recorded here.
+  */
+  Rdb_rpc_call_stats *get_rpc_call_stats() { return &m_rpc_call_stats; }
+  const Rdb_rpc_call_stats *get_rpc_call_stats() const {
+    return &m_rpc_call_stats;
+  }
+
   /* Used for tracking io_perf counters */
   void io_perf_start(Rdb_io_perf *const io_perf) {
     /*
@@ -3377,21 +3448,42 @@ class Rdb_transaction {
 
   virtual void rollback() = 0;
 
+  const rocksdb::Snapshot *get_read_snapshot() const {
+    return m_read_snapshot;
+  }
+
+  void set_read_snapshot(const rocksdb::Snapshot *const snapshot) {
+    rocksdb_rpc_log(3386,
+                    "set_read_snapshot: rocksdb_ReadOptions__SetSnapshot");
+    // ALTER
+    // m_read_opts.snapshot = snapshot;
+    rocksdb_ReadOptions__SetSnapshot(m_read_opts, snapshot);
+    m_read_snapshot = snapshot;
+    m_row_cache_seq = 0;
+  }
+
+  void reset_read_opts() {
+    // ALTER
+    // m_read_opts = rocksdb::ReadOptions();
+    m_read_opts = rocksdb_ReadOptions__NewReadOptions();
+    m_read_snapshot = nullptr;
+    m_row_cache_seq = 0;
+  }
+
   // ALTER
   void snapshot_created(const rocksdb::Snapshot *snapshot) {
     rocksdb_rpc_log(3382, "snapshot_created: start");
     DBUG_ASSERT(snapshot != nullptr);
 
-    rocksdb_rpc_log(3385, "snapshot_created: rocksdb_ReadOptions__SetSnapshot");
+    rocksdb_rpc_log(3385, "snapshot_created: set_read_snapshot");
     // ALTER
     // m_read_opts.snapshot = snapshot;
-    rocksdb_ReadOptions__SetSnapshot(m_read_opts, snapshot);
+    set_read_snapshot(snapshot);
 
     rocksdb_rpc_log(3393, "snapshot_created: rocksdb_Env__GetCurrentTime");
     // ALTER
     // rdb->GetEnv()->GetCurrentTime(&m_snapshot_timestamp);
-    rocksdb_Env__GetCurrentTime(rocksdb_TransactionDB__GetEnv(rdb),
-                                &m_snapshot_timestamp);
+    rocksdb_Env__GetCurrentTime(rdb_get_env(rdb), &m_snapshot_timestamp);
     m_is_delayed_snapshot = false;
     rocksdb_rpc_log(3396, "snapshot_created: start");
   }
@@ -3402,8 +3494,8 @@ class Rdb_transaction {
   bool has_snapshot() const {
     // ALTER
     // return m_read_opts.snapshot != nullptr;
-    rocksdb_rpc_log(3406, "has_snapshot: rocksdb_ReadOptions__GetSnapshot");
-    return rocksdb_ReadOptions__GetSnapshot(m_read_opts) != nullptr;
+    rocksdb_rpc_log(3406, "has_snapshot: get_read_snapshot");
+    return get_read_snapshot() != nullptr;
   }
 
  private:
@@ -3626,8 +3718,10 @@ class Rdb_transaction {
     // const rocksdb::Status s = rdb->IngestExternalFiles(args);
     rocksdb_rpc_log(
         3627, "finish_bulk_load: rocksdb_TransactionDB__IngestExternalFiles");
+    rpc_row_cache.invalidate_begin({}, true);
     const rocksdb::Status s =
         rocksdb_TransactionDB__IngestExternalFiles(rdb, args);
+    rpc_row_cache.invalidate_end({}, true);
 
     if (THDVAR(m_thd, trace_sst_api)) {
       // NO_LINT_DEBUG
@@ -3767,11 +3861,130 @@ class Rdb_transaction {
   virtual bool has_modifications() const = 0;
 
   virtual rocksdb::WriteBatchBase *get_indexed_write_batch() = 0;
+
+  /*
+    Write to the indexed write batch. The writes will skip any transaction
+    locking. The writes WILL be visible to the transaction.
+  */
+  rocksdb::Status indexed_put(
+      rocksdb::ColumnFamilyHandle *const column_family,
+      const rocksdb::Slice &key, const rocksdb::Slice &value) {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
+    rocksdb_rpc_log(3777, "indexed_put: rocksdb_WriteBatchBase__Put");
+    row_cache_track_write(column_family, key);
+    const Rdb_rpc_call_timer rpc_timer("WriteBatchBase::Put");
+    return rpc_timer.result(rocksdb_WriteBatchBase__Put(
+        get_indexed_write_batch(), column_family, key, value));
+  }
+
+  rocksdb::Status indexed_single_delete(
+      rocksdb::ColumnFamilyHandle *const column_family,
+      const rocksdb::Slice &key) {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
+    rocksdb_rpc_log(3786,
+                    "indexed_single_delete: "
+                    "rocksdb_WriteBatchBase__SingleDelete");
+    row_cache_track_write(column_family, key);
+    const Rdb_rpc_call_timer rpc_timer("WriteBatchBase::SingleDelete");
+    return rpc_timer.result(rocksdb_WriteBatchBase__SingleDelete(
+        get_indexed_write_batch(), column_family, key));
+  }
+
+ protected:
+  static constexpr size_t RDB_ROW_CACHE_MAX_TRACKED_WRITES = 10000;
+
+  void row_cache_track_write(rocksdb::ColumnFamilyHandle *const column_family,
+                             const rocksdb::Slice &key) {
+    if (m_row_cache_writes_overflow) {
+      return;
+    }
+    if (!rpc_row_cache.enabled() ||
+        m_row_cache_writes.size() >= RDB_ROW_CACHE_MAX_TRACKED_WRITES) {
+      m_row_cache_writes_overflow = true;
+      m_row_cache_writes.clear();
+      return;
+    }
+    m_row_cache_writes.push_back(
+        Rdb_rpc_row_cache::make_key(rdb_cf_id(column_family), key));
+  }
+
+  bool row_cache_has_writes() const {
+    return m_row_cache_writes_overflow || !m_row_cache_writes.empty();
+  }
+
+  /* Bracket the remote commit of the tracked writes */
+  void row_cache_invalidate_begin() {
+    if (row_cache_has_writes()) {
+      rpc_row_cache.invalidate_begin(m_row_cache_writes,
+                                     m_row_cache_writes_overflow);
+    }
+  }
+
+  void row_cache_invalidate_end() {
+    if (row_cache_has_writes()) {
+      rpc_row_cache.invalidate_end(m_row_cache_writes,
+                                   m_row_cache_writes_overflow);
+    }
+    row_cache_reset_writes();
+  }
+
+  void row_cache_reset_writes() {
+    m_row_cache_writes.clear();
+    m_row_cache_writes_overflow = false;
+  }
+
+  /*
+    Serve a point lookup from the row cache. The cache only serves
+    transactions that read from a snapshot and have not written anything
+    yet, as it does not know about a transaction's own writes. On a miss,
+    *cache_key is set if the row read from the server may be cached, see
+    row_cache_fill().
+  */
+  bool row_cache_get(rocksdb::ColumnFamilyHandle *const column_family,
+                     const rocksdb::Slice &key, rocksdb::PinnableSlice *value,
+                     std::string *const cache_key) const {
+    if (!rpc_row_cache.enabled() || m_write_count > 0 ||
+        get_read_snapshot() == nullptr) {
+      return false;
+    }
+    *cache_key = Rdb_rpc_row_cache::make_key(rdb_cf_id(column_family), key);
+    std::string cached_value;
+    if (!rpc_row_cache.lookup(*cache_key, row_cache_snapshot_seq(),
+                              &cached_value)) {
+      return false;
+    }
+    rocksdb_PinnableSlice__PinSelf(value, cached_value);
+    return true;
+  }
+
+  void row_cache_fill(const std::string &cache_key, const rocksdb::Status &s,
+                      rocksdb::PinnableSlice *value) const {
+    if (s.ok() && !cache_key.empty()) {
+      rpc_row_cache.insert(cache_key, rocksdb_PinnableSlice__Slice(value),
+                           row_cache_snapshot_seq(), m_row_cache_epoch);
+    }
+  }
+
+  uint64_t row_cache_snapshot_seq() const {
+    if (m_row_cache_seq == 0) {
+      rocksdb_rpc_log(3790,
+                      "row_cache_snapshot_seq: "
+                      "rocksdb_Snapshot__GetSequenceNumber");
+      m_row_cache_seq =
+          rocksdb_Snapshot__GetSequenceNumber(get_read_snapshot());
+    }
+    return m_row_cache_seq;
+  }
+
+ public:
   /*
     Return a WriteBatch that one can write to. The writes will skip any
     transaction locking. The writes will NOT be visible to the transaction.
   */
   rocksdb::WriteBatchBase *get_blind_write_batch() {
+    /* The keys are not known here, drop the whole row cache on commit */
+    m_row_cache_writes_overflow = true;
+    m_row_cache_writes.clear();
     // ALTER
     rocksdb_rpc_log(
         3775, "get_blind_write_batch: rocksdb_WriteBatchBase__GetWriteBatch");
@@ -3799,7 +4012,7 @@ class Rdb_transaction {
                          rocksdb::Status *statuses,
                          const bool sorted_input) const = 0;
 
-  rocksdb::Iterator *get_iterator(
+  Rdb_rpc_iterator *get_iterator(
       rocksdb::ColumnFamilyHandle *const column_family, bool skip_bloom_filter,
       bool fill_cache, const rocksdb::Slice &eq_cond_lower_bound,
       const rocksdb::Slice &eq_cond_upper_bound, bool read_current = false,
@@ -3848,7 +4061,8 @@ class Rdb_transaction {
         eq_cond_lower_bound, eq_cond_upper_bound, read_current, create_snapshot,
         enable_iterate_bounds);
     rocksdb_rpc_log(3848, "get_iterator: end");
-    return get_iterator(options, column_family);
+    return new Rdb_rpc_iterator(get_iterator(options, column_family),
+                                &m_write_generation);
   }
 
   virtual bool is_tx_started() const = 0;
@@ -3928,6 +4142,7 @@ class Rdb_transaction {
       */
       do_set_savepoint();
       m_write_count = m_writes_at_last_savepoint;
+      ++m_write_generation;
     }
     rocksdb_rpc_log(3930, "rollback_to_stmt_savepoint: end");
   }
@@ -4103,6 +4318,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
   }
 
   bool prepare() override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::COMMIT);
     rocksdb_rpc_log(4106, "prepare: start");
     rocksdb::Status s;
 
@@ -4129,7 +4345,10 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
     // ALTER
     // s = m_rocksdb_tx->Prepare();
-    s = rocksdb_Transaction__Prepare(m_rocksdb_tx);
+    {
+      const Rdb_rpc_call_timer rpc_timer("Transaction::Prepare");
+      s = rpc_timer.result(rocksdb_Transaction__Prepare(m_rocksdb_tx));
+    }
 
     if (!s.ok()) {
       std::string msg = "RocksDB error on COMMIT (Prepare): " + s.ToString();
@@ -4142,6 +4361,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
   }
 
   bool commit_no_binlog() override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::COMMIT);
     rocksdb_rpc_log(4145, "commit_no_binlog: start");
     bool res = false;
     rocksdb::Status s;
@@ -4164,7 +4384,12 @@ class Rdb_transaction_impl : public Rdb_transaction {
     rocksdb_rpc_log(4164, "commit_no_binlog: rocksdb_Transaction__Commit");
     // ALTER
     // s = m_rocksdb_tx->Commit();
-    s = rocksdb_Transaction__Commit(m_rocksdb_tx);
+    row_cache_invalidate_begin();
+    {
+      const Rdb_rpc_call_timer rpc_timer("Transaction::Commit");
+      s = rpc_timer.result(rocksdb_Transaction__Commit(m_rocksdb_tx));
+    }
+    row_cache_invalidate_end();
 
 #ifndef DBUG_OFF
     DBUG_EXECUTE_IF("myrocks_commit_io_error",
@@ -4181,6 +4406,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
     on_commit();
   error:
     on_rollback();
+    row_cache_reset_writes();
     /* Save the transaction object to be reused */
     release_tx();
 
@@ -4196,8 +4422,10 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
  public:
   void rollback() override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::COMMIT);
     rocksdb_rpc_log(4199, "rollback: start");
     on_rollback();
+    row_cache_reset_writes();
     m_write_count = 0;
     m_insert_count = 0;
     m_update_count = 0;
@@ -4212,7 +4440,10 @@ class Rdb_transaction_impl : public Rdb_transaction {
       // ALTER
       // m_rocksdb_tx->Rollback();
       rocksdb_rpc_log(4214, "rollback: rocksdb_Transaction__Rollback");
-      rocksdb_Transaction__Rollback(m_rocksdb_tx);
+      {
+        const Rdb_rpc_call_timer rpc_timer("Transaction::Rollback");
+        rocksdb_Transaction__Rollback(m_rocksdb_tx);
+      }
 
       /* Save the transaction object to be reused */
       release_tx();
@@ -4227,13 +4458,19 @@ class Rdb_transaction_impl : public Rdb_transaction {
     rocksdb_rpc_log(4227, "acquire_snapshot: start");
     // ALTER
     // if (m_read_opts.snapshot == nullptr) {
-    rocksdb_rpc_log(4231, "acquire_snapshot: rocksdb_ReadOptions__GetSnapshot");
-    if (rocksdb_ReadOptions__GetSnapshot(m_read_opts) == nullptr) {
+    rocksdb_rpc_log(4231, "acquire_snapshot: get_read_snapshot");
+    if (get_read_snapshot() == nullptr) {
       const auto thd_ss = std::static_pointer_cast<Rdb_explicit_snapshot>(
           m_thd->get_explicit_snapshot());
       if (thd_ss) {
         m_explicit_snapshot = thd_ss;
       }
+      /*
+        Explicit snapshots may be older than any row cache invalidation, so
+        reads under them never fill the cache.
+      */
+      m_row_cache_epoch =
+          m_explicit_snapshot ? 0 : rpc_row_cache.current_epoch();
       if (m_explicit_snapshot) {
         // ALTER
         // auto snapshot = m_explicit_snapshot->get_snapshot()->snapshot();
@@ -4274,7 +4511,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
     // ALTER
     // if (m_read_opts.snapshot != nullptr) {
-    if (rocksdb_ReadOptions__GetSnapshot(m_read_opts) != nullptr) {
+    if (get_read_snapshot() != nullptr) {
       m_snapshot_timestamp = 0;
       if (m_explicit_snapshot) {
         m_explicit_snapshot.reset();
@@ -4282,15 +4519,14 @@ class Rdb_transaction_impl : public Rdb_transaction {
       } else if (is_tx_read_only()) {
         // ALTER
         // rdb->ReleaseSnapshot(m_read_opts.snapshot);
-        rocksdb_TransactionDB__ReleaseSnapshot(
-            rdb, rocksdb_ReadOptions__GetSnapshot(m_read_opts));
+        rocksdb_TransactionDB__ReleaseSnapshot(rdb, get_read_snapshot());
         need_clear = false;
       } else {
         need_clear = true;
       }
       // ALTER
       // m_read_opts.snapshot = nullptr;
-      rocksdb_ReadOptions__SetSnapshot(m_read_opts, nullptr);
+      set_read_snapshot(nullptr);
     }
 
     if (need_clear && m_rocksdb_tx != nullptr) {
@@ -4305,47 +4541,59 @@ class Rdb_transaction_impl : public Rdb_transaction {
     rocksdb_rpc_log(4303, "has_snapshot: start");
     // ALTER
     // return m_read_opts.snapshot != nullptr;
-    rocksdb_rpc_log(4307, "has_snapshot: rocksdb_ReadOptions__GetSnapshot");
-    return rocksdb_ReadOptions__GetSnapshot(m_read_opts) != nullptr;
+    rocksdb_rpc_log(4307, "has_snapshot: get_read_snapshot");
+    return get_read_snapshot() != nullptr;
   }
 
   rocksdb::Status put(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key, const rocksdb::Slice &value,
                       const bool assume_tracked) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4315, "put: start");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
 
     // ALTER
     // return m_rocksdb_tx->Put(column_family, key, value, assume_tracked);
     rocksdb_rpc_log(4320, "put: rocksdb_Transaction__Put");
-    return rocksdb_Transaction__Put(m_rocksdb_tx, column_family, key, value,
-                                    assume_tracked);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::Put");
+    return rpc_timer.result(rocksdb_Transaction__Put(
+        m_rocksdb_tx, column_family, key, value, assume_tracked));
   }
 
   rocksdb::Status delete_key(rocksdb::ColumnFamilyHandle *const column_family,
                              const rocksdb::Slice &key,
                              const bool assume_tracked) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4328, "delete_key: start");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
 
     // ALTER
     // return m_rocksdb_tx->Delete(column_family, key, assume_tracked);
     rocksdb_rpc_log(4333, "delete_key: rocksdb_Transaction__Delete");
-    return rocksdb_Transaction__Delete(m_rocksdb_tx, column_family, key,
-                                       assume_tracked);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::Delete");
+    return rpc_timer.result(rocksdb_Transaction__Delete(
+        m_rocksdb_tx, column_family, key, assume_tracked));
   }
 
   rocksdb::Status single_delete(
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, const bool assume_tracked) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4341, "single_delete: begin");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
 
     rocksdb_rpc_log(4347, "single_delete: rocksdb_Transaction__SingleDelete");
     // ALTER
     // return m_rocksdb_tx->SingleDelete(column_family, key, assume_tracked);
-    return rocksdb_Transaction__SingleDelete(m_rocksdb_tx, column_family, key,
-                                             assume_tracked);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::SingleDelete");
+    return rpc_timer.result(rocksdb_Transaction__SingleDelete(
+        m_rocksdb_tx, column_family, key, assume_tracked));
   }
 
   bool has_modifications() const override {
@@ -4385,6 +4633,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
   rocksdb::WriteBatchBase *get_indexed_write_batch() override {
     rocksdb_rpc_log(4386, "get_indexed_write_batch: start");
     ++m_write_count;
+    ++m_write_generation;
     // ALTER
     // return m_rocksdb_tx->GetWriteBatch();
     return rocksdb_Transaction__GetWriteBatch(m_rocksdb_tx);
@@ -4394,6 +4643,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
   rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key,
                       rocksdb::PinnableSlice *&value) const override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     rocksdb_rpc_log(4386, "get: start");
     // clean PinnableSlice right begfore Get() for multiple gets per statement
     // the resources after the last Get in a statement are cleared in
@@ -4405,22 +4655,32 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
     global_stats.queries[QUERIES_POINT].inc();
 
+    std::string cache_key;
+    if (row_cache_get(column_family, key, value, &cache_key)) {
+      return rocksdb::Status::OK();
+    }
+
     // ALTER
     // return m_rocksdb_tx->Get(m_read_opts, column_family, key, value);
     rocksdb_rpc_log(4410, "get: rocksdb_Transaction__Get");
-    return rocksdb_Transaction__Get(m_rocksdb_tx, m_read_opts, column_family,
-                                    key, value);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::Get");
+    const rocksdb::Status s = rpc_timer.result(rocksdb_Transaction__Get(
+        m_rocksdb_tx, m_read_opts, column_family, key, value));
+    row_cache_fill(cache_key, s, value);
+    return s;
   }
 
   void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
                  const size_t num_keys, const rocksdb::Slice *keys,
                  rocksdb::PinnableSlice **values, rocksdb::Status *statuses,
                  const bool sorted_input) const override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     rocksdb_rpc_log(4424, "get: begin");
     // ALTER
     // m_rocksdb_tx->MultiGet(m_read_opts, column_family, num_keys, keys,
     // values,
     //                        statuses, sorted_input);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::MultiGet");
     rocksdb_Transaction__MultiGet(m_rocksdb_tx, m_read_opts, column_family,
                                   num_keys, keys, values, statuses,
                                   sorted_input);
@@ -4430,6 +4690,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
                                  const rocksdb::Slice &key,
                                  rocksdb::PinnableSlice *&value, bool exclusive,
                                  const bool do_validate) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     rocksdb_rpc_log(4434, "get_for_update: begin");
     rocksdb::ColumnFamilyHandle *const column_family = key_descr.get_cf();
     /* check row lock limit in a trx */
@@ -4448,16 +4709,17 @@ class Rdb_transaction_impl : public Rdb_transaction {
     // initialized there. Snapshot validation is skipped in that case.
 
     // if (m_read_opts.snapshot == nullptr || do_validate) {
-    if (rocksdb_ReadOptions__GetSnapshot(m_read_opts) || do_validate) {
+    if (get_read_snapshot() == nullptr || do_validate) {
       // ALTER
       // s = m_rocksdb_tx->GetForUpdate(
       //     m_read_opts, column_family, key, value, exclusive,
       //     m_read_opts.snapshot ? do_validate : false);
       rocksdb_rpc_log(4457,
                       "get_for_update: rocksdb_Transaction__GetForUpdate");
-      s = rocksdb_Transaction__GetForUpdate(
+      const Rdb_rpc_call_timer rpc_timer("Transaction::GetForUpdate");
+      s = rpc_timer.result(rocksdb_Transaction__GetForUpdate(
           m_rocksdb_tx, m_read_opts, column_family, key, value, exclusive,
-          rocksdb_ReadOptions__GetSnapshot(m_read_opts) ? do_validate : false);
+          get_read_snapshot() ? do_validate : false));
     } else {
       // If snapshot is set, and if skipping validation,
       // call GetForUpdate without validation and set back old snapshot
@@ -4465,23 +4727,25 @@ class Rdb_transaction_impl : public Rdb_transaction {
       // ALTER
       // auto saved_snapshot = m_read_opts.snapshot;
       // m_read_opts.snapshot = nullptr;
-      auto saved_snapshot = rocksdb_ReadOptions__GetSnapshot(m_read_opts);
-      rocksdb::Snapshot *null_snap = nullptr;
-      rocksdb_rpc_log(4470, "get_for_update: rocksdb_ReadOptions__SetSnapshot");
-      rocksdb_ReadOptions__SetSnapshot(m_read_opts, null_snap);
+      auto saved_snapshot = get_read_snapshot();
+      rocksdb_rpc_log(4470, "get_for_update: set_read_snapshot");
+      set_read_snapshot(nullptr);
 
       // ALTER
       // s = m_rocksdb_tx->GetForUpdate(m_read_opts, column_family, key, value,
       //                                exclusive, false);
       rocksdb_rpc_log(4477,
                       "get_for_update: rocksdb_Transaction__GetForUpdate");
-      s = rocksdb_Transaction__GetForUpdate(m_rocksdb_tx, m_read_opts,
-                                            column_family, key, value,
-                                            exclusive, false);
+      {
+        const Rdb_rpc_call_timer rpc_timer("Transaction::GetForUpdate");
+        s = rpc_timer.result(rocksdb_Transaction__GetForUpdate(
+            m_rocksdb_tx, m_read_opts, column_family, key, value, exclusive,
+            false));
+      }
 
       // ALTER
       // m_read_opts.snapshot = saved_snapshot;
-      rocksdb_ReadOptions__SetSnapshot(m_read_opts, saved_snapshot);
+      set_read_snapshot(saved_snapshot);
     }
     // row_lock_count is to track per row instead of per key
     if (key_descr.is_primary_key()) incr_row_lock_count();
@@ -4492,10 +4756,12 @@ class Rdb_transaction_impl : public Rdb_transaction {
   rocksdb::Iterator *get_iterator(
       rocksdb::ReadOptions *options,
       rocksdb::ColumnFamilyHandle *const column_family) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
     global_stats.queries[QUERIES_RANGE].inc();
     rocksdb_rpc_log(4495, "get_iterator: rocksdb_Transaction__GetIterator");
     // ALTER
     // return m_rocksdb_tx->GetIterator(options, column_family);
+    const Rdb_rpc_call_timer rpc_timer("Transaction::GetIterator");
     return rocksdb_Transaction__GetIterator(m_rocksdb_tx, options,
                                             column_family);
   }
@@ -4541,7 +4807,7 @@ class Rdb_transaction_impl : public Rdb_transaction {
 
     // ALTER
     // m_read_opts = rocksdb::ReadOptions();
-    m_read_opts = rocksdb_ReadOptions__NewReadOptions();
+    reset_read_opts();
     set_initial_savepoint();
 
     m_ddl_transaction = false;
@@ -4643,14 +4909,13 @@ class Rdb_transaction_impl : public Rdb_transaction {
         // ALTER
         // m_read_opts.snapshot = cur_snapshot;
         // m_read_opts.snapshot = cur_snapshot;
-        rocksdb_ReadOptions__SetSnapshot(m_read_opts, cur_snapshot);
+        set_read_snapshot(cur_snapshot);
 
         if (cur_snapshot != nullptr) {
           // ALTER
           // rdb->GetEnv()->GetCurrentTime(&m_snapshot_timestamp);
           rocksdb_rpc_log(4647, "rollback_stmt: rocksdb_Env__GetCurrentTime");
-          rocksdb_Env__GetCurrentTime(rocksdb_TransactionDB__GetEnv(rdb),
-                                      &m_snapshot_timestamp);
+          rocksdb_Env__GetCurrentTime(rdb_get_env(rdb), &m_snapshot_timestamp);
 
         } else {
           m_is_delayed_snapshot = true;
@@ -4710,7 +4975,7 @@ class Rdb_writebatch_impl : public Rdb_transaction {
 
     // ALTER
     // m_read_opts = rocksdb::ReadOptions();
-    m_read_opts = rocksdb_ReadOptions__NewReadOptions();
+    reset_read_opts();
 
     m_ddl_transaction = false;
     rocksdb_rpc_log(4712, "reset: end");
@@ -4720,6 +4985,7 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   bool prepare() override { return true; }
 
   bool commit_no_binlog() override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::COMMIT);
     rocksdb_rpc_log(4719, "commit_no_binlog: start");
     bool res = false;
     rocksdb::Status s;
@@ -4743,9 +5009,14 @@ class Rdb_writebatch_impl : public Rdb_transaction {
     // ALTER
     // s = rdb->Write(write_opts, optimize, m_batch->GetWriteBatch());
     rocksdb_rpc_log(4740, "commit_no_binlog: rocksdb_TransactionDB__Write");
-    s = rocksdb_TransactionDB__Write(
-        rdb, write_opts, optimize,
-        rocksdb_WriteBatchWithIndex__GetWriteBatch(m_batch));
+    row_cache_invalidate_begin();
+    {
+      const Rdb_rpc_call_timer rpc_timer("TransactionDB::Write");
+      s = rpc_timer.result(rocksdb_TransactionDB__Write(
+          rdb, write_opts, optimize,
+          rocksdb_WriteBatchWithIndex__GetWriteBatch(m_batch)));
+    }
+    row_cache_invalidate_end();
     if (!s.ok()) {
       rdb_handle_io_error(s, RDB_IO_ERROR_TX_COMMIT);
       res = true;
@@ -4754,6 +5025,7 @@ class Rdb_writebatch_impl : public Rdb_transaction {
     on_commit();
   error:
     on_rollback();
+    row_cache_reset_writes();
     reset();
 
     m_write_count = 0;
@@ -4807,8 +5079,10 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   }
 
   void rollback() override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::COMMIT);
     rocksdb_rpc_log(4801, "rollback: begin");
     on_rollback();
+    row_cache_reset_writes();
     m_write_count = 0;
     m_insert_count = 0;
     m_update_count = 0;
@@ -4826,7 +5100,8 @@ class Rdb_writebatch_impl : public Rdb_transaction {
     rocksdb_rpc_log(4817, "acquire_snapshot: start");
     // ALTER
     // if (m_read_opts.snapshot == nullptr) {
-    if (rocksdb_ReadOptions__GetSnapshot(m_read_opts) == nullptr) {
+    if (get_read_snapshot() == nullptr) {
+      m_row_cache_epoch = rpc_row_cache.current_epoch();
       // ALTER
       // snapshot_created(rdb->GetSnapshot());
       snapshot_created(rocksdb_TransactionDB__GetSnapshot(rdb));
@@ -4841,14 +5116,13 @@ class Rdb_writebatch_impl : public Rdb_transaction {
     //   m_read_opts.snapshot = nullptr;
     // }
     rocksdb_rpc_log(4834, "release_snapshot: start");
-    if (rocksdb_ReadOptions__GetSnapshot(m_read_opts) != nullptr) {
+    if (get_read_snapshot() != nullptr) {
       rocksdb_rpc_log(
           4836, "release_snapshot: rocksdb_TransactionDB__ReleaseSnapshot");
-      rocksdb_TransactionDB__ReleaseSnapshot(
-          rdb, rocksdb_ReadOptions__GetSnapshot(m_read_opts));
+      rocksdb_TransactionDB__ReleaseSnapshot(rdb, get_read_snapshot());
       // ALTER
       // m_read_opts.snapshot = nullptr;
-      rocksdb_ReadOptions__SetSnapshot(m_read_opts, nullptr);
+      set_read_snapshot(nullptr);
     }
     rocksdb_rpc_log(4843, "release_snapshot: end");
   }
@@ -4856,10 +5130,14 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   rocksdb::Status put(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key, const rocksdb::Slice &value,
                       const bool assume_tracked) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4849, "put: rocksdb_WriteBatchWithIndex__Put");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
     // ALTER
     // m_batch->Put(column_family, key, value);
+    const Rdb_rpc_call_timer rpc_timer("WriteBatchWithIndex::Put");
     rocksdb_WriteBatchWithIndex__Put(m_batch, column_family, key, value);
 
     // Note Put/Delete in write batch doesn't return any error code. We simply
@@ -4870,12 +5148,18 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   rocksdb::Status delete_key(rocksdb::ColumnFamilyHandle *const column_family,
                              const rocksdb::Slice &key,
                              const bool assume_tracked) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4868, "delete_key: start");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
 
     // ALTER
     // m_batch->Delete(column_family, key);
-    rocksdb_WriteBatchWithIndex__Delete(m_batch, column_family, key);
+    {
+      const Rdb_rpc_call_timer rpc_timer("WriteBatchWithIndex::Delete");
+      rocksdb_WriteBatchWithIndex__Delete(m_batch, column_family, key);
+    }
     rocksdb_rpc_log(4870, "delete_key: end");
     return rocksdb::Status::OK();
   }
@@ -4883,14 +5167,21 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   rocksdb::Status single_delete(
       rocksdb::ColumnFamilyHandle *const column_family,
       const rocksdb::Slice &key, const bool /* assume_tracked */) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::WRITE);
     rocksdb_rpc_log(4876, "single_delete: start");
     ++m_write_count;
+    ++m_write_generation;
+    row_cache_track_write(column_family, key);
 
     // ALTER
     // m_batch->SingleDelete(column_family, key);
     rocksdb_rpc_log(
         4882, "single_delete: rocksdb_WriteBatchWithIndex__SingleDeleteart");
-    rocksdb_WriteBatchWithIndex__SingleDelete(m_batch, column_family, key);
+    {
+      const Rdb_rpc_call_timer rpc_timer(
+          "WriteBatchWithIndex::SingleDelete");
+      rocksdb_WriteBatchWithIndex__SingleDelete(m_batch, column_family, key);
+    }
     rocksdb_rpc_log(4883, "single_delete: end");
     return rocksdb::Status::OK();
   }
@@ -4908,22 +5199,34 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   rocksdb::WriteBatchBase *get_indexed_write_batch() override {
     rocksdb_rpc_log(4899, "get_indexed_write_batch: start");
     ++m_write_count;
+    ++m_write_generation;
     return m_batch;
   }
 
   rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key,
                       rocksdb::PinnableSlice *&value) const override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     // ALTER
     // value->Reset();
     // return m_batch->GetFromBatchAndDB(rdb, m_read_opts, column_family, key,
     //                                   value);
     rocksdb_rpc_log(4910, "get: rocksdb_PinnableSlice__Reset");
     rocksdb_PinnableSlice__Reset(value);
+    std::string cache_key;
+    if (row_cache_get(column_family, key, value, &cache_key)) {
+      return rocksdb::Status::OK();
+    }
+
     rocksdb_rpc_log(4913,
                     "get: rocksdb_WriteBatchWithIndex__GetFromBatchAndDB");
-    return rocksdb_WriteBatchWithIndex__GetFromBatchAndDB(
-        m_batch, rdb, m_read_opts, column_family, key, value);
+    const Rdb_rpc_call_timer rpc_timer(
+        "WriteBatchWithIndex::GetFromBatchAndDB");
+    const rocksdb::Status s =
+        rpc_timer.result(rocksdb_WriteBatchWithIndex__GetFromBatchAndDB(
+            m_batch, rdb, m_read_opts, column_family, key, value));
+    row_cache_fill(cache_key, s, value);
+    return s;
   }
 
   rocksdb::Status get_for_update(const Rdb_key_def &key_descr,
@@ -4931,6 +5234,7 @@ class Rdb_writebatch_impl : public Rdb_transaction {
                                  rocksdb::PinnableSlice *&value,
                                  bool /* exclusive */,
                                  const bool /* do_validate */) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     rocksdb_rpc_log(4923, "get_for_update: begin");
     rocksdb::ColumnFamilyHandle *const column_family = key_descr.get_cf();
     if (value == nullptr) {
@@ -4954,12 +5258,15 @@ class Rdb_writebatch_impl : public Rdb_transaction {
                  const size_t num_keys, const rocksdb::Slice *keys,
                  rocksdb::PinnableSlice **values, rocksdb::Status *statuses,
                  const bool sorted_input) const override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::POINT_GET);
     // TODO: ALTER
     // m_batch->MultiGetFromBatchAndDB(rdb, m_read_opts, column_family,
     // num_keys,
     //                                 keys, values, statuses, sorted_input);
     rocksdb_rpc_log(
         4949, "multi_get: rocksdb_WriteBatchWithIndex__MultiGetFromBatchAndDB");
+    const Rdb_rpc_call_timer rpc_timer(
+        "WriteBatchWithIndex::MultiGetFromBatchAndDB");
     rocksdb_WriteBatchWithIndex__MultiGetFromBatchAndDB(
         rdb, m_read_opts, m_batch, column_family, num_keys, keys, values,
         statuses, sorted_input);
@@ -4969,8 +5276,10 @@ class Rdb_writebatch_impl : public Rdb_transaction {
   rocksdb::Iterator *get_iterator(
       rocksdb::ReadOptions *options,
       rocksdb::ColumnFamilyHandle *const /* column_family */) override {
+    const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
     // const auto it = rdb->NewIterator(options);
     // return m_batch->NewIteratorWithBase(it);
+    const Rdb_rpc_call_timer rpc_timer("DB::NewIterator");
     auto it = rocksdb_DB__NewIterator(rdb, options);
     rocksdb_rpc_log(
         4961, "multi_get: rocksdb_WriteBatchWithIndex__NewIteratorWithBase");
@@ -5045,6 +5354,33 @@ Rdb_transaction *&get_tx_from_thd(THD *const thd) {
       my_core::thd_ha_data(thd, rocksdb_hton));
 }
 
+/*
+  Records every RPC timed with Rdb_rpc_call_timer in the global statistics
+  and in those of the transaction of the calling session, under the call
+  site set by the innermost Rdb_rpc_call_site_scope of the thread.
+*/
+class Rdb_rpc_stats_observer : public Rdb_rpc_call_observer {
+ public:
+  void on_call(const char *const method, const uint64_t micros,
+               const bool failed) override {
+    if (!rocksdb_rpc_call_stats) {
+      return;
+    }
+    const Rdb_rpc_call_site site = Rdb_rpc_call_site_scope::current();
+    rpc_call_stats.record(site, method, micros, failed);
+
+    THD *const thd = my_core::thd_get_current_thd();
+    if (thd != nullptr) {
+      Rdb_transaction *const tx = get_tx_from_thd(thd);
+      if (tx != nullptr) {
+        tx->get_rpc_call_stats()->record(site, method, micros, failed);
+      }
+    }
+  }
+};
+
+static Rdb_rpc_stats_observer rpc_stats_observer;
+
 class Rdb_perf_context_guard {
   Rdb_io_perf m_io_perf;
   Rdb_io_perf *m_io_perf_ptr;
@@ -5145,8 +5481,8 @@ static bool rocksdb_flush_wal(handlerton *const hton MY_ATTRIBUTE((__unused__)),
   /*
     target_lsn is set to 0 when MySQL wants to sync the wal files
   */
-  if ((target_lsn == 0 && !rocksdb_DBOptions__GetBoolOptions(
-                              rocksdb_db_options, "allow_mmap_writes")) ||
+  if ((target_lsn == 0 &&
+       !rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_writes")) ||
       rocksdb_flush_log_at_trx_commit != FLUSH_LOG_NEVER) {
     rocksdb_wal_group_syncs++;
 
@@ -5618,11 +5954,10 @@ class Rdb_snapshot_status : public Rdb_tx_list_walker {
     //                        ? cfh->GetName()
     //                        : "NOT FOUND; CF_ID: " +
     //                        std::to_string(txn.m_cf_id);
-    rocksdb_rpc_log(5622,
-                    " get_dl_txn_info: rocksdb_ColumnFamilyHandle__GetName");
-    txn_data.cf_name = (cfh)
-                           ? rocksdb_ColumnFamilyHandle__GetName(cfh)
-                           : "NOT FOUND; CF_ID: " + std::to_string(txn.m_cf_id);
+    rocksdb_rpc_log(5622, " get_dl_txn_info: rdb_cf_name");
+    txn_data.cf_name =
+        (cfh) ? rdb_cf_name(cfh)
+              : "NOT FOUND; CF_ID: " + std::to_string(txn.m_cf_id);
 
     txn_data.waiting_key =
         rdb_hexdump(txn.m_waiting_key.c_str(), txn.m_waiting_key.length());
@@ -5866,6 +6201,59 @@ std::vector<Rdb_trx_info> rdb_get_all_trx_info() {
   return trx_info;
 }
 
+static void rdb_add_rpc_call_stats(
+    const Rdb_rpc_call_stats_map &calls, const char *const scope,
+    const ulong thread_id, std::vector<Rdb_rpc_call_stats_info> *const out) {
+  for (const auto &it : calls) {
+    const Rdb_rpc_latency_histogram &hist = it.second;
+    out->push_back({scope, thread_id, rdb_rpc_call_site_name(it.first.first),
+                    it.first.second, hist.calls(), hist.errors(),
+                    hist.total_micros(), hist.percentile(50),
+                    hist.percentile(95), hist.percentile(99),
+                    hist.max_micros()});
+  }
+}
+
+/*
+  Collects the RPC statistics of all sessions that have a transaction
+  object.
+*/
+class Rdb_rpc_call_stats_aggregator : public Rdb_tx_list_walker {
+ private:
+  std::vector<Rdb_rpc_call_stats_info> *m_stats;
+
+ public:
+  explicit Rdb_rpc_call_stats_aggregator(
+      std::vector<Rdb_rpc_call_stats_info> *const stats)
+      : m_stats(stats) {}
+
+  void process_tran(const Rdb_transaction *const tx) override {
+    THD *const thd = tx->get_thd();
+    if (thd == nullptr) {
+      return;
+    }
+    Rdb_rpc_call_stats_map calls;
+    tx->get_rpc_call_stats()->collect(&calls);
+    rdb_add_rpc_call_stats(calls, "SESSION", thd_thread_id(thd), m_stats);
+  }
+};
+
+/*
+  returns the RPC statistics of the process and of every session
+  for use by information_schema.rocksdb_rpc_call_stats
+*/
+std::vector<Rdb_rpc_call_stats_info> rdb_get_rpc_call_stats() {
+  std::vector<Rdb_rpc_call_stats_info> stats;
+
+  Rdb_rpc_call_stats_map calls;
+  rpc_call_stats.collect(&calls);
+  rdb_add_rpc_call_stats(calls, "GLOBAL", 0, &stats);
+
+  Rdb_rpc_call_stats_aggregator stats_agg(&stats);
+  Rdb_transaction::walk_tx_list(&stats_agg);
+  return stats;
+}
+
 /*
   returns a vector of info of recent deadlocks
   for use by information_schema.rocksdb_deadlock
@@ -6142,8 +6530,8 @@ static bool rocksdb_show_status(handlerton *const hton, THD *const thd,
     rocksdb_rpc_log(6143,
                     " rocksdb_show_status: "
                     "rocksdb_Env__GetThreadList");
-    rocksdb::Status s = rocksdb_Env__GetThreadList(
-        rocksdb_TransactionDB__GetEnv(rdb), thread_list);
+    rocksdb::Status s =
+        rocksdb_Env__GetThreadList(rdb_get_env(rdb), thread_list);
 
     if (!s.ok()) {
       // NO_LINT_DEBUG
@@ -6182,6 +6570,10 @@ static bool rocksdb_show_status(handlerton *const hton, THD *const thd,
     if (!str.empty()) {
       res |= print_stats(thd, "EXPLICIT_SNAPSHOTS", "rocksdb", str, stat_print);
     }
+
+    /* RPC call counts and latencies */
+    res |= print_stats(thd, "RPC_CALLS", "rocksdb", rpc_call_stats.dump(),
+                       stat_print);
   } else if (stat_type == HA_ENGINE_TRX) {
     /* Handle the SHOW ENGINE ROCKSDB TRANSACTION STATUS command */
     res |= rocksdb_show_snapshot_status(hton, thd, stat_print);
@@ -6390,9 +6782,9 @@ static int rocksdb_start_tx_with_shared_read_view(
       //     tx->m_read_opts.snapshot);
       rocksdb_rpc_log(6392,
                       "rocksdb_start_tx_with_shared_read_view: "
-                      "rocksdb_ReadOptions__GetSnapshot");
-      tx->m_explicit_snapshot = Rdb_explicit_snapshot::create(
-          ss_info, rdb, rocksdb_ReadOptions__GetSnapshot(tx->m_read_opts));
+                      "get_read_snapshot");
+      tx->m_explicit_snapshot =
+          Rdb_explicit_snapshot::create(ss_info, rdb, tx->get_read_snapshot());
       if (!tx->m_explicit_snapshot) {
         my_printf_error(ER_UNKNOWN_ERROR, "Could not create snapshot", MYF(0));
         error = HA_EXIT_FAILURE;
@@ -6743,6 +7135,9 @@ static int rocksdb_init_func(void *const p) {
   DBUG_ASSERT(!mysqld_embedded);
   rocksdb_rpc_log(6745, "rocksdb_init_func: finish hton set");
 
+  rdb_rpc_set_call_observer(&rpc_stats_observer);
+  rpc_row_cache.set_capacity(rocksdb_rpc_row_cache_size);
+
   // ALTER
   // if (rocksdb_db_options->max_open_files > (long)open_files_limit) {
   //   // NO_LINT_DEBUG
@@ -6755,7 +7150,7 @@ static int rocksdb_init_func(void *const p) {
   // } else if (rocksdb_db_options->max_open_files == -2) {
   //   rocksdb_db_options->max_open_files = open_files_limit / 2;
   // }
-  if (rocksdb_DBOptions__GetIntOptions(rocksdb_db_options, "max_open_files") >
+  if (rdb_get_db_option_int(rocksdb_db_options, "max_open_files") >
       (long)open_files_limit) {
     // NO_LINT_DEBUG
     sql_print_information(
@@ -6763,16 +7158,14 @@ static int rocksdb_init_func(void *const p) {
         "greater than the open_files_limit, effective value "
         "of rocksdb_max_open_files is being set to "
         "open_files_limit / 2.");
-    rocksdb_rpc_log(6767,
-                    "rocksdb_init_func: rocksdb_DBOptions__SetIntOptions");
-    rocksdb_DBOptions__SetIntOptions(rocksdb_db_options, "max_open_files",
-                                     open_files_limit / 2);
-  } else if (rocksdb_DBOptions__GetIntOptions(rocksdb_db_options,
-                                              "max_open_files") == -2) {
-    rocksdb_rpc_log(6773,
-                    "rocksdb_init_func: rocksdb_DBOptions__SetIntOptions");
-    rocksdb_DBOptions__SetIntOptions(rocksdb_db_options, "max_open_files",
-                                     open_files_limit / 2);
+    rocksdb_rpc_log(6767, "rocksdb_init_func: rdb_set_db_option_int");
+    rdb_set_db_option_int(rocksdb_db_options, "max_open_files",
+                          open_files_limit / 2);
+  } else if (rdb_get_db_option_int(rocksdb_db_options, "max_open_files") ==
+             -2) {
+    rocksdb_rpc_log(6773, "rocksdb_init_func: rdb_set_db_option_int");
+    rdb_set_db_option_int(rocksdb_db_options, "max_open_files",
+                          open_files_limit / 2);
   }
 
   rdb_read_free_regex_handler.set_patterns(DEFAULT_READ_FREE_RPL_TABLES);
@@ -6807,12 +7200,11 @@ static int rocksdb_init_func(void *const p) {
     rocksdb_DBOptions__SetRateLimiter(rocksdb_db_options, rocksdb_rate_limiter);
   }
 
-  rocksdb_rpc_log(6808,
-                  "rocksdb_init_func: rocksdb_DBOptions__SetUInt64Options");
+  rocksdb_rpc_log(6808, "rocksdb_init_func: rdb_set_db_option_uint64");
   // ALTER
   // rocksdb_db_options->delayed_write_rate = rocksdb_delayed_write_rate;
-  rocksdb_DBOptions__SetUInt64Options(rocksdb_db_options, "delayed_write_rate",
-                                      rocksdb_delayed_write_rate);
+  rdb_set_db_option_uint64(rocksdb_db_options, "delayed_write_rate",
+                           rocksdb_delayed_write_rate);
   std::shared_ptr<Rdb_logger> myrocks_logger = std::make_shared<Rdb_logger>();
 
   // ALTER
@@ -6859,11 +7251,11 @@ static int rocksdb_init_func(void *const p) {
   // rocksdb_db_options->track_and_verify_wals_in_manifest =
   //     rocksdb_track_and_verify_wals_in_manifest;
   rocksdb_rpc_log(6856,
-                  "rocksdb_init_func: rocksdb_DBOptions__SetBoolOptions "
+                  "rocksdb_init_func: rdb_set_db_option_bool "
                   "track_and_verify_wals_in_manifest");
-  rocksdb_DBOptions__SetBoolOptions(rocksdb_db_options,
-                                    "track_and_verify_wals_in_manifest",
-                                    rocksdb_track_and_verify_wals_in_manifest);
+  rdb_set_db_option_bool(rocksdb_db_options,
+                         "track_and_verify_wals_in_manifest",
+                         rocksdb_track_and_verify_wals_in_manifest);
 
   // ALTER
   // rocksdb_db_options->access_hint_on_compaction_start =
@@ -6889,10 +7281,8 @@ static int rocksdb_init_func(void *const p) {
   //   DBUG_RETURN(HA_EXIT_FAILURE);
   // }
 
-  if (rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "allow_mmap_reads") &&
-      rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "use_direct_reads")) {
+  if (rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_reads") &&
+      rdb_get_db_option_bool(rocksdb_db_options, "use_direct_reads")) {
     rocksdb_rpc_log(6886, "rocksdb_init_func: failed");
     sql_print_error(
         "RocksDB: Can't enable both use_direct_reads "
@@ -6905,10 +7295,9 @@ static int rocksdb_init_func(void *const p) {
   // ALTER
   // if (rocksdb_db_options->use_direct_reads ||
   //     rocksdb_db_options->use_direct_io_for_flush_and_compaction) {
-  if (rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "use_direct_reads") ||
-      rocksdb_DBOptions__GetBoolOptions(
-          rocksdb_db_options, "use_direct_io_for_flush_and_compaction")) {
+  if (rdb_get_db_option_bool(rocksdb_db_options, "use_direct_reads") ||
+      rdb_get_db_option_bool(rocksdb_db_options,
+                             "use_direct_io_for_flush_and_compaction")) {
     rocksdb::EnvOptions soptions;
     rocksdb::Status check_status;
 
@@ -6978,10 +7367,9 @@ static int rocksdb_init_func(void *const p) {
   //     rocksdb_db_options->use_direct_io_for_flush_and_compaction) {
   // See above comment for allow_mmap_reads. (NO_LINT_DEBUG)
 
-  if (rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "allow_mmap_writes") ||
-      rocksdb_DBOptions__GetBoolOptions(
-          rocksdb_db_options, "use_direct_io_for_flush_and_compaction")) {
+  if (rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_writes") ||
+      rdb_get_db_option_bool(rocksdb_db_options,
+                             "use_direct_io_for_flush_and_compaction")) {
     rocksdb_rpc_log(6985, "rocksdb_init_func: failed");
     sql_print_error(
         "RocksDB: Can't enable both "
@@ -6993,8 +7381,7 @@ static int rocksdb_init_func(void *const p) {
   // ALTER
   // if (rocksdb_db_options->allow_mmap_writes &&
   //     rocksdb_flush_log_at_trx_commit != FLUSH_LOG_NEVER)
-  if (rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                        "allow_mmap_writes") &&
+  if (rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_writes") &&
       rocksdb_flush_log_at_trx_commit != FLUSH_LOG_NEVER) {
     // NO_LINT_DEBUG
     sql_print_error(
@@ -7686,6 +8073,7 @@ static int rocksdb_done_func(void *const p) {
   rocksdb_rpc_log(7682, "rocksdb_done_func: rocksdb_TransactionDB__delete;");
   rocksdb_TransactionDB__delete(rdb);
   rdb = nullptr;
+  rdb_get_rpc_handle_cache().clear();
 
   delete commit_latency_stats;
   // rocksdb_HistogramImpl__delete(commit_latency_stats);
@@ -7713,6 +8101,8 @@ static int rocksdb_done_func(void *const p) {
   rocksdb_tbl_options = nullptr;
   rocksdb_stats = nullptr;
 
+  rdb_rpc_set_call_observer(nullptr);
+
   my_error_unregister(HA_ERR_ROCKSDB_FIRST, HA_ERR_ROCKSDB_LAST);
 
   DBUG_RETURN(error);
@@ -7722,6 +8112,17 @@ static int rocksdb_done_func(void *const p) {
 // If the iterator is not valid it might be because of EOF but might be due
 // to IOError or corruption. The good practice is always check it.
 // https://github.com/facebook/rocksdb/wiki/Iterator#error-handling
+static void rdb_check_iterator_status(rocksdb::Status s) {
+  DBUG_EXECUTE_IF("rocksdb_return_status_corrupted",
+                  dbug_change_status_to_corrupted(&s););
+  if (s.IsIOError() || s.IsCorruption()) {
+    if (s.IsCorruption()) {
+      rdb_persist_corruption_marker();
+    }
+    rdb_handle_io_error(s, RDB_IO_ERROR_GENERAL);
+  }
+}
+
 inline bool is_valid_iterator(rocksdb::Iterator *scan_it) {
   rocksdb_rpc_log(7720, "is_valid_iterator: start");
 
@@ -7735,20 +8136,20 @@ inline bool is_valid_iterator(rocksdb::Iterator *scan_it) {
     // ALTER
     // rocksdb::Status s = scan_it->status();
     rocksdb_rpc_log(7732, "is_valid_iterator: rocksdb_Iterator__status");
-    rocksdb::Status s = rocksdb_Iterator__status(scan_it);
-    DBUG_EXECUTE_IF("rocksdb_return_status_corrupted",
-                    dbug_change_status_to_corrupted(&s););
-    if (s.IsIOError() || s.IsCorruption()) {
-      if (s.IsCorruption()) {
-        rdb_persist_corruption_marker();
-      }
-      rdb_handle_io_error(s, RDB_IO_ERROR_GENERAL);
-    }
+    rdb_check_iterator_status(rocksdb_Iterator__status(scan_it));
     rocksdb_rpc_log(7740, "is_valid_iterator: end");
     return false;
   }
 }
 
+bool is_valid_iterator(Rdb_rpc_iterator *scan_it) {
+  if (scan_it->Valid()) {
+    return true;
+  }
+  rdb_check_iterator_status(scan_it->status());
+  return false;
+}
+
 /**
   @brief
   Example of simple lock controls. The "table_handler" it creates is a
@@ -8307,19 +8708,19 @@ bool ha_rocksdb::should_hide_ttl_rec(const Rdb_key_def &kd,
 }
 
 int ha_rocksdb::rocksdb_skip_expired_records(const Rdb_key_def &kd,
-                                             rocksdb::Iterator *const iter,
+                                             Rdb_rpc_iterator *const iter,
                                              bool seek_backward) {
   rocksdb_rpc_log(8307, "rocksdb_skip_expired_records: start");
   if (kd.has_ttl()) {
     THD *thd = ha_thd();
 
     rocksdb_rpc_log(8311,
-                    "rocksdb_skip_expired_records: rocksdb_Iterator__Valid");
+                    "rocksdb_skip_expired_records: Rdb_rpc_iterator::Valid");
     // ALTER
     // while (iter->Valid() &&
-    while (rocksdb_Iterator__Valid(iter) &&
+    while (iter->Valid() &&
            should_hide_ttl_rec(
-               kd, rocksdb_Iterator__value(iter),
+               kd, iter->value(),
                get_or_create_tx(table->in_use)->m_snapshot_timestamp)) {
       DEBUG_SYNC(thd, "rocksdb.check_flags_ser");
       if (thd && thd->killed) {
@@ -8594,6 +8995,7 @@ void ha_rocksdb::set_skip_unique_check_tables(const char *const whitelist) {
     other            HA_ERR error code (can be SE-specific)
 */
 int ha_rocksdb::open(const char *const name, int mode, uint test_if_locked) {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::OPEN);
   rocksdb_rpc_log(8582, "open: start");
 
   DBUG_ENTER_FUNC();
@@ -8713,8 +9115,12 @@ int ha_rocksdb::open(const char *const name, int mode, uint test_if_locked) {
                   "open: rocksdb_BlockBasedTableOptions__GetSizeTOptions");
   // ALTER
   // stats.block_size = rocksdb_tbl_options->block_size;
-  stats.block_size = rocksdb_BlockBasedTableOptions__GetSizeTOptions(
-      rocksdb_tbl_options, "block_size");
+  {
+    const Rdb_rpc_call_timer rpc_timer(
+        "BlockBasedTableOptions::GetSizeTOptions");
+    stats.block_size = rocksdb_BlockBasedTableOptions__GetSizeTOptions(
+        rocksdb_tbl_options, "block_size");
+  }
   /* Determine at open whether we should skip unique checks for this table */
   set_skip_unique_check_tables(THDVAR(ha_thd(), skip_unique_check_tables));
 
@@ -9176,13 +9582,13 @@ int ha_rocksdb::create_cfs(
       std::lock_guard<Rdb_dict_manager> dm_lock(dict_manager);
       cf_handle = cf_manager.get_or_create_cf(rdb, cf_name);
       if (!cf_handle) {
-        rocksdb_rpc_log(9168, "create_cfs: rocksdb_ColumnFamilyHandle__GetID");
+        rocksdb_rpc_log(9168, "create_cfs: rdb_cf_id");
         DBUG_RETURN(HA_EXIT_FAILURE);
       }
 
-      rocksdb_rpc_log(9173, "create_cfs: rocksdb_ColumnFamilyHandle__GetID");
+      rocksdb_rpc_log(9173, "create_cfs: rdb_cf_id");
       // uint32 cf_id = cf_handle->GetID();
-      uint32 cf_id = rocksdb_ColumnFamilyHandle__GetID(cf_handle);
+      uint32 cf_id = rdb_cf_id(cf_handle);
 
       // If the cf is marked as dropped, we fail it here.
       // The cf can be dropped after this point, we will
@@ -9192,15 +9598,15 @@ int ha_rocksdb::create_cfs(
         DBUG_RETURN(HA_EXIT_FAILURE);
       }
 
-      rocksdb_rpc_log(9188, "create_cfs: rocksdb_ColumnFamilyHandle__GetID");
+      rocksdb_rpc_log(9188, "create_cfs: rdb_cf_id");
 
       // ALTER
       // if (cf_manager.create_cf_flags_if_needed(&dict_manager,
       //                                          cf_handle->GetID(), cf_name,
       //                                          per_part_match_found)) {
-      if (cf_manager.create_cf_flags_if_needed(
-              &dict_manager, rocksdb_ColumnFamilyHandle__GetID(cf_handle),
-              cf_name, per_part_match_found)) {
+      if (cf_manager.create_cf_flags_if_needed(&dict_manager,
+                                               rdb_cf_id(cf_handle), cf_name,
+                                               per_part_match_found)) {
         rocksdb_rpc_log(9189, "create_cfs: end");
 
         DBUG_RETURN(HA_EXIT_FAILURE);
@@ -10045,7 +10451,7 @@ bool ha_rocksdb::check_keyread_allowed(uint inx, uint part,
 }
 
 int ha_rocksdb::read_key_exact(const Rdb_key_def &kd,
-                               rocksdb::Iterator *const iter,
+                               Rdb_rpc_iterator *const iter,
                                const bool /* unused */,
                                const rocksdb::Slice &key_slice,
                                const int64_t ttl_filter_ts) {
@@ -10060,9 +10466,8 @@ int ha_rocksdb::read_key_exact(const Rdb_key_def &kd,
 
   // ALTER
   // while (iter->Valid() && kd.value_matches_prefix(iter->key(), key_slice)) {
-  rocksdb_rpc_log(10053, "read_key_exact: rocksdb_Iterator__Valid");
-  while (rocksdb_Iterator__Valid(iter) &&
-         kd.value_matches_prefix(rocksdb_Iterator__key(iter), key_slice)) {
+  rocksdb_rpc_log(10053, "read_key_exact: Rdb_rpc_iterator::Valid");
+  while (iter->Valid() && kd.value_matches_prefix(iter->key(), key_slice)) {
     if (thd && thd->killed) {
       rocksdb_rpc_log(10056, "read_key_exact: end");
       return HA_ERR_QUERY_INTERRUPTED;
@@ -10073,7 +10478,7 @@ int ha_rocksdb::read_key_exact(const Rdb_key_def &kd,
       key.
     */
     if (kd.has_ttl() &&
-        should_hide_ttl_rec(kd, rocksdb_Iterator__value(iter), ttl_filter_ts)) {
+        should_hide_ttl_rec(kd, iter->value(), ttl_filter_ts)) {
       rocksdb_smart_next(kd.m_is_reverse_cf, iter);
       continue;
     }
@@ -10152,8 +10557,7 @@ int ha_rocksdb::read_after_key(const Rdb_key_def &kd,
   */
   while (is_valid_iterator(m_scan_it) && kd.has_ttl() &&
          /*ALTER should_hide_ttl_rec(kd, m_scan_it->value()*/
-         should_hide_ttl_rec(kd, rocksdb_Iterator__value(m_scan_it),
-                             ttl_filter_ts)) {
+         should_hide_ttl_rec(kd, m_scan_it->value(), ttl_filter_ts)) {
     if (thd && thd->killed) {
       rocksdb_rpc_log(10147, "read_after_key: end");
 
@@ -10185,7 +10589,7 @@ int ha_rocksdb::position_to_correct_key(
       *move_forward = false;
       rc = read_before_key(kd, full_key_match, key_slice, ttl_filter_ts);
       // ALTER
-      if (rc == 0 && !kd.covers_key(rocksdb_Iterator__key(m_scan_it))) {
+      if (rc == 0 && !kd.covers_key(m_scan_it->key())) {
         /* The record we've got is not from this index */
         rc = HA_ERR_KEY_NOT_FOUND;
       }
@@ -10194,7 +10598,7 @@ int ha_rocksdb::position_to_correct_key(
     case HA_READ_KEY_OR_NEXT:
       rc = read_after_key(kd, key_slice, ttl_filter_ts);
       // ALTER
-      if (rc == 0 && !kd.covers_key(rocksdb_Iterator__key(m_scan_it))) {
+      if (rc == 0 && !kd.covers_key(m_scan_it->key())) {
         /* The record we've got is not from this index */
         rc = HA_ERR_KEY_NOT_FOUND;
       }
@@ -10220,7 +10624,7 @@ int ha_rocksdb::position_to_correct_key(
       if (rc == 0) {
         // ALTER
         // const rocksdb::Slice &rkey = m_scan_it->key();
-        const rocksdb::Slice &rkey = rocksdb_Iterator__key(m_scan_it);
+        const rocksdb::Slice &rkey = m_scan_it->key();
 
         if (!kd.covers_key(rkey)) {
           /* The record we've got is not from this index */
@@ -10303,8 +10707,8 @@ int ha_rocksdb::read_row_from_primary_key(uchar *const buf) {
 
   // ALTER
   // const rocksdb::Slice &rkey = m_scan_it->key();
-  rocksdb_rpc_log(10295, "read_row_from_primary_key: rocksdb_Iterator__key");
-  const rocksdb::Slice &rkey = rocksdb_Iterator__key(m_scan_it);
+  rocksdb_rpc_log(10295, "read_row_from_primary_key: Rdb_rpc_iterator::key");
+  const rocksdb::Slice &rkey = m_scan_it->key();
   const uint pk_size = rkey.size();
   const char *pk_data = rkey.data();
 
@@ -10318,7 +10722,7 @@ int ha_rocksdb::read_row_from_primary_key(uchar *const buf) {
     /* Unpack from the row we've read */
     // ALTER
     // const rocksdb::Slice &value = m_scan_it->value();
-    const rocksdb::Slice &value = rocksdb_Iterator__value(m_scan_it);
+    const rocksdb::Slice &value = m_scan_it->value();
 
     rc = convert_record_from_storage_format(&rkey, &value, buf);
   }
@@ -10337,8 +10741,8 @@ int ha_rocksdb::read_row_from_secondary_key(uchar *const buf,
   /* Get the key columns and primary key value */
   // const rocksdb::Slice &rkey = m_scan_it->key();
   // const rocksdb::Slice &value = m_scan_it->value();
-  const rocksdb::Slice &rkey = rocksdb_Iterator__key(m_scan_it);
-  const rocksdb::Slice &value = rocksdb_Iterator__value(m_scan_it);
+  const rocksdb::Slice &rkey = m_scan_it->key();
+  const rocksdb::Slice &value = m_scan_it->value();
 
 #ifndef DBUG_OFF
   bool save_keyread_only = m_keyread_only;
@@ -10373,7 +10777,7 @@ int ha_rocksdb::read_row_from_secondary_key(uchar *const buf,
     if (!rc) {
       // ALTER
       // const rocksdb::Slice &rkey = m_scan_it->key();
-      const rocksdb::Slice &rkey = rocksdb_Iterator__key(m_scan_it);
+      const rocksdb::Slice &rkey = m_scan_it->key();
 
       pk_size = kd.get_primary_key_tuple(table, *m_pk_descr, &rkey,
                                          m_pk_packed_tuple);
@@ -10466,9 +10870,9 @@ int ha_rocksdb::secondary_index_read(const int keyno, uchar *const buf) {
   if (is_valid_iterator(m_scan_it)) {
     // ALTER
     // rocksdb::Slice key = m_scan_it->key();
-    rocksdb_rpc_log(10460, "secondary_index_read: rocksdb_Iterator__key");
+    rocksdb_rpc_log(10460, "secondary_index_read: Rdb_rpc_iterator::key");
 
-    rocksdb::Slice key = rocksdb_Iterator__key(m_scan_it);
+    rocksdb::Slice key = m_scan_it->key();
 
     /* Check if we've ran out of records of this index */
     if (m_key_descr_arr[keyno]->covers_key(key)) {
@@ -10486,8 +10890,8 @@ int ha_rocksdb::secondary_index_read(const int keyno, uchar *const buf) {
 
       // ALTER
       // rocksdb::Slice value = m_scan_it->value();
-      rocksdb_rpc_log(10479, "secondary_index_read: rocksdb_Iterator__value");
-      rocksdb::Slice value = rocksdb_Iterator__value(m_scan_it);
+      rocksdb_rpc_log(10479, "secondary_index_read: Rdb_rpc_iterator::value");
+      rocksdb::Slice value = m_scan_it->value();
 
       bool covered_lookup =
           (m_keyread_only && m_key_descr_arr[keyno]->can_cover_lookup()) ||
@@ -10986,11 +11390,11 @@ int ha_rocksdb::check(THD *const thd, HA_CHECK_OPT *const check_opt) {
                           table_name, rows, res);
           goto error;
         }
-        rocksdb_rpc_log(10983, "check: rocksdb_Iterator__key");
+        rocksdb_rpc_log(10983, "check: Rdb_rpc_iterator::key");
 
         // ALTER
         // rocksdb::Slice key = m_scan_it->key();
-        rocksdb::Slice key = rocksdb_Iterator__key(m_scan_it);
+        rocksdb::Slice key = m_scan_it->key();
 
         sec_key_copy.copy(key.data(), key.size(), &my_charset_bin);
         rowkey_copy.copy(m_last_rowkey.ptr(), m_last_rowkey.length(),
@@ -11000,9 +11404,9 @@ int ha_rocksdb::check(THD *const thd, HA_CHECK_OPT *const check_opt) {
         //         m_scan_it->value())) {
         //   checksums++;
         // }
-        rocksdb_rpc_log(10992, "check: rocksdb_Iterator__value");
+        rocksdb_rpc_log(10992, "check: Rdb_rpc_iterator::value");
         if (m_key_descr_arr[keyno]->unpack_info_has_checksum(
-                rocksdb_Iterator__value(m_scan_it))) {
+                m_scan_it->value())) {
           checksums++;
         }
 
@@ -11401,14 +11805,14 @@ int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
           // ALTER
           // m_scan_it->Next(); /* this call cannot fail */
           rocksdb_rpc_log(11390,
-                          "index_next_with_direction: rocksdb_Iterator__Next");
-          rocksdb_Iterator__Next(m_scan_it);
+                          "index_next_with_direction: Rdb_rpc_iterator::Next");
+          m_scan_it->Next();
         } else {
           // ALTER
           // m_scan_it->Prev();
           rocksdb_rpc_log(11396,
-                          "index_next_with_direction: rocksdb_Iterator__Prev");
-          rocksdb_Iterator__Prev(m_scan_it);
+                          "index_next_with_direction: Rdb_rpc_iterator::Prev");
+          m_scan_it->Prev();
         }
       }
       rc = rocksdb_skip_expired_records(*m_key_descr_arr[active_index],
@@ -11538,8 +11942,8 @@ int ha_rocksdb::index_first_intern(uchar *const buf) {
     // ALTER
     // m_scan_it->Seek(index_key);
     // m_scan_it->Seek(index_key);
-    rocksdb_rpc_log(11528, "index_first_intern: rocksdb_Iterator__Seek");
-    rocksdb_Iterator__Seek(m_scan_it, index_key);
+    rocksdb_rpc_log(11528, "index_first_intern: Rdb_rpc_iterator::Seek");
+    m_scan_it->Seek(index_key);
     m_skip_scan_it_next_call = true;
 
     rc = index_next_with_direction(buf, true);
@@ -11637,8 +12041,8 @@ int ha_rocksdb::index_last_intern(uchar *const buf) {
 
     // ALTER
     // m_scan_it->SeekForPrev(index_key);
-    rocksdb_rpc_log(11627, "index_last_intern: rocksdb_Iterator__SeekForPrev");
-    rocksdb_Iterator__SeekForPrev(m_scan_it, index_key);
+    rocksdb_rpc_log(11627, "index_last_intern: Rdb_rpc_iterator::SeekForPrev");
+    m_scan_it->SeekForPrev(index_key);
     m_skip_scan_it_next_call = false;
 
     if (is_pk(active_index, table, m_tbl_def)) {
@@ -12300,7 +12704,7 @@ int ha_rocksdb::check_and_lock_sk(const uint key_id,
   }
 
   rocksdb_rpc_log(12288, "check_and_lock_sk: get_iterator");
-  rocksdb::Iterator *const iter = row_info.tx->get_iterator(
+  Rdb_rpc_iterator *const iter = row_info.tx->get_iterator(
       kd.get_cf(), total_order_seek, fill_cache, lower_bound_slice,
       upper_bound_slice, true /* read current data */,
       false /* acquire snapshot */);
@@ -12317,11 +12721,11 @@ int ha_rocksdb::check_and_lock_sk(const uint key_id,
   if (*found && m_insert_with_update) {
     // ALTER
     // const rocksdb::Slice &rkey = iter->key();
-    rocksdb_rpc_log(12306, "check_and_lock_sk: rocksdb_Iterator__key");
+    rocksdb_rpc_log(12306, "check_and_lock_sk: Rdb_rpc_iterator::key");
 
-    const rocksdb::Slice &key = rocksdb_Iterator__key(iter);
+    const rocksdb::Slice &rkey = iter->key();
     uint pk_size =
-        kd.get_primary_key_tuple(table, *m_pk_descr, &key, m_pk_packed_tuple);
+        kd.get_primary_key_tuple(table, *m_pk_descr, &rkey, m_pk_packed_tuple);
     if (pk_size == RDB_INVALID_KEY_LEN) {
       rc = HA_ERR_ROCKSDB_CORRUPT_DATA;
     } else {
@@ -12336,9 +12740,10 @@ int ha_rocksdb::check_and_lock_sk(const uint key_id,
     }
   }
 
-  rocksdb_rpc_log(12325, "check_and_lock_sk: rocksdb_Iterator__key");
-  // TODO: ALTER
+  rocksdb_rpc_log(12325, "check_and_lock_sk: ~Rdb_rpc_iterator");
+  // ALTER
   // delete iter;
+  delete iter;
   return rc;
 }
 
@@ -12421,10 +12826,8 @@ int ha_rocksdb::check_duplicate_sk(const TABLE *table_arg,
 
   // ALTER
   // const rocksdb::Comparator *index_comp = key_def.get_cf()->GetComparator();
-  rocksdb_rpc_log(
-      12411, "check_duplicate_sk: rocksdb_ColumnFamilyHandle__GetComparator");
-  const rocksdb::Comparator *index_comp =
-      rocksdb_ColumnFamilyHandle__GetComparator(key_def.get_cf());
+  rocksdb_rpc_log(12411, "check_duplicate_sk: rdb_cf_comparator");
+  const rocksdb::Comparator *index_comp = rdb_cf_comparator(key_def.get_cf());
 
   /* Get proper SK buffer. */
   uchar *sk_buf = sk_info->swap_and_get_sk_buf();
@@ -12547,8 +12950,10 @@ int ha_rocksdb::finalize_bulk_load(bool print_client_error) {
             12532,
             "finalize_bulk_load: rocksdb_TransactionDB__IngestExternalFile");
 
+        rpc_row_cache.invalidate_begin({}, true);
         const rocksdb::Status s = rocksdb_TransactionDB__IngestExternalFile(
             rdb, commit_info.get_cf(), commit_info.get_committed_files(), opts);
+        rpc_row_cache.invalidate_end({}, true);
 
         if (!s.ok()) {
           if (print_client_error) {
@@ -12644,8 +13049,12 @@ int ha_rocksdb::update_write_pk(const Rdb_key_def &kd,
     // row_info.tx->get_indexed_write_batch()->Put(cf, row_info.new_pk_slice,
     //                                             value_slice);
     rocksdb_rpc_log(12633, "update_write_pk: rocksdb_WriteBatchBase__Put");
-    rocksdb_WriteBatchBase__Put(row_info.tx->get_indexed_write_batch(), cf,
-                                row_info.new_pk_slice, value_slice);
+    const auto s =
+        row_info.tx->indexed_put(cf, row_info.new_pk_slice, value_slice);
+    if (!s.ok()) {
+      rc = row_info.tx->set_status_error(table->in_use, s, *m_pk_descr,
+                                         m_tbl_def, m_table_handler);
+    }
   } else {
     const bool assume_tracked = can_assume_tracked(ha_thd());
     const auto s = row_info.tx->put(cf, row_info.new_pk_slice, value_slice,
@@ -12764,8 +13173,12 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
     //                                                      old_key_slice);
     rocksdb_rpc_log(12751,
                     "update_write_sk: rocksdb_WriteBatchBase__SingleDelete");
-    rocksdb_WriteBatchBase__SingleDelete(row_info.tx->get_indexed_write_batch(),
-                                         kd.get_cf(), old_key_slice);
+    const auto s =
+        row_info.tx->indexed_single_delete(kd.get_cf(), old_key_slice);
+    if (!s.ok()) {
+      return row_info.tx->set_status_error(table->in_use, s, kd, m_tbl_def,
+                                           m_table_handler);
+    }
 
     bytes_written = old_key_slice.size();
   }
@@ -12783,8 +13196,12 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
     // row_info.tx->get_indexed_write_batch()->Put(kd.get_cf(), new_key_slice,
     //                                             new_value_slice);
     rocksdb_rpc_log(12770, "update_write_sk: rocksdb_WriteBatchBase__Put");
-    rocksdb_WriteBatchBase__Put(row_info.tx->get_indexed_write_batch(),
-                                kd.get_cf(), new_key_slice, new_value_slice);
+    const auto s = row_info.tx->indexed_put(kd.get_cf(), new_key_slice,
+                                            new_value_slice);
+    if (!s.ok()) {
+      return row_info.tx->set_status_error(table->in_use, s, kd, m_tbl_def,
+                                           m_table_handler);
+    }
   }
 
   row_info.tx->update_bytes_written(bytes_written + new_key_slice.size() +
@@ -13083,8 +13500,13 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
       // m_scan_it = rdb->NewIterator(read_opts, kd.get_cf());
       rocksdb_rpc_log(
           13070, "setup_scan_iterator: rocksdb_TransactionDB__NewIterator");
-      m_scan_it =
-          rocksdb_TransactionDB__NewIterator(rdb, read_opts, kd.get_cf());
+      /*
+        The iterator reads from its own snapshot and does not see writes of
+        the transaction, so what it returned never needs to be refreshed.
+      */
+      m_scan_it = new Rdb_rpc_iterator(
+          rocksdb_TransactionDB__NewIterator(rdb, read_opts, kd.get_cf()),
+          nullptr);
     } else {
       m_scan_it = tx->get_iterator(kd.get_cf(), skip_bloom, fill_cache,
                                    m_scan_it_lower_bound_slice,
@@ -13099,8 +13521,7 @@ void ha_rocksdb::release_scan_iterator() {
   // ALTER
   // delete m_scan_it;
   // m_scan_it = nullptr;
-
-  rocksdb_Iterator__delete(m_scan_it);
+  delete m_scan_it;
   m_scan_it = nullptr;
 
   if (m_scan_it_snapshot) {
@@ -13130,8 +13551,8 @@ void ha_rocksdb::setup_iterator_for_rnd_scan() {
 
   // ALTER
   // m_scan_it->Seek(table_key);
-  rocksdb_rpc_log(13118, "setup_iterator_for_rnd_scan: rocksdb_Iterator__Seek");
-  rocksdb_Iterator__Seek(m_scan_it, table_key);
+  rocksdb_rpc_log(13118, "setup_iterator_for_rnd_scan: Rdb_rpc_iterator::Seek");
+  m_scan_it->Seek(table_key);
   m_skip_scan_it_next_call = true;
   rocksdb_rpc_log(13121, "setup_iterator_for_rnd_scan: end");
 }
@@ -13249,14 +13670,14 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
         // ALTER
         // m_scan_it->Next(); /* this call cannot fail */
         rocksdb_rpc_log(13237,
-                        "rnd_next_with_direction: rocksdb_Iterator__Next");
-        rocksdb_Iterator__Next(m_scan_it);
+                        "rnd_next_with_direction: Rdb_rpc_iterator::Next");
+        m_scan_it->Next();
       } else {
         // ALTER
         // m_scan_it->Prev(); /* this call cannot fail */
         rocksdb_rpc_log(13243,
-                        "rnd_next_with_direction: rocksdb_Iterator__Next");
-        rocksdb_Iterator__Prev(m_scan_it);
+                        "rnd_next_with_direction: Rdb_rpc_iterator::Prev");
+        m_scan_it->Prev();
       }
     }
 
@@ -13269,8 +13690,8 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
 
     // ALTER
     // const rocksdb::Slice key = m_scan_it->key();
-    rocksdb_rpc_log(13258, "rnd_next_with_direction: rocksdb_Iterator__key");
-    const rocksdb::Slice key = rocksdb_Iterator__key(m_scan_it);
+    rocksdb_rpc_log(13258, "rnd_next_with_direction: Rdb_rpc_iterator::key");
+    const rocksdb::Slice key = m_scan_it->key();
     if (!m_pk_descr->covers_key(key)) {
       rc = HA_ERR_END_OF_FILE;
       break;
@@ -13291,7 +13712,7 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
       if (m_pk_descr->has_ttl() &&
           should_hide_ttl_rec(
               *m_pk_descr,
-              /*ALTER m_scan_it->value()*/ rocksdb_Iterator__value(m_scan_it),
+              /*ALTER m_scan_it->value()*/ m_scan_it->value(),
               tx->m_snapshot_timestamp)) {
         continue;
       }
@@ -13323,11 +13744,11 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
       // Use the value from the iterator
 
       rocksdb_rpc_log(13311,
-                      "rnd_next_with_direction: rocksdb_Iterator__value");
+                      "rnd_next_with_direction: Rdb_rpc_iterator::value");
 
       // ALTER
       // rocksdb::Slice value = m_scan_it->value();
-      rocksdb::Slice value = rocksdb_Iterator__value(m_scan_it);
+      rocksdb::Slice value = m_scan_it->value();
 
       if (m_pk_descr->has_ttl() &&
           should_hide_ttl_rec(
@@ -13550,8 +13971,12 @@ int ha_rocksdb::delete_row(const uchar *const buf) {
       // ALTER
       // tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
       //                                             secondary_key_slice);
-      rocksdb_WriteBatchBase__SingleDelete(tx->get_indexed_write_batch(),
-                                           kd.get_cf(), secondary_key_slice);
+      const rocksdb::Status s =
+          tx->indexed_single_delete(kd.get_cf(), secondary_key_slice);
+      if (!s.ok()) {
+        DBUG_RETURN(tx->set_status_error(table->in_use, s, kd, m_tbl_def,
+                                         m_table_handler));
+      }
 
       bytes_written += secondary_key_slice.size();
     }
@@ -16225,11 +16650,9 @@ int ha_rocksdb::inplace_populate_sk(
     for (const auto &kd : indexes) {
       // ALTER
       // const std::string cf_name = kd->get_cf()->GetName();
-      rocksdb_rpc_log(
-          16215, "inplace_populate_sk: rocksdb_ColumnFamilyHandle__GetName");
+      rocksdb_rpc_log(16215, "inplace_populate_sk: rdb_cf_name");
 
-      const std::string cf_name =
-          rocksdb_ColumnFamilyHandle__GetName(kd->get_cf());
+      const std::string cf_name = rdb_cf_name(kd->get_cf());
 
       // ALTER
       // std::shared_ptr<rocksdb::ColumnFamilyHandle> cfh =
@@ -16246,7 +16669,7 @@ int ha_rocksdb::inplace_populate_sk(
 
       // ALTER
       // uint32 cf_id = cfh->GetID();
-      uint32 cf_id = rocksdb_ColumnFamilyHandle__GetID(cfh);
+      uint32 cf_id = rdb_cf_id(cfh);
       if (dict_manager.get_dropped_cf(cf_id)) {
         DBUG_RETURN(HA_EXIT_FAILURE);
       }
@@ -17290,8 +17713,7 @@ void Rdb_background_thread::run() {
     // whereas background writes to the wal file, but issues the syncs in a
     // background thread.
     if (rdb && (rocksdb_flush_log_at_trx_commit != FLUSH_LOG_SYNC) &&
-        !rocksdb_DBOptions__GetBoolOptions(rocksdb_db_options,
-                                           "allow_mmap_writes")) {
+        !rdb_get_db_option_bool(rocksdb_db_options, "allow_mmap_writes")) {
       rocksdb_rpc_log(
           17284, "Rdb_background_thread::run: rocksdb_TransactionDB__FlushWAL");
 
@@ -17630,7 +18052,7 @@ void Rdb_manual_compaction_thread::run() {
     // mcr.mc_id,
     //                       mcr.cf->GetName().c_str());
     sql_print_information("Manual Compaction id %d cf %s started.", mcr.mc_id,
-                          rocksdb_ColumnFamilyHandle__GetName(mcr.cf).c_str());
+                          rdb_cf_name(mcr.cf).c_str());
     if (rocksdb_debug_manual_compaction_delay > 0) {
       my_sleep(rocksdb_debug_manual_compaction_delay * 1000000);
     }
@@ -17670,21 +18092,19 @@ void Rdb_manual_compaction_thread::run() {
       // sql_print_information("Manual Compaction id %d cf %s ended.",
       // mcr.mc_id,
       //                       mcr.cf->GetName().c_str());
-      sql_print_information(
-          "Manual Compaction id %d cf %s ended.", mcr.mc_id,
-          rocksdb_ColumnFamilyHandle__GetName(mcr.cf).c_str());
+      sql_print_information("Manual Compaction id %d cf %s ended.", mcr.mc_id,
+                            rdb_cf_name(mcr.cf).c_str());
       set_state(mcr, Manual_compaction_request::SUCCESS);
     } else {
       // ALTER
       // if (!cf_manager.get_cf(mcr.cf->GetID())) {
-      if (!cf_manager.get_cf(rocksdb_ColumnFamilyHandle__GetID(mcr.cf))) {
+      if (!cf_manager.get_cf(rdb_cf_id(mcr.cf))) {
         // NO_LINT_DEBUG
         // ALTER
         // sql_print_information("cf %s has been dropped",
         //                       mcr.cf->GetName().c_str());
-        sql_print_information(
-            "cf %s has been dropped",
-            rocksdb_ColumnFamilyHandle__GetName(mcr.cf).c_str());
+        sql_print_information("cf %s has been dropped",
+                              rdb_cf_name(mcr.cf).c_str());
 
         set_state(mcr, Manual_compaction_request::SUCCESS);
       } else if (s.IsIncomplete()) {
@@ -17697,8 +18117,7 @@ void Rdb_manual_compaction_thread::run() {
         //     s.getState());
         sql_print_information(
             "Manual Compaction id %d cf %s cancelled. (%d:%d, %s)", mcr.mc_id,
-            rocksdb_ColumnFamilyHandle__GetName(mcr.cf).c_str(), s.code(),
-            s.subcode(), s.getState());
+            rdb_cf_name(mcr.cf).c_str(), s.code(), s.subcode(), s.getState());
 
         // Cancelled
         set_state(mcr, Manual_compaction_request::CANCEL);
@@ -17712,8 +18131,7 @@ void Rdb_manual_compaction_thread::run() {
         //     mcr.cf->GetName().c_str(), s.code(), s.subcode(), s.getState());
         sql_print_information(
             "Manual Compaction id %d cf %s aborted. (%d:%d, %s)", mcr.mc_id,
-            rocksdb_ColumnFamilyHandle__GetName(mcr.cf).c_str(), s.code(),
-            s.subcode(), s.getState());
+            rdb_cf_name(mcr.cf).c_str(), s.code(), s.subcode(), s.getState());
 
         set_state(mcr, Manual_compaction_request::FAILURE);
         if (!s.IsShutdownInProgress()) {
@@ -18223,6 +18641,8 @@ Rdb_ddl_manager *rdb_get_ddl_manager(void) { return &ddl_manager; }
 
 Rdb_binlog_manager *rdb_get_binlog_manager(void) { return &binlog_manager; }
 
+Rdb_rpc_row_cache *rdb_get_rpc_row_cache(void) { return &rpc_row_cache; }
+
 void rocksdb_set_compaction_options(
     my_core::THD *const thd MY_ATTRIBUTE((__unused__)),
     my_core::st_mysql_sys_var *const var MY_ATTRIBUTE((__unused__)),
@@ -18402,6 +18822,17 @@ void rocksdb_set_sst_mgr_rate_bytes_per_sec(
   RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
 }
 
+void rocksdb_set_rpc_row_cache_size(THD *thd, struct st_mysql_sys_var *var,
+                                    void *var_ptr, const void *save) {
+  RDB_MUTEX_LOCK_CHECK(rdb_sysvars_mutex);
+  const uint64_t new_val = *static_cast<const uint64_t *>(save);
+  if (rocksdb_rpc_row_cache_size != new_val) {
+    rocksdb_rpc_row_cache_size = new_val;
+    rpc_row_cache.set_capacity(new_val);
+  }
+  RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
+}
+
 void rocksdb_set_delayed_write_rate(THD *thd, struct st_mysql_sys_var *var,
                                     void *var_ptr, const void *save) {
   rocksdb_rpc_log(182392, "rocksdb_set_delayed_write_rate: start");
@@ -18620,17 +19051,15 @@ static void rocksdb_set_max_background_jobs(THD *thd,
 
   const int new_val = *static_cast<const int *>(save);
 
-  rocksdb_rpc_log(
-      18609,
-      "rocksdb_set_max_background_jobs: rocksdb_DBOptions__GetIntOptions");
+  rocksdb_rpc_log(18609,
+                  "rocksdb_set_max_background_jobs: rdb_get_db_option_int");
 
   // ALTER
   // if (rocksdb_db_options->max_background_jobs != new_val) {
-  if (rocksdb_DBOptions__GetIntOptions(rocksdb_db_options,
-                                       "max_background_jobs") != new_val) {
-    rocksdb_db_options->max_background_jobs = new_val;
-    rocksdb_DBOptions__SetIntOptions(rocksdb_db_options, "max_background_jobs",
-                                     new_val);
+  //   rocksdb_db_options->max_background_jobs = new_val;
+  if (rdb_get_db_option_int(rocksdb_db_options, "max_background_jobs") !=
+      new_val) {
+    rdb_set_db_option_int(rocksdb_db_options, "max_background_jobs", new_val);
     // ALTER
     // rocksdb::Status s =
     //     rdb->SetDBOptions({{"max_background_jobs",
@@ -18664,12 +19093,12 @@ static void rocksdb_set_max_background_compactions(
   const int new_val = *static_cast<const int *>(save);
 
   // ALTER
-  if (rocksdb_DBOptions__GetIntOptions(
-          rocksdb_db_options, "max_background_compactions") != new_val) {
+  if (rdb_get_db_option_int(rocksdb_db_options,
+                            "max_background_compactions") != new_val) {
     // ALTER
     // rocksdb_db_options->max_background_compactions = new_val;
-    rocksdb_DBOptions__SetIntOptions(rocksdb_db_options,
-                                     "max_background_compactions", new_val);
+    rdb_set_db_option_int(rocksdb_db_options, "max_background_compactions",
+                          new_val);
 
     // ALTER
     // rocksdb::Status s = rdb->SetDBOptions(
@@ -18760,10 +19189,9 @@ static void rocksdb_set_bytes_per_sync(
   // ALTER
   // if (rocksdb_db_options->bytes_per_sync != new_val) {
   //   rocksdb_db_options->bytes_per_sync = new_val;
-  if (rocksdb_DBOptions__GetUInt64Options(rocksdb_db_options,
-                                          "bytes_per_sync") != new_val) {
-    rocksdb_DBOptions__SetUInt64Options(rocksdb_db_options, "bytes_per_sync",
-                                        new_val);
+  if (rdb_get_db_option_uint64(rocksdb_db_options, "bytes_per_sync") !=
+      new_val) {
+    rdb_set_db_option_uint64(rocksdb_db_options, "bytes_per_sync", new_val);
     rocksdb::Status s = rocksdb_TransactionDB__SetDBOptions(
         rdb, {{"bytes_per_sync", std::to_string(new_val)}});
 
@@ -18798,10 +19226,10 @@ static void rocksdb_set_wal_bytes_per_sync(
   // if (rocksdb_db_options->wal_bytes_per_sync != new_val) {
   //   rocksdb_db_options->wal_bytes_per_sync = new_val;
 
-  if (rocksdb_DBOptions__GetUInt64Options(rocksdb_db_options,
-                                          "wal_bytes_per_sync") != new_val) {
-    rocksdb_DBOptions__SetUInt64Options(rocksdb_db_options,
-                                        "wal_bytes_per_sync", new_val);
+  if (rdb_get_db_option_uint64(rocksdb_db_options, "wal_bytes_per_sync") !=
+      new_val) {
+    rdb_set_db_option_uint64(rocksdb_db_options, "wal_bytes_per_sync",
+                             new_val);
     rocksdb::Status s = rocksdb_TransactionDB__SetDBOptions(
         rdb, {{"wal_bytes_per_sync", std::to_string(new_val)}});
 
@@ -18916,9 +19344,7 @@ static int rocksdb_validate_update_cf_options(
       }
 
       if (cf_manager.create_cf_flags_if_needed(
-              &dict_manager,
-              /*ALTER cfh->GetID()*/ rocksdb_ColumnFamilyHandle__GetID(cfh),
-              cf_name)) {
+              &dict_manager, /*ALTER cfh->GetID()*/ rdb_cf_id(cfh), cf_name)) {
         rocksdb_rpc_log(18907, "rocksdb_validate_update_cf_options: end");
 
         return HA_EXIT_FAILURE;
@@ -19226,6 +19652,10 @@ get_select_bypass_multiget_min() {
   return rocksdb_select_bypass_multiget_min;
 }
 
+bool should_filter_rpc_scan_keys(THD *const thd) {
+  return THDVAR(thd, rpc_scan_key_filter);
+}
+
 // ALTER
 // const rocksdb::ReadOptions &rdb_tx_acquire_snapshot(Rdb_transaction *tx) {
 //   tx->acquire_snapshot(true);
@@ -19240,7 +19670,7 @@ rocksdb::ReadOptions *rdb_tx_acquire_snapshot(Rdb_transaction *tx) {
   return tx->m_read_opts;
 }
 
-rocksdb::Iterator *rdb_tx_get_iterator(
+Rdb_rpc_iterator *rdb_tx_get_iterator(
     Rdb_transaction *tx, rocksdb::ColumnFamilyHandle *const column_family,
     bool skip_bloom_filter, bool fill_cache,
     const rocksdb::Slice &lower_bound_slice,
@@ -19894,5 +20324,7 @@ mysql_declare_plugin(rocksdb_rpc_se){
     myrocks_rpc::rdb_rpc_i_s_sst_props, myrocks_rpc::rdb_rpc_i_s_index_file_map,
     myrocks_rpc::rdb_rpc_i_s_lock_info, myrocks_rpc::rdb_rpc_i_s_trx_info,
     myrocks_rpc::rdb_rpc_i_s_deadlock_info,
-    myrocks_rpc::rdb_rpc_i_s_bypass_rejected_query_history
+    myrocks_rpc::rdb_rpc_i_s_bypass_rejected_query_history,
+    myrocks_rpc::rdb_rpc_i_s_row_cache,
+    myrocks_rpc::rdb_rpc_i_s_call_stats
     mysql_declare_plugin_end;
\ No newline at end of file
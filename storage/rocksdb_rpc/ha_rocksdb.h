@@ -49,6 +49,8 @@
 #include "./rdb_index_merge.h"
 #include "./rdb_io_watchdog.h"
 #include "./rdb_perf_context.h"
+#include "./rdb_rpc_batch.h"
+#include "./rdb_rpc_iterator.h"
 #include "./rdb_sst_info.h"
 #include "./rdb_utils.h"
 
@@ -145,7 +147,7 @@ class ha_rocksdb : public my_core::handler {
   Rdb_table_handler *m_table_handler;  ///< Open table handler
 
   /* Iterator used for range scans and for full table/index scans */
-  rocksdb::Iterator *m_scan_it;
+  Rdb_rpc_iterator *m_scan_it;
 
   /* Whether m_scan_it was created with skip_bloom=true */
   bool m_scan_it_skips_bloom;
@@ -794,7 +796,7 @@ class ha_rocksdb : public my_core::handler {
                            const int64_t curr_ts)
       MY_ATTRIBUTE((__warn_unused_result__));
   int rocksdb_skip_expired_records(const Rdb_key_def &kd,
-                                   rocksdb::Iterator *const iter,
+                                   Rdb_rpc_iterator *const iter,
                                    bool seek_backward);
 
   int index_first_intern(uchar *buf)
@@ -845,7 +847,7 @@ class ha_rocksdb : public my_core::handler {
                            const bool pk_changed)
       MY_ATTRIBUTE((__warn_unused_result__));
 
-  int read_key_exact(const Rdb_key_def &kd, rocksdb::Iterator *const iter,
+  int read_key_exact(const Rdb_key_def &kd, Rdb_rpc_iterator *const iter,
                      const bool using_full_key, const rocksdb::Slice &key_slice,
                      const int64_t ttl_filter_ts)
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
@@ -1139,13 +1141,16 @@ uint32_t get_select_bypass_debug_row_delay();
 unsigned long long  // NOLINT(runtime/int)
 get_select_bypass_multiget_min();
 
+/* Whether scans may skip rows on key conditions before fetching values */
+bool should_filter_rpc_scan_keys(THD *const thd);
+
 Rdb_transaction *&get_tx_from_thd(THD *const thd);
 
 // ALTER
 // const rocksdb::ReadOptions &rdb_tx_acquire_snapshot(Rdb_transaction *tx);
 rocksdb::ReadOptions *rdb_tx_acquire_snapshot(Rdb_transaction *tx);
 
-rocksdb::Iterator *rdb_tx_get_iterator(
+Rdb_rpc_iterator *rdb_tx_get_iterator(
     Rdb_transaction *tx, rocksdb::ColumnFamilyHandle *const column_family,
     bool skip_bloom, bool fill_cache, const rocksdb::Slice &lower_bound_slice,
     const rocksdb::Slice &upper_bound_slice, bool read_current = false,
@@ -1189,10 +1194,29 @@ inline void rocksdb_smart_next(bool seek_backward,
   }
 }
 
+inline void rocksdb_smart_seek(bool seek_backward, Rdb_rpc_iterator *const iter,
+                               const rocksdb::Slice &key_slice) {
+  if (seek_backward) {
+    iter->SeekForPrev(key_slice);
+  } else {
+    iter->Seek(key_slice);
+  }
+}
+
+inline void rocksdb_smart_next(bool seek_backward,
+                               Rdb_rpc_iterator *const iter) {
+  if (seek_backward) {
+    iter->Prev();
+  } else {
+    iter->Next();
+  }
+}
+
 // If the iterator is not valid it might be because of EOF but might be due
 // to IOError or corruption. The good practice is always check it.
 // https://github.com/facebook/rocksdb/wiki/Iterator#error-handling
 bool is_valid_iterator(rocksdb::Iterator *scan_it);
+bool is_valid_iterator(Rdb_rpc_iterator *scan_it);
 
 bool rdb_tx_started(Rdb_transaction *tx);
 
@@ -112,4 +112,8 @@ Rdb_ddl_manager *rdb_get_ddl_manager(void)
 class Rdb_binlog_manager;
 Rdb_binlog_manager *rdb_get_binlog_manager(void)
     MY_ATTRIBUTE((__warn_unused_result__));
+
+class Rdb_rpc_row_cache;
+Rdb_rpc_row_cache *rdb_get_rpc_row_cache(void)
+    MY_ATTRIBUTE((__warn_unused_result__));
 }  // namespace myrocks_rpc
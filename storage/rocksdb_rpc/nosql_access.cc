@@ -637,6 +637,7 @@ class select_exec {
     m_start_inclusive = m_end_inclusive = true;
     m_unsupported = false;
     m_error_msg = "UNKNOWN";
+    m_filter_scan_keys = false;
 
     m_lookup_bitmap = {nullptr, 0, 0, nullptr, nullptr};
   }
@@ -666,10 +667,10 @@ class select_exec {
       return false;
     }
 
-    rocksdb::Iterator *get_iterator(rocksdb::ColumnFamilyHandle *cf,
-                                    bool use_bloom,
-                                    const rocksdb::Slice &lower_bound,
-                                    const rocksdb::Slice &upper_bound) {
+    Rdb_rpc_iterator *get_iterator(rocksdb::ColumnFamilyHandle *cf,
+                                   bool use_bloom,
+                                   const rocksdb::Slice &lower_bound,
+                                   const rocksdb::Slice &upper_bound) {
       return rdb_tx_get_iterator(m_tx, cf, !use_bloom, true /* fill_cache */,
                                  lower_bound, upper_bound);
     }
@@ -744,6 +745,10 @@ class select_exec {
   bool send_row();
 
   bool setup_iterator(txn_wrapper *txn, const rocksdb::Slice &eq_slice);
+  void build_scan_filter();
+  void add_key_filter(uint key_part_no, size_t offset, const sql_cond &cond);
+  bool pack_filter_operand(uint key_part_no, const Field *field, Item *item,
+                           std::string *operand);
 
   bool handle_killed() {
     if (m_thd->killed) {
@@ -785,9 +790,11 @@ class select_exec {
   std::vector<std::pair<int, int>> m_field_index_to_where;
 
   // The iterator used in secondary index query or range query
-  // ALTER
-  // std::unique_ptr<rocksdb::Iterator> m_scan_it;
-  rocksdb::Iterator *m_scan_it;
+  std::unique_ptr<Rdb_rpc_iterator> m_scan_it;
+
+  // Key filter the scan iterator applies for range queries
+  bool m_filter_scan_keys;
+  Rdb_rpc_scan_filter m_scan_filter;
 
   // The entire index (including extended keyparts) is used in query in equality
   // predicates - meaning it is a point query
@@ -1359,6 +1366,8 @@ bool INLINE_ATTR select_exec::run() {
   // Scan the value and devise a strategy to unpack the values
   scan_value();
 
+  build_scan_filter();
+
   // Prepare to send
   if (m_protocol->send_result_set_metadata(
           &m_parser.get_select_lex()->item_list,
@@ -1556,18 +1565,174 @@ bool INLINE_ATTR select_exec::setup_iterator(txn_wrapper *txn,
       m_thd, *m_key_def, eq_slice, m_is_point_query, bound_len,
       m_lower_bound_buf.data(), m_upper_bound_buf.data(), &m_lower_bound_slice,
       &m_upper_bound_slice);
-  rocksdb::Iterator *it = txn->get_iterator(
+  Rdb_rpc_iterator *it = txn->get_iterator(
       m_key_def->get_cf(), use_bloom, m_lower_bound_slice, m_upper_bound_slice);
   if (it == nullptr) {
     return true;
   }
-  // ALTER
-  // m_scan_it.reset(it);
-  m_scan_it = it;
+  m_scan_it.reset(it);
+
+  return false;
+}
+
+/*
+  Pack the operand of a filter on a key part the way the key stores the
+  column, so that the iterator can compare it with the key bytes. Only
+  operands whose image orders like the value compares with the column are
+  packed: integers within the range of the column and strings that fit in
+  it. Returns true if the operand cannot be packed.
+ */
+bool select_exec::pack_filter_operand(uint key_part_no, const Field *field,
+                                      Item *item, std::string *operand) {
+  switch (field->type()) {
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_TINY: {
+      if (item->type() != Item::INT_ITEM) {
+        return true;
+      }
+      const longlong val = item->val_int();
+      // An unsigned value above LONGLONG_MAX
+      const bool huge = item->unsigned_flag && val < 0;
+      const uint bits = field->pack_length() * 8;
+      bool fits;
+      if (field->flags & UNSIGNED_FLAG) {
+        fits = (bits == 64) ? (huge || val >= 0)
+                            : (val >= 0 && val < (1LL << bits));
+      } else {
+        fits = !huge && (bits == 64 || (val >= -(1LL << (bits - 1)) &&
+                                        val < (1LL << (bits - 1))));
+      }
+      if (!fits) {
+        return true;
+      }
+      break;
+    }
+    case MYSQL_TYPE_STRING: {
+      if (item->type() != Item::STRING_ITEM) {
+        return true;
+      }
+      // Longer strings would be cut by strnxfrm and compare differently
+      const CHARSET_INFO *const charset = field->charset();
+      String str;
+      const String *const res = item->val_str(&str);
+      if (res == nullptr ||
+          charset->cset->numchars(charset, res->ptr(),
+                                  res->ptr() + res->length()) >
+              static_cast<const Field_string *>(field)->char_length()) {
+        return true;
+      }
+      break;
+    }
+    default:
+      return true;
+  }
 
+  Rdb_string_writer writer;
+  if (pack_index_tuple(key_part_no, &writer, field, item)) {
+    return true;
+  }
+  const rocksdb::Slice packed = writer.to_slice();
+  operand->assign(packed.data(), packed.size());
   return false;
 }
 
+void select_exec::add_key_filter(uint key_part_no, size_t offset,
+                                 const sql_cond &cond) {
+  const auto func = static_cast<Item_func *>(cond.cond_item);
+  const auto args = func->arguments();
+  // For 5 < A the operator applies with the operands swapped
+  const bool field_first = (args[0]->type() == Item::FIELD_ITEM);
+
+  Rdb_rpc_cmp_op op;
+  switch (cond.op_type) {
+    case Item_func::EQ_FUNC:
+      op = Rdb_rpc_cmp_op::EQ;
+      break;
+    case Item_func::IN_FUNC:
+      op = Rdb_rpc_cmp_op::IN;
+      break;
+    case Item_func::LT_FUNC:
+      op = field_first ? Rdb_rpc_cmp_op::LT : Rdb_rpc_cmp_op::GT;
+      break;
+    case Item_func::LE_FUNC:
+      op = field_first ? Rdb_rpc_cmp_op::LE : Rdb_rpc_cmp_op::GE;
+      break;
+    case Item_func::GT_FUNC:
+      op = field_first ? Rdb_rpc_cmp_op::GT : Rdb_rpc_cmp_op::LT;
+      break;
+    case Item_func::GE_FUNC:
+      op = field_first ? Rdb_rpc_cmp_op::GE : Rdb_rpc_cmp_op::LE;
+      break;
+    default:
+      return;
+  }
+
+  const size_t length = m_key_def->get_pack_info(key_part_no)->m_max_image_len;
+  std::vector<std::string> operands;
+  if (op == Rdb_rpc_cmp_op::IN) {
+    // arg0 is the field
+    for (uint i = 1; i < func->argument_count(); ++i) {
+      operands.emplace_back();
+      if (pack_filter_operand(key_part_no, cond.field, args[i],
+                              &operands.back())) {
+        return;
+      }
+    }
+  } else {
+    operands.emplace_back();
+    if (pack_filter_operand(key_part_no, cond.field, cond.val_item,
+                            &operands.back())) {
+      return;
+    }
+  }
+
+  for (const auto &operand : operands) {
+    if (operand.size() != length) {
+      return;
+    }
+  }
+  m_scan_filter.add_key_predicate(offset, length, op, std::move(operands));
+}
+
+/*
+  Build the key filter the scan iterator applies to range queries from the
+  filters on key parts that sit at a fixed position in the key. Filters are
+  still evaluated on the rows that come back, so anything that cannot be
+  turned into a key predicate safely is simply left out.
+ */
+void select_exec::build_scan_filter() {
+  m_scan_filter.clear();
+  m_filter_scan_keys = should_filter_rpc_scan_keys(m_thd);
+  if (!m_filter_scan_keys) {
+    return;
+  }
+
+  auto where_list = m_parser.get_cond_list();
+  for (uint i = 0; i < m_filter_count; ++i) {
+    const sql_cond &cond = where_list[m_filter_list[i]];
+    size_t offset = Rdb_key_def::INDEX_NUMBER_SIZE;
+    for (uint kp = 0; kp < m_index_info->actual_key_parts; ++kp) {
+      // Parts after a nullable or variable length one have no fixed offset
+      const Rdb_field_packing *const fpi = m_key_def->get_pack_info(kp);
+      if (fpi->m_field_maybe_null ||
+          fpi->m_skip_func != Rdb_key_def::skip_max_length) {
+        break;
+      }
+
+      const KEY_PART_INFO &key_part = m_index_info->key_part[kp];
+      if (key_part.field->field_index == cond.field->field_index) {
+        if (!(key_part.key_part_flag & HA_PART_KEY_SEG)) {
+          add_key_filter(kp, offset, cond);
+        }
+        break;
+      }
+      offset += fpi->m_max_image_len;
+    }
+  }
+}
+
 bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
   for (auto &writer : m_key_index_tuples) {
     if (unlikely(handle_killed())) {
@@ -1578,32 +1743,20 @@ bool INLINE_ATTR select_exec::run_sk_point_query(txn_wrapper *txn) {
     if (unlikely(setup_iterator(txn, key_slice))) {
       return true;
     }
-    // ALTER
-    // m_scan_it->Seek(key_slice);
-    rocksdb_Iterator__Seek(m_scan_it, key_slice);
+    m_scan_it->Seek(key_slice);
 
-    // ALTER
-    // if (!is_valid_iterator(m_scan_it.get())) {
-    //   continue;
-    // }
-    if (!is_valid_iterator(m_scan_it)) {
+    if (!is_valid_iterator(m_scan_it.get())) {
       continue;
     }
 
-    // ALTER
-    // auto rkey_slice = m_scan_it->key();
-    auto rkey_slice = rocksdb_Iterator__key(m_scan_it);
+    auto rkey_slice = m_scan_it->key();
 
     if (rkey_slice.size() < key_slice.size() ||
         memcmp(rkey_slice.data(), key_slice.data(), key_slice.size()) != 0) {
       continue;
     }
 
-    // ALTER
-    // if (unpack_for_sk(txn, rkey_slice, m_scan_it->value())) {
-    //   return true;
-    // }
-    if (unpack_for_sk(txn, rkey_slice, rocksdb_Iterator__value(m_scan_it))) {
+    if (unpack_for_sk(txn, rkey_slice, m_scan_it->value())) {
       return true;
     }
 
@@ -1854,9 +2007,17 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
       return true;
     }
 
-    // ALTER
-    // rocksdb_smart_seek(reverse_seek, m_scan_it.get(), initial_pos_slice);
-    rocksdb_smart_seek(reverse_seek, m_scan_it, initial_pos_slice);
+    if (m_filter_scan_keys) {
+      // The iterator ends the scan where the loop below stops
+      if (end_key_slice.empty()) {
+        m_scan_filter.clear_stop_key();
+      } else {
+        m_scan_filter.set_stop_key(end_pos_slice, !m_parser.is_order_desc());
+      }
+      m_scan_it->set_scan_filter(m_scan_filter);
+    }
+
+    rocksdb_smart_seek(reverse_seek, m_scan_it.get(), initial_pos_slice);
 
     // Make sure the slice is alive as we'll point into the slice during
     // unpacking
@@ -1865,17 +2026,11 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
         return true;
       }
 
-      // ALTER
-      // if (unlikely(!is_valid_iterator(m_scan_it.get()))) {
-      //   break;
-      // }
-      if (unlikely(!is_valid_iterator(m_scan_it))) {
+      if (unlikely(!is_valid_iterator(m_scan_it.get()))) {
         break;
       }
 
-      // ALTER
-      // const rocksdb::Slice rkey = m_scan_it->key();
-      const rocksdb::Slice rkey = rocksdb_Iterator__key(m_scan_it);
+      const rocksdb::Slice rkey = m_scan_it->key();
 
       if (end_key_slice.empty()) {
         // No end - we stop when prefix no longer matches
@@ -1902,9 +2057,7 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
       // skipping the first N items in LIMIT, but this is low priority
       // for now
 
-      // ALTER
-      // const rocksdb::Slice rvalue = m_scan_it->value();
-      const rocksdb::Slice rvalue = rocksdb_Iterator__value(m_scan_it);
+      const rocksdb::Slice rvalue = m_scan_it->value();
 
       if (m_index_is_pk) {
         if (unlikely(unpack_for_pk(rkey, rvalue))) {
@@ -1925,9 +2078,7 @@ bool INLINE_ATTR select_exec::run_range_query(txn_wrapper *txn) {
         return false;
       }
 
-      // ALTER
-      // rocksdb_smart_next(reverse_seek, m_scan_it.get());
-      rocksdb_smart_next(reverse_seek, m_scan_it);
+      rocksdb_smart_next(reverse_seek, m_scan_it.get());
 
     }  // while (true)
   }    // for m_key_index_tuples
@@ -61,8 +61,8 @@ void Rdb_cf_manager::init(
     // std::shared_ptr<rocksdb::ColumnFamilyHandle> cfh(cfh_ptr);
     // m_cf_name_map[cfh_ptr->GetName()] = cfh;
     // m_cf_id_map[cfh_ptr->GetID()] = cfh;
-    m_cf_name_map[rocksdb_ColumnFamilyHandle__GetName(cfh_ptr)] = cfh_ptr;
-    m_cf_id_map[rocksdb_ColumnFamilyHandle__GetID(cfh_ptr)] = cfh_ptr;
+    m_cf_name_map[rdb_cf_name(cfh_ptr)] = cfh_ptr;
+    m_cf_id_map[rdb_cf_id(cfh_ptr)] = cfh_ptr;
   }
 }
 
@@ -147,8 +147,8 @@ rocksdb::ColumnFamilyHandle *Rdb_cf_manager::get_or_create_cf(
       // cf_handle.reset(cf_handle_ptr);
       // m_cf_name_map[cf_handle_ptr->GetName()] = cf_handle;
       // m_cf_id_map[cf_handle_ptr->GetID()] = cf_handle;
-      std::string name = rocksdb_ColumnFamilyHandle__GetName(cf_handle_ptr);
-      auto id = rocksdb_ColumnFamilyHandle__GetID(cf_handle_ptr);
+      std::string name = rdb_cf_name(cf_handle_ptr);
+      auto id = rdb_cf_id(cf_handle_ptr);
       std::cout << "line 148 ******** cf id and name: " << name << " " << id
                 << std::endl;
       cf_handle_ = cf_handle_ptr;
@@ -272,7 +272,7 @@ int Rdb_cf_manager::remove_dropped_cf(Rdb_dict_manager *const dict_manager,
   // auto cf_handle = it->second.get();
   // const std::string cf_name = cf_handle->GetName();
   auto cf_handle = it->second;
-  const std::string cf_name = rocksdb_ColumnFamilyHandle__GetName(cf_handle);
+  const std::string cf_name = rdb_cf_name(cf_handle);
 
   if (!dict_manager->get_dropped_cf(cf_id)) {
     RDB_MUTEX_UNLOCK_CHECK(m_mutex);
@@ -321,6 +321,8 @@ int Rdb_cf_manager::remove_dropped_cf(Rdb_dict_manager *const dict_manager,
   DBUG_ASSERT(name_iter != m_cf_name_map.end());
   m_cf_name_map.erase(name_iter);
 
+  rdb_get_rpc_handle_cache().remove_cf(cf_handle);
+
   dict_manager->delete_dropped_cf_and_flags(batch, cf_id);
 
   dict_manager->commit(batch);
@@ -350,7 +352,7 @@ struct Rdb_cf_scanner : public Rdb_tables_scanner {
       // if (kd.get_cf()->GetID() == m_cf_id) {
       //   return HA_EXIT_FAILURE;
       // }
-      if (rocksdb_ColumnFamilyHandle__GetID(kd.get_cf()) == m_cf_id) {
+      if (rdb_cf_id(kd.get_cf()) == m_cf_id) {
         return HA_EXIT_FAILURE;
       }
     }
@@ -394,7 +396,7 @@ int Rdb_cf_manager::drop_cf(Rdb_ddl_manager *const ddl_manager,
 
   // ALTER
   // cf_id = cf_handle->GetID();
-  cf_id = rocksdb_ColumnFamilyHandle__GetID(cf_handle);
+  cf_id = rdb_cf_id(cf_handle);
 
   Rdb_cf_scanner scanner(cf_id);
 
@@ -3527,7 +3527,7 @@ bool Rdb_tbl_def::put_dict(Rdb_dict_manager *const dict,
 
     // ALTER
     // const uint cf_id = kd.get_cf()->GetID();
-    const uint cf_id = rocksdb_ColumnFamilyHandle__GetID(kd.get_cf());
+    const uint cf_id = rdb_cf_id(kd.get_cf());
 
     /*
       If cf_id already exists, cf_flags must be the same.
@@ -3538,8 +3538,7 @@ bool Rdb_tbl_def::put_dict(Rdb_dict_manager *const dict,
     */
     // ALTER
     // const std::string cf_name = kd.get_cf()->GetName();
-    const std::string cf_name =
-        rocksdb_ColumnFamilyHandle__GetName(kd.get_cf());
+    const std::string cf_name = rdb_cf_name(kd.get_cf());
 
     // ALTER
     // std::shared_ptr<rocksdb::ColumnFamilyHandle> cfh =
@@ -3723,8 +3722,7 @@ int Rdb_ddl_manager::find_in_uncommitted_keydef(const uint32_t &cf_id) {
     const auto &kd = pr.second;
 
     // ALTER
-    if (/*kd->get_cf()->GetID()*/ rocksdb_ColumnFamilyHandle__GetID(
-            kd->get_cf()) == cf_id) {
+    if (/*kd->get_cf()->GetID()*/ rdb_cf_id(kd->get_cf()) == cf_id) {
       mysql_rwlock_unlock(&m_rwlock);
       return HA_EXIT_FAILURE;
     }
@@ -4885,10 +4883,8 @@ bool Rdb_dict_manager::init(rocksdb::TransactionDB *const rdb_dict,
   // ALTER
   // add_cf_flags(batch, m_system_cfh->GetID(), 0);
   // add_cf_flags(batch, default_cfh->GetID(), 0);
-  rocksdb_rpc_log(4860,
-                  "Rdb_dict_manager::init: rocksdb_ColumnFamilyHandle__GetID");
-  add_cf_flags(batch, rocksdb_ColumnFamilyHandle__GetID(m_system_cfh), 0);
-  add_cf_flags(batch, rocksdb_ColumnFamilyHandle__GetID(default_cfh), 0);
+  add_cf_flags(batch, rdb_cf_id(m_system_cfh), 0);
+  add_cf_flags(batch, rdb_cf_id(default_cfh), 0);
   commit(batch);
   rocksdb_rpc_log(4866, "Rdb_dict_manager::init: add_missing_cf_flags");
 
@@ -5370,8 +5366,8 @@ int Rdb_dict_manager::add_missing_cf_flags(
         5328,
         "Rdb_dict_manager::add_missing_cf_flags: create_cf_flags_if_needed");
 
-    if (cf_manager->create_cf_flags_if_needed(
-            this, rocksdb_ColumnFamilyHandle__GetID(cfh), cf_name)) {
+    if (cf_manager->create_cf_flags_if_needed(this, rdb_cf_id(cfh),
+                                              cf_name)) {
       return HA_EXIT_FAILURE;
     }
   }
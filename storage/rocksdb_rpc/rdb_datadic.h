@@ -34,6 +34,7 @@
 #include "./ha_rocksdb.h"
 #include "./properties_collector.h"
 #include "./rdb_buff.h"
+#include "./rdb_rpc_batch.h"
 #include "./rdb_utils.h"
 #include "rpcclient.hpp"
 
@@ -403,8 +404,7 @@ class Rdb_key_def {
   uint32 get_index_number() const { return m_index_number; }
 
   GL_INDEX_ID get_gl_index_id() const {
-    const GL_INDEX_ID gl_index_id = {
-        rocksdb_ColumnFamilyHandle__GetID(m_cf_handle), m_index_number};
+    const GL_INDEX_ID gl_index_id = {rdb_cf_id(m_cf_handle), m_index_number};
     return gl_index_id;
   }
 
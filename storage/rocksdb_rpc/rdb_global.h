@@ -61,6 +61,26 @@ struct Rdb_trx_info {
 
 std::vector<Rdb_trx_info> rdb_get_all_trx_info();
 
+/*
+ * class for exporting RPC call statistics for
+ * information_schema.rocksdb_rpc_call_stats
+ */
+struct Rdb_rpc_call_stats_info {
+  std::string scope;
+  ulong thread_id;
+  std::string call_site;
+  std::string method;
+  ulonglong calls;
+  ulonglong errors;
+  ulonglong total_us;
+  ulonglong p50_us;
+  ulonglong p95_us;
+  ulonglong p99_us;
+  ulonglong max_us;
+};
+
+std::vector<Rdb_rpc_call_stats_info> rdb_get_rpc_call_stats();
+
 /*
  * class for exporting deadlock transaction information for
  * information_schema.rocksdb_deadlock
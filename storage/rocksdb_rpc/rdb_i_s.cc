@@ -40,6 +40,7 @@
 #include "./nosql_access.h"
 #include "./rdb_cf_manager.h"
 #include "./rdb_datadic.h"
+#include "./rdb_rpc_row_cache.h"
 #include "./rdb_utils.h"
 
 #include "rpcclient.hpp"
@@ -856,7 +857,7 @@ static int rdb_i_s_global_info_fill_table(
     DBUG_EXECUTE_IF("information_schema_global_info", {
       // ALTER
       // if (cf_handle->GetName() == "cf_primary_key") {
-      if (rocksdb_ColumnFamilyHandle__GetName(cf_handle) == "cf_primary_key") {
+      if (rdb_cf_name(cf_handle) == "cf_primary_key") {
         const char act[] =
             "now signal ready_to_mark_cf_dropped_in_global_info "
             "wait_for mark_cf_dropped_done_in_global_info";
@@ -865,8 +866,8 @@ static int rdb_i_s_global_info_fill_table(
     });
 
     uint flags;
-    uint32_t cf_handle_id = rocksdb_ColumnFamilyHandle__GetID(cf_handle);
-    std::string cf_handle_name = rocksdb_ColumnFamilyHandle__GetName(cf_handle);
+    uint32_t cf_handle_id = rdb_cf_id(cf_handle);
+    std::string cf_handle_name = rdb_cf_name(cf_handle);
     // ALTER
     // if (!dict_manager->get_cf_flags(cf_handle->GetID(), &flags)) {
     if (!dict_manager->get_cf_flags(cf_handle_id, &flags)) {
@@ -1128,7 +1129,7 @@ int Rdb_ddl_scanner::add_table(Rdb_tbl_def *tdef) {
 
     // ALTER
     // std::string cf_name = kd.get_cf()->GetName();
-    std::string cf_name = rocksdb_ColumnFamilyHandle__GetName(kd.get_cf());
+    std::string cf_name = rdb_cf_name(kd.get_cf());
 
     field[RDB_DDL_FIELD::CF]->store(cf_name.c_str(), cf_name.size(),
                                     system_charset_info);
@@ -1944,6 +1945,165 @@ static int rdb_i_s_deadlock_info_init(void *const p) {
   DBUG_RETURN(0);
 }
 
+/*
+  Support for INFORMATION_SCHEMA.ROCKSDB_RPC_ROW_CACHE dynamic table
+ */
+namespace RDB_ROW_CACHE_FIELD {
+enum { STAT_TYPE = 0, VALUE };
+}  // namespace RDB_ROW_CACHE_FIELD
+
+static ST_FIELD_INFO rdb_i_s_row_cache_fields_info[] = {
+    ROCKSDB_FIELD_INFO("STAT_TYPE", NAME_LEN + 1, MYSQL_TYPE_STRING, 0),
+    ROCKSDB_FIELD_INFO("VALUE", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO_END};
+
+static int rdb_i_s_row_cache_fill_table(
+    my_core::THD *const thd, my_core::TABLE_LIST *const tables,
+    my_core::Item *const cond MY_ATTRIBUTE((__unused__))) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(tables != nullptr);
+  DBUG_ASSERT(tables->table != nullptr);
+  DBUG_ASSERT(tables->table->field != nullptr);
+
+  Rdb_rpc_row_cache_stats stats;
+  rdb_get_rpc_row_cache()->get_stats(&stats);
+
+  const std::vector<std::pair<const char *, ulonglong>> values = {
+      {"HITS", stats.m_hits},
+      {"MISSES", stats.m_misses},
+      {"INSERTS", stats.m_inserts},
+      {"INSERTS_REJECTED", stats.m_insert_rejects},
+      {"INVALIDATIONS", stats.m_invalidations},
+      {"EVICTIONS", stats.m_evictions},
+      {"ENTRIES", stats.m_entries},
+      {"USAGE", stats.m_usage},
+      {"CAPACITY", stats.m_capacity}};
+
+  int ret = 0;
+  for (const auto &value : values) {
+    tables->table->field[RDB_ROW_CACHE_FIELD::STAT_TYPE]->store(
+        value.first, strlen(value.first), system_charset_info);
+    tables->table->field[RDB_ROW_CACHE_FIELD::VALUE]->store(value.second,
+                                                            true);
+
+    ret = static_cast<int>(
+        my_core::schema_table_store_record(thd, tables->table));
+
+    if (ret) {
+      break;
+    }
+  }
+
+  DBUG_RETURN(ret);
+}
+
+static int rdb_i_s_row_cache_init(void *const p) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(p != nullptr);
+
+  my_core::ST_SCHEMA_TABLE *schema;
+
+  schema = (my_core::ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info = rdb_i_s_row_cache_fields_info;
+  schema->fill_table = rdb_i_s_row_cache_fill_table;
+
+  DBUG_RETURN(0);
+}
+
+/*
+  Support for INFORMATION_SCHEMA.ROCKSDB_RPC_CALL_STATS dynamic table
+ */
+namespace RDB_RPC_CALL_STATS_FIELD {
+enum {
+  SCOPE = 0,
+  THREAD_ID,
+  CALL_SITE,
+  METHOD,
+  CALLS,
+  ERRORS,
+  TOTAL_US,
+  P50_US,
+  P95_US,
+  P99_US,
+  MAX_US
+};
+}  // namespace RDB_RPC_CALL_STATS_FIELD
+
+static ST_FIELD_INFO rdb_i_s_rpc_call_stats_fields_info[] = {
+    ROCKSDB_FIELD_INFO("SCOPE", NAME_LEN + 1, MYSQL_TYPE_STRING, 0),
+    ROCKSDB_FIELD_INFO("THREAD_ID", sizeof(ulong), MYSQL_TYPE_LONG, 0),
+    ROCKSDB_FIELD_INFO("CALL_SITE", NAME_LEN + 1, MYSQL_TYPE_STRING, 0),
+    ROCKSDB_FIELD_INFO("METHOD", NAME_LEN + 1, MYSQL_TYPE_STRING, 0),
+    ROCKSDB_FIELD_INFO("CALLS", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("ERRORS", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("TOTAL_US", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("P50_US", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("P95_US", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("P99_US", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO("MAX_US", sizeof(uint64_t), MYSQL_TYPE_LONGLONG, 0),
+    ROCKSDB_FIELD_INFO_END};
+
+static int rdb_i_s_rpc_call_stats_fill_table(
+    my_core::THD *const thd, my_core::TABLE_LIST *const tables,
+    my_core::Item *const cond MY_ATTRIBUTE((__unused__))) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(thd != nullptr);
+  DBUG_ASSERT(tables != nullptr);
+  DBUG_ASSERT(tables->table != nullptr);
+  DBUG_ASSERT(tables->table->field != nullptr);
+
+  int ret = 0;
+  const std::vector<Rdb_rpc_call_stats_info> &all_stats =
+      rdb_get_rpc_call_stats();
+
+  for (const auto &info : all_stats) {
+    Field **const field = tables->table->field;
+    field[RDB_RPC_CALL_STATS_FIELD::SCOPE]->store(
+        info.scope.c_str(), info.scope.length(), system_charset_info);
+    field[RDB_RPC_CALL_STATS_FIELD::THREAD_ID]->store(info.thread_id, true);
+    field[RDB_RPC_CALL_STATS_FIELD::CALL_SITE]->store(
+        info.call_site.c_str(), info.call_site.length(), system_charset_info);
+    field[RDB_RPC_CALL_STATS_FIELD::METHOD]->store(
+        info.method.c_str(), info.method.length(), system_charset_info);
+    field[RDB_RPC_CALL_STATS_FIELD::CALLS]->store(info.calls, true);
+    field[RDB_RPC_CALL_STATS_FIELD::ERRORS]->store(info.errors, true);
+    field[RDB_RPC_CALL_STATS_FIELD::TOTAL_US]->store(info.total_us, true);
+    field[RDB_RPC_CALL_STATS_FIELD::P50_US]->store(info.p50_us, true);
+    field[RDB_RPC_CALL_STATS_FIELD::P95_US]->store(info.p95_us, true);
+    field[RDB_RPC_CALL_STATS_FIELD::P99_US]->store(info.p99_us, true);
+    field[RDB_RPC_CALL_STATS_FIELD::MAX_US]->store(info.max_us, true);
+
+    /* Tell MySQL about this row in the virtual table */
+    ret = static_cast<int>(
+        my_core::schema_table_store_record(thd, tables->table));
+
+    if (ret != 0) {
+      break;
+    }
+  }
+
+  DBUG_RETURN(ret);
+}
+
+static int rdb_i_s_rpc_call_stats_init(void *const p) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(p != nullptr);
+
+  my_core::ST_SCHEMA_TABLE *schema;
+
+  schema = (my_core::ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info = rdb_i_s_rpc_call_stats_fields_info;
+  schema->fill_table = rdb_i_s_rpc_call_stats_fill_table;
+
+  DBUG_RETURN(0);
+}
+
 static int rdb_i_s_deinit(void *p MY_ATTRIBUTE((__unused__))) {
   DBUG_ENTER_FUNC();
   DBUG_RETURN(0);
@@ -2175,4 +2335,36 @@ struct st_mysql_plugin rdb_rpc_i_s_bypass_rejected_query_history = {
     nullptr, /* config options */
     0,       /* flags */
 };
+
+struct st_mysql_plugin rdb_rpc_i_s_row_cache = {
+    MYSQL_INFORMATION_SCHEMA_PLUGIN,
+    &rdb_i_s_info,
+    "ROCKSDB_RPC_ROW_CACHE",
+    "BobBai",
+    "RocksDB RPC row cache stats",
+    PLUGIN_LICENSE_GPL,
+    rdb_i_s_row_cache_init,
+    rdb_i_s_deinit,
+    0x0001,  /* version number (0.1) */
+    nullptr, /* status variables */
+    nullptr, /* system variables */
+    nullptr, /* config options */
+    0,       /* flags */
+};
+
+struct st_mysql_plugin rdb_rpc_i_s_call_stats = {
+    MYSQL_INFORMATION_SCHEMA_PLUGIN,
+    &rdb_i_s_info,
+    "ROCKSDB_RPC_CALL_STATS",
+    "BobBai",
+    "RocksDB RPC call counts and latencies",
+    PLUGIN_LICENSE_GPL,
+    rdb_i_s_rpc_call_stats_init,
+    rdb_i_s_deinit,
+    0x0001,  /* version number (0.1) */
+    nullptr, /* status variables */
+    nullptr, /* system variables */
+    nullptr, /* config options */
+    0,       /* flags */
+};
 }  // namespace myrocks_rpc
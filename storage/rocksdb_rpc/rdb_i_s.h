@@ -35,4 +35,6 @@ extern struct st_mysql_plugin rdb_rpc_i_s_lock_info;
 extern struct st_mysql_plugin rdb_rpc_i_s_trx_info;
 extern struct st_mysql_plugin rdb_rpc_i_s_deadlock_info;
 extern struct st_mysql_plugin rdb_rpc_i_s_bypass_rejected_query_history;
+extern struct st_mysql_plugin rdb_rpc_i_s_row_cache;
+extern struct st_mysql_plugin rdb_rpc_i_s_call_stats;
 }  // namespace myrocks_rpc
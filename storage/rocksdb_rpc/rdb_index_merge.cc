@@ -179,9 +179,9 @@ int Rdb_index_merge::add(const rocksdb::Slice &key, const rocksdb::Slice &val) {
   // auto res =
   //     m_offset_tree.emplace(m_rec_buf_unsorted->m_block.get() + rec_offset,
   //                           m_cf_handle->GetComparator());
-  auto res = m_offset_tree.emplace(
-      m_rec_buf_unsorted->m_block.get() + rec_offset,
-      rocksdb_ColumnFamilyHandle__GetComparator(m_cf_handle));
+  auto res =
+      m_offset_tree.emplace(m_rec_buf_unsorted->m_block.get() + rec_offset,
+                            rdb_cf_comparator(m_cf_handle));
 
   if (!res.second) {
     my_printf_error(ER_DUP_ENTRY,
@@ -293,8 +293,8 @@ int Rdb_index_merge::merge_heap_prepare() {
     // ALTER
     // const auto entry =
     //     std::make_shared<merge_heap_entry>(m_cf_handle->GetComparator());
-    const auto entry = std::make_shared<merge_heap_entry>(
-        rocksdb_ColumnFamilyHandle__GetComparator(m_cf_handle));
+    const auto entry =
+        std::make_shared<merge_heap_entry>(rdb_cf_comparator(m_cf_handle));
 
     /*
       Read chunk_size bytes from each chunk on disk, and place inside
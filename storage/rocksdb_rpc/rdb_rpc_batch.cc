@@ -0,0 +1,230 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_rpc_batch.h"
+
+#include "rpcclient.hpp"
+
+namespace myrocks_rpc {
+
+static Rdb_rpc_handle_cache rdb_rpc_handle_cache;
+
+Rdb_rpc_handle_cache &rdb_get_rpc_handle_cache() {
+  return rdb_rpc_handle_cache;
+}
+
+/* Fetch id and name of a handle that was not seen before */
+void Rdb_rpc_handle_cache::add_cf(rocksdb::ColumnFamilyHandle *const cfh) {
+  rocksdb_rpc_log(95, "add_cf: rocksdb_ColumnFamilyHandle__GetID");
+  const uint32_t id = rocksdb_ColumnFamilyHandle__GetID(cfh);
+  rocksdb_rpc_log(97, "add_cf: rocksdb_ColumnFamilyHandle__GetName");
+  std::string name = rocksdb_ColumnFamilyHandle__GetName(cfh);
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  Rdb_cf_info &info = m_cfs[cfh];
+  info.m_id = id;
+  info.m_name = std::move(name);
+}
+
+void Rdb_rpc_handle_cache::remove_cf(rocksdb::ColumnFamilyHandle *const cfh) {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_cfs.erase(cfh);
+}
+
+uint32_t Rdb_rpc_handle_cache::get_cf_id(
+    rocksdb::ColumnFamilyHandle *const cfh) {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_cfs.find(cfh);
+    if (it != m_cfs.end()) {
+      return it->second.m_id;
+    }
+  }
+
+  add_cf(cfh);
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cfs[cfh].m_id;
+}
+
+std::string Rdb_rpc_handle_cache::get_cf_name(
+    rocksdb::ColumnFamilyHandle *const cfh) {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_cfs.find(cfh);
+    if (it != m_cfs.end()) {
+      return it->second.m_name;
+    }
+  }
+
+  add_cf(cfh);
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cfs[cfh].m_name;
+}
+
+const rocksdb::Comparator *Rdb_rpc_handle_cache::get_cf_comparator(
+    rocksdb::ColumnFamilyHandle *const cfh) {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_cfs.find(cfh);
+    if (it != m_cfs.end() && it->second.m_comparator != nullptr) {
+      return it->second.m_comparator;
+    }
+  }
+
+  rocksdb_rpc_log(
+      155, "get_cf_comparator: rocksdb_ColumnFamilyHandle__GetComparator");
+  const rocksdb::Comparator *const comparator =
+      rocksdb_ColumnFamilyHandle__GetComparator(cfh);
+
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_cfs.find(cfh);
+    if (it != m_cfs.end()) {
+      it->second.m_comparator = comparator;
+      return comparator;
+    }
+  }
+
+  /* First use of this handle, also cache its id and name */
+  add_cf(cfh);
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_cfs[cfh].m_comparator = comparator;
+  return comparator;
+}
+
+rocksdb::Env *Rdb_rpc_handle_cache::get_env(rocksdb::TransactionDB *const db) {
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_env_db == db && m_env != nullptr) {
+      return m_env;
+    }
+  }
+
+  rocksdb_rpc_log(185, "get_env: rocksdb_TransactionDB__GetEnv");
+  rocksdb::Env *const env = rocksdb_TransactionDB__GetEnv(db);
+
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_env_db = db;
+  m_env = env;
+  return env;
+}
+
+bool Rdb_rpc_handle_cache::find_db_option(rocksdb::DBOptions *const opts,
+                                          const std::string &name,
+                                          uint64_t *const value) {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_db_options != opts) {
+    return false;
+  }
+  const auto it = m_db_option_values.find(name);
+  if (it == m_db_option_values.end()) {
+    return false;
+  }
+  *value = it->second;
+  return true;
+}
+
+void Rdb_rpc_handle_cache::store_db_option(rocksdb::DBOptions *const opts,
+                                           const std::string &name,
+                                           const uint64_t value) {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_db_options != opts) {
+    m_db_option_values.clear();
+    m_db_options = opts;
+  }
+  m_db_option_values[name] = value;
+}
+
+bool Rdb_rpc_handle_cache::get_db_option_bool(rocksdb::DBOptions *const opts,
+                                              const std::string &name) {
+  uint64_t value;
+  if (find_db_option(opts, name, &value)) {
+    return value != 0;
+  }
+
+  rocksdb_rpc_log(228, "get_db_option_bool: rocksdb_DBOptions__GetBoolOptions");
+  const bool res = rocksdb_DBOptions__GetBoolOptions(opts, name.c_str());
+  store_db_option(opts, name, res);
+  return res;
+}
+
+int Rdb_rpc_handle_cache::get_db_option_int(rocksdb::DBOptions *const opts,
+                                            const std::string &name) {
+  uint64_t value;
+  if (find_db_option(opts, name, &value)) {
+    return static_cast<int>(static_cast<int64_t>(value));
+  }
+
+  rocksdb_rpc_log(241, "get_db_option_int: rocksdb_DBOptions__GetIntOptions");
+  const int res = rocksdb_DBOptions__GetIntOptions(opts, name.c_str());
+  store_db_option(opts, name, static_cast<uint64_t>(static_cast<int64_t>(res)));
+  return res;
+}
+
+uint64_t Rdb_rpc_handle_cache::get_db_option_uint64(
+    rocksdb::DBOptions *const opts, const std::string &name) {
+  uint64_t value;
+  if (find_db_option(opts, name, &value)) {
+    return value;
+  }
+
+  rocksdb_rpc_log(254,
+                  "get_db_option_uint64: rocksdb_DBOptions__GetUInt64Options");
+  const uint64_t res = rocksdb_DBOptions__GetUInt64Options(opts, name.c_str());
+  store_db_option(opts, name, res);
+  return res;
+}
+
+void Rdb_rpc_handle_cache::set_db_option_bool(rocksdb::DBOptions *const opts,
+                                              const std::string &name,
+                                              const bool value) {
+  rocksdb_rpc_log(264, "set_db_option_bool: rocksdb_DBOptions__SetBoolOptions");
+  rocksdb_DBOptions__SetBoolOptions(opts, name.c_str(), value);
+  store_db_option(opts, name, value);
+}
+
+void Rdb_rpc_handle_cache::set_db_option_int(rocksdb::DBOptions *const opts,
+                                             const std::string &name,
+                                             const int value) {
+  rocksdb_rpc_log(272, "set_db_option_int: rocksdb_DBOptions__SetIntOptions");
+  rocksdb_DBOptions__SetIntOptions(opts, name.c_str(), value);
+  store_db_option(opts, name,
+                  static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+void Rdb_rpc_handle_cache::set_db_option_uint64(rocksdb::DBOptions *const opts,
+                                                const std::string &name,
+                                                const uint64_t value) {
+  rocksdb_rpc_log(281,
+                  "set_db_option_uint64: rocksdb_DBOptions__SetUInt64Options");
+  rocksdb_DBOptions__SetUInt64Options(opts, name.c_str(), value);
+  store_db_option(opts, name, value);
+}
+
+void Rdb_rpc_handle_cache::clear() {
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_cfs.clear();
+  m_env_db = nullptr;
+  m_env = nullptr;
+  m_db_options = nullptr;
+  m_db_option_values.clear();
+}
+
+}  // namespace myrocks_rpc
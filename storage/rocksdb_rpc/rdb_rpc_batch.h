@@ -0,0 +1,150 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* C++ standard header files */
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* RocksDB header files */
+#include "rocksdb/comparator.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "rocksdb/options.h"
+#include "rocksdb/utilities/transaction_db.h"
+
+#include "rpcclient.hpp"
+
+namespace myrocks_rpc {
+
+/*
+  Client side cache of remote values that cannot change while the remote
+  object is alive:
+  - id, name and comparator of a column family handle,
+  - the Env of the database,
+  - named DBOptions values. These do change when a setter is called, so all
+    updates of a cached option must go through the set_db_option_*()
+    functions, which write the new value through to the server.
+
+  Lookups of column families that were not seen before go to the server,
+  fetching id and name together.
+*/
+class Rdb_rpc_handle_cache {
+ public:
+  Rdb_rpc_handle_cache(const Rdb_rpc_handle_cache &) = delete;
+  Rdb_rpc_handle_cache &operator=(const Rdb_rpc_handle_cache &) = delete;
+  Rdb_rpc_handle_cache() = default;
+
+  uint32_t get_cf_id(rocksdb::ColumnFamilyHandle *const cfh);
+  std::string get_cf_name(rocksdb::ColumnFamilyHandle *const cfh);
+  const rocksdb::Comparator *get_cf_comparator(
+      rocksdb::ColumnFamilyHandle *const cfh);
+
+  /* Must be called before the remote handle is destroyed */
+  void remove_cf(rocksdb::ColumnFamilyHandle *const cfh);
+
+  rocksdb::Env *get_env(rocksdb::TransactionDB *const db);
+
+  bool get_db_option_bool(rocksdb::DBOptions *const opts,
+                          const std::string &name);
+  int get_db_option_int(rocksdb::DBOptions *const opts,
+                        const std::string &name);
+  uint64_t get_db_option_uint64(rocksdb::DBOptions *const opts,
+                                const std::string &name);
+
+  void set_db_option_bool(rocksdb::DBOptions *const opts,
+                          const std::string &name, const bool value);
+  void set_db_option_int(rocksdb::DBOptions *const opts,
+                         const std::string &name, const int value);
+  void set_db_option_uint64(rocksdb::DBOptions *const opts,
+                            const std::string &name, const uint64_t value);
+
+  void clear();
+
+ private:
+  struct Rdb_cf_info {
+    uint32_t m_id = 0;
+    std::string m_name;
+    const rocksdb::Comparator *m_comparator = nullptr;
+  };
+
+  void add_cf(rocksdb::ColumnFamilyHandle *const cfh);
+  bool find_db_option(rocksdb::DBOptions *const opts, const std::string &name,
+                      uint64_t *const value);
+  void store_db_option(rocksdb::DBOptions *const opts, const std::string &name,
+                       const uint64_t value);
+
+  std::mutex m_mutex;
+  std::unordered_map<rocksdb::ColumnFamilyHandle *, Rdb_cf_info> m_cfs;
+  rocksdb::TransactionDB *m_env_db = nullptr;
+  rocksdb::Env *m_env = nullptr;
+  /* Option values are stored widened to 64 bits, keyed by option name */
+  rocksdb::DBOptions *m_db_options = nullptr;
+  std::unordered_map<std::string, uint64_t> m_db_option_values;
+};
+
+Rdb_rpc_handle_cache &rdb_get_rpc_handle_cache();
+
+inline uint32_t rdb_cf_id(rocksdb::ColumnFamilyHandle *const cfh) {
+  return rdb_get_rpc_handle_cache().get_cf_id(cfh);
+}
+
+inline std::string rdb_cf_name(rocksdb::ColumnFamilyHandle *const cfh) {
+  return rdb_get_rpc_handle_cache().get_cf_name(cfh);
+}
+
+inline const rocksdb::Comparator *rdb_cf_comparator(
+    rocksdb::ColumnFamilyHandle *const cfh) {
+  return rdb_get_rpc_handle_cache().get_cf_comparator(cfh);
+}
+
+inline rocksdb::Env *rdb_get_env(rocksdb::TransactionDB *const db) {
+  return rdb_get_rpc_handle_cache().get_env(db);
+}
+
+inline bool rdb_get_db_option_bool(rocksdb::DBOptions *const opts,
+                                   const std::string &name) {
+  return rdb_get_rpc_handle_cache().get_db_option_bool(opts, name);
+}
+
+inline int rdb_get_db_option_int(rocksdb::DBOptions *const opts,
+                                 const std::string &name) {
+  return rdb_get_rpc_handle_cache().get_db_option_int(opts, name);
+}
+
+inline uint64_t rdb_get_db_option_uint64(rocksdb::DBOptions *const opts,
+                                         const std::string &name) {
+  return rdb_get_rpc_handle_cache().get_db_option_uint64(opts, name);
+}
+
+inline void rdb_set_db_option_bool(rocksdb::DBOptions *const opts,
+                                   const std::string &name, const bool value) {
+  rdb_get_rpc_handle_cache().set_db_option_bool(opts, name, value);
+}
+
+inline void rdb_set_db_option_int(rocksdb::DBOptions *const opts,
+                                  const std::string &name, const int value) {
+  rdb_get_rpc_handle_cache().set_db_option_int(opts, name, value);
+}
+
+inline void rdb_set_db_option_uint64(rocksdb::DBOptions *const opts,
+                                     const std::string &name,
+                                     const uint64_t value) {
+  rdb_get_rpc_handle_cache().set_db_option_uint64(opts, name, value);
+}
+
+}  // namespace myrocks_rpc
@@ -0,0 +1,175 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_rpc_call_stats.h"
+
+/* C++ standard header files */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+namespace myrocks_rpc {
+
+thread_local Rdb_rpc_call_site Rdb_rpc_call_site_scope::s_current =
+    Rdb_rpc_call_site::OTHER;
+
+static std::atomic<Rdb_rpc_call_observer *> rdb_rpc_call_observer(nullptr);
+
+void rdb_rpc_set_call_observer(Rdb_rpc_call_observer *const observer) {
+  rdb_rpc_call_observer.store(observer, std::memory_order_release);
+}
+
+Rdb_rpc_call_timer::Rdb_rpc_call_timer(const char *const method)
+    : m_method(method),
+      m_observer(rdb_rpc_call_observer.load(std::memory_order_acquire)) {
+  if (m_observer != nullptr) {
+    m_start = std::chrono::steady_clock::now();
+  }
+}
+
+Rdb_rpc_call_timer::~Rdb_rpc_call_timer() {
+  if (m_observer == nullptr) {
+    return;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - m_start;
+  m_observer->on_call(
+      m_method,
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      m_failed);
+}
+
+const char *rdb_rpc_call_site_name(const Rdb_rpc_call_site site) {
+  switch (site) {
+    case Rdb_rpc_call_site::OTHER:
+      return "OTHER";
+    case Rdb_rpc_call_site::OPEN:
+      return "OPEN";
+    case Rdb_rpc_call_site::SCAN:
+      return "SCAN";
+    case Rdb_rpc_call_site::POINT_GET:
+      return "POINT_GET";
+    case Rdb_rpc_call_site::WRITE:
+      return "WRITE";
+    case Rdb_rpc_call_site::COMMIT:
+      return "COMMIT";
+  }
+  return "UNKNOWN";
+}
+
+void Rdb_rpc_latency_histogram::add(const ulonglong micros,
+                                    const bool failed) {
+  size_t bucket = 0;
+  for (ulonglong v = micros; v != 0 && bucket < RDB_RPC_HIST_BUCKETS - 1;
+       v >>= 1) {
+    bucket++;
+  }
+  m_buckets[bucket]++;
+  m_calls++;
+  m_total_micros += micros;
+  m_max_micros = std::max(m_max_micros, micros);
+  if (failed) {
+    m_errors++;
+  }
+}
+
+void Rdb_rpc_latency_histogram::merge(const Rdb_rpc_latency_histogram &other) {
+  for (size_t i = 0; i < RDB_RPC_HIST_BUCKETS; i++) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+  m_calls += other.m_calls;
+  m_errors += other.m_errors;
+  m_total_micros += other.m_total_micros;
+  m_max_micros = std::max(m_max_micros, other.m_max_micros);
+}
+
+ulonglong Rdb_rpc_latency_histogram::percentile(const double pct) const {
+  if (m_calls == 0) {
+    return 0;
+  }
+  const double rank = m_calls * pct / 100;
+  ulonglong seen = 0;
+  for (size_t i = 0; i < RDB_RPC_HIST_BUCKETS; i++) {
+    if (m_buckets[i] == 0 || seen + m_buckets[i] < rank) {
+      seen += m_buckets[i];
+      continue;
+    }
+    /* Interpolate linearly within the bucket */
+    const double low = i == 0 ? 0 : static_cast<double>(1ULL << (i - 1));
+    const double high = static_cast<double>(1ULL << i);
+    const double pos = (rank - seen) / m_buckets[i];
+    return std::min(m_max_micros,
+                    static_cast<ulonglong>(low + (high - low) * pos));
+  }
+  return m_max_micros;
+}
+
+void Rdb_rpc_call_stats::record(const Rdb_rpc_call_site site,
+                                const char *const method,
+                                const ulonglong micros, const bool failed) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_calls[std::make_pair(site, method)].add(micros, failed);
+}
+
+void Rdb_rpc_call_stats::collect(Rdb_rpc_call_stats_map *const stats) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto &it : m_calls) {
+    (*stats)[std::make_pair(it.first.first, std::string(it.first.second))]
+        .merge(it.second);
+  }
+}
+
+void Rdb_rpc_global_call_stats::record(const Rdb_rpc_call_site site,
+                                       const char *const method,
+                                       const ulonglong micros,
+                                       const bool failed) {
+  static std::atomic<size_t> next_shard(0);
+  thread_local const size_t shard =
+      next_shard++ % RDB_RPC_CALL_STATS_SHARDS;
+  m_shards[shard].record(site, method, micros, failed);
+}
+
+void Rdb_rpc_global_call_stats::collect(
+    Rdb_rpc_call_stats_map *const stats) const {
+  for (const auto &shard : m_shards) {
+    shard.collect(stats);
+  }
+}
+
+std::string Rdb_rpc_global_call_stats::dump() const {
+  Rdb_rpc_call_stats_map stats;
+  collect(&stats);
+
+  std::string res;
+  char buf[512];
+  snprintf(buf, sizeof(buf), "%-10s %-40s %12s %8s %10s %8s %8s %8s\n",
+           "site", "method", "calls", "errors", "avg_us", "p50_us", "p99_us",
+           "max_us");
+  res += buf;
+  for (const auto &it : stats) {
+    const Rdb_rpc_latency_histogram &hist = it.second;
+    snprintf(buf, sizeof(buf),
+             "%-10s %-40s %12llu %8llu %10.1f %8llu %8llu %8llu\n",
+             rdb_rpc_call_site_name(it.first.first), it.first.second.c_str(),
+             hist.calls(), hist.errors(),
+             static_cast<double>(hist.total_micros()) / hist.calls(),
+             hist.percentile(50), hist.percentile(99), hist.max_micros());
+    res += buf;
+  }
+  return res;
+}
+
+}  // namespace myrocks_rpc
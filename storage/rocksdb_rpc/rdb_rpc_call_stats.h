@@ -0,0 +1,205 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* C++ standard header files */
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/* MySQL header files */
+#include "./my_global.h" /* ulonglong */
+
+/* RocksDB header files */
+#include "rocksdb/status.h"
+
+namespace myrocks_rpc {
+
+/*
+  Part of the engine an RPC is made from. The site is set by the code that
+  is about to make calls, with Rdb_rpc_call_site_scope, and applies to all
+  calls made by the thread until the scope ends.
+*/
+enum class Rdb_rpc_call_site : uint8_t {
+  OTHER = 0,
+  /* Opening a table */
+  OPEN,
+  /* Iterators */
+  SCAN,
+  /* Get, GetForUpdate and MultiGet */
+  POINT_GET,
+  /* Row changes */
+  WRITE,
+  /* Prepare, commit and rollback */
+  COMMIT,
+};
+
+const char *rdb_rpc_call_site_name(const Rdb_rpc_call_site site);
+
+class Rdb_rpc_call_site_scope {
+ public:
+  Rdb_rpc_call_site_scope(const Rdb_rpc_call_site_scope &) = delete;
+  Rdb_rpc_call_site_scope &operator=(const Rdb_rpc_call_site_scope &) = delete;
+
+  explicit Rdb_rpc_call_site_scope(const Rdb_rpc_call_site site)
+      : m_saved(s_current) {
+    s_current = site;
+  }
+  ~Rdb_rpc_call_site_scope() { s_current = m_saved; }
+
+  static Rdb_rpc_call_site current() { return s_current; }
+
+ private:
+  const Rdb_rpc_call_site m_saved;
+  static thread_local Rdb_rpc_call_site s_current;
+};
+
+/*
+  Receives every call timed with Rdb_rpc_call_timer, see
+  rdb_rpc_set_call_observer().
+*/
+class Rdb_rpc_call_observer {
+ public:
+  virtual ~Rdb_rpc_call_observer() = default;
+
+  /*
+    Called on the thread that made the call when the call returns.
+
+    @param method  name of the call, e.g. "Transaction::Get"; a string with
+                   static storage duration, the same for every call of the
+                   method
+    @param micros  time spent in the stub, including marshalling
+    @param failed  whether the call returned a status that is not ok
+  */
+  virtual void on_call(const char *const method, const uint64_t micros,
+                       const bool failed) = 0;
+};
+
+/*
+  Report all further timed calls to observer. Passing nullptr stops the
+  reports.
+*/
+void rdb_rpc_set_call_observer(Rdb_rpc_call_observer *const observer);
+
+/*
+  Times one stub call, from construction until the timer goes out of scope,
+  and reports it to the observer. The clock is only read while an observer
+  is set.
+
+    const Rdb_rpc_call_timer rpc_timer("Transaction::Get");
+    return rpc_timer.result(rocksdb_Transaction__Get(...));
+*/
+class Rdb_rpc_call_timer {
+ public:
+  Rdb_rpc_call_timer(const Rdb_rpc_call_timer &) = delete;
+  Rdb_rpc_call_timer &operator=(const Rdb_rpc_call_timer &) = delete;
+
+  explicit Rdb_rpc_call_timer(const char *const method);
+  ~Rdb_rpc_call_timer();
+
+  /* Record whether the call failed, for calls that do not return a status */
+  void set_failed(const bool failed) const { m_failed = failed; }
+
+  /* Record whether the call failed and pass its status on */
+  rocksdb::Status result(const rocksdb::Status &s) const {
+    m_failed = !s.ok();
+    return s;
+  }
+
+ private:
+  const char *const m_method;
+  Rdb_rpc_call_observer *const m_observer;
+  std::chrono::steady_clock::time_point m_start;
+  mutable bool m_failed = false;
+};
+
+/*
+  Latency histogram with power of two buckets in microseconds. Bucket i
+  counts calls that took [2^(i-1), 2^i) microseconds, bucket 0 those that
+  took less than one microsecond.
+*/
+class Rdb_rpc_latency_histogram {
+ public:
+  static constexpr size_t RDB_RPC_HIST_BUCKETS = 32;
+
+  void add(const ulonglong micros, const bool failed);
+  void merge(const Rdb_rpc_latency_histogram &other);
+
+  /* Estimated latency below which pct percent of the calls completed */
+  ulonglong percentile(const double pct) const;
+
+  ulonglong calls() const { return m_calls; }
+  ulonglong errors() const { return m_errors; }
+  ulonglong total_micros() const { return m_total_micros; }
+  ulonglong max_micros() const { return m_max_micros; }
+
+ private:
+  ulonglong m_calls = 0;
+  ulonglong m_errors = 0;
+  ulonglong m_total_micros = 0;
+  ulonglong m_max_micros = 0;
+  ulonglong m_buckets[RDB_RPC_HIST_BUCKETS] = {};
+};
+
+/* Histograms keyed by call site and method name */
+using Rdb_rpc_call_stats_map =
+    std::map<std::pair<Rdb_rpc_call_site, std::string>,
+             Rdb_rpc_latency_histogram>;
+
+/*
+  Call counts and latencies of RPCs by call site and method.
+
+  Method names are the static strings given to Rdb_rpc_call_timer, so they
+  are compared by address when calls are recorded and only turned into
+  strings by collect().
+*/
+class Rdb_rpc_call_stats {
+ public:
+  void record(const Rdb_rpc_call_site site, const char *const method,
+              const ulonglong micros, const bool failed);
+
+  /* Add the histograms to *stats */
+  void collect(Rdb_rpc_call_stats_map *const stats) const;
+
+ private:
+  mutable std::mutex m_mutex;
+  std::map<std::pair<Rdb_rpc_call_site, const char *>,
+           Rdb_rpc_latency_histogram>
+      m_calls;
+};
+
+/*
+  Process wide statistics. They are split into shards by thread so that
+  sessions do not contend on one mutex for every call.
+*/
+class Rdb_rpc_global_call_stats {
+ public:
+  void record(const Rdb_rpc_call_site site, const char *const method,
+              const ulonglong micros, const bool failed);
+  void collect(Rdb_rpc_call_stats_map *const stats) const;
+
+  /* One line per call site and method, for SHOW ENGINE STATUS */
+  std::string dump() const;
+
+ private:
+  static constexpr size_t RDB_RPC_CALL_STATS_SHARDS = 16;
+
+  Rdb_rpc_call_stats m_shards[RDB_RPC_CALL_STATS_SHARDS];
+};
+
+}  // namespace myrocks_rpc
@@ -0,0 +1,252 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_rpc_iterator.h"
+
+/* MySQL header files */
+#include "./my_dbug.h"
+
+/* MyRocks header files */
+#include "./rdb_rpc_call_stats.h"
+
+#include "rpcclient.hpp"
+
+namespace myrocks_rpc {
+
+Rdb_rpc_iterator::Rdb_rpc_iterator(rocksdb::Iterator *const remote_it,
+                                   const ulonglong *const write_generation)
+    : m_remote_it(remote_it), m_write_generation(write_generation) {
+  DBUG_ASSERT(m_remote_it != nullptr);
+  forget_position();
+}
+
+Rdb_rpc_iterator::~Rdb_rpc_iterator() {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  // ALTER
+  // delete m_remote_it;
+  rocksdb_rpc_log(44, "~Rdb_rpc_iterator: rocksdb_Iterator__delete");
+  const Rdb_rpc_call_timer rpc_timer("Iterator::delete");
+  rocksdb_Iterator__delete(m_remote_it);
+  m_remote_it = nullptr;
+}
+
+bool Rdb_rpc_iterator::Valid() const {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  check_stale();
+  if (!m_has_valid) {
+    // ALTER
+    // return m_remote_it->Valid();
+    rocksdb_rpc_log(51, "Rdb_rpc_iterator::Valid: rocksdb_Iterator__Valid");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::Valid");
+    m_valid = rocksdb_Iterator__Valid(m_remote_it);
+    m_has_valid = true;
+  }
+  return m_valid;
+}
+
+rocksdb::Slice Rdb_rpc_iterator::key() const {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  check_stale();
+  if (!m_has_key) {
+    // ALTER
+    // return m_remote_it->key();
+    rocksdb_rpc_log(59, "Rdb_rpc_iterator::key: rocksdb_Iterator__key");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::key");
+    const rocksdb::Slice key = rocksdb_Iterator__key(m_remote_it);
+    m_key.assign(key.data(), key.size());
+    m_has_key = true;
+  }
+  return m_key;
+}
+
+rocksdb::Slice Rdb_rpc_iterator::value() const {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  check_stale();
+  if (!m_has_value) {
+    // ALTER
+    // return m_remote_it->value();
+    rocksdb_rpc_log(68, "Rdb_rpc_iterator::value: rocksdb_Iterator__value");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::value");
+    const rocksdb::Slice value = rocksdb_Iterator__value(m_remote_it);
+    m_value.assign(value.data(), value.size());
+    m_has_value = true;
+  }
+  return m_value;
+}
+
+rocksdb::Status Rdb_rpc_iterator::status() const {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  check_stale();
+  if (!m_has_status) {
+    // ALTER
+    // return m_remote_it->status();
+    rocksdb_rpc_log(77, "Rdb_rpc_iterator::status: rocksdb_Iterator__status");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::status");
+    m_status = rpc_timer.result(rocksdb_Iterator__status(m_remote_it));
+    m_has_status = true;
+  }
+  return m_status;
+}
+
+void Rdb_rpc_iterator::set_scan_filter(const Rdb_rpc_scan_filter &filter) {
+  m_filter = filter;
+}
+
+void Rdb_rpc_iterator::Seek(const rocksdb::Slice &target) {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->Seek(target);
+    rocksdb_rpc_log(85, "Rdb_rpc_iterator::Seek: rocksdb_Iterator__Seek");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::Seek");
+    rocksdb_Iterator__Seek(m_remote_it, target);
+  }
+  skip_filtered(true);
+}
+
+void Rdb_rpc_iterator::SeekForPrev(const rocksdb::Slice &target) {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->SeekForPrev(target);
+    rocksdb_rpc_log(95,
+                    "Rdb_rpc_iterator::SeekForPrev: "
+                    "rocksdb_Iterator__SeekForPrev");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::SeekForPrev");
+    rocksdb_Iterator__SeekForPrev(m_remote_it, target);
+  }
+  skip_filtered(false);
+}
+
+void Rdb_rpc_iterator::SeekToFirst() {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->SeekToFirst();
+    rocksdb_rpc_log(107,
+                    "Rdb_rpc_iterator::SeekToFirst: "
+                    "rocksdb_Iterator__SeekToFirst");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::SeekToFirst");
+    rocksdb_Iterator__SeekToFirst(m_remote_it);
+  }
+  skip_filtered(true);
+}
+
+void Rdb_rpc_iterator::SeekToLast() {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->SeekToLast();
+    rocksdb_rpc_log(119,
+                    "Rdb_rpc_iterator::SeekToLast: "
+                    "rocksdb_Iterator__SeekToLast");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::SeekToLast");
+    rocksdb_Iterator__SeekToLast(m_remote_it);
+  }
+  skip_filtered(false);
+}
+
+void Rdb_rpc_iterator::Next() {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->Next();
+    rocksdb_rpc_log(131, "Rdb_rpc_iterator::Next: rocksdb_Iterator__Next");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::Next");
+    rocksdb_Iterator__Next(m_remote_it);
+  }
+  skip_filtered(true);
+}
+
+void Rdb_rpc_iterator::Prev() {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  forget_position();
+  {
+    // ALTER
+    // m_remote_it->Prev();
+    rocksdb_rpc_log(140, "Rdb_rpc_iterator::Prev: rocksdb_Iterator__Prev");
+    const Rdb_rpc_call_timer rpc_timer("Iterator::Prev");
+    rocksdb_Iterator__Prev(m_remote_it);
+  }
+  skip_filtered(false);
+}
+
+/* The remote iterator moved: everything known about its position is void */
+void Rdb_rpc_iterator::forget_position() const {
+  m_has_valid = false;
+  m_has_key = false;
+  m_has_value = false;
+  m_has_status = false;
+  if (m_write_generation != nullptr) {
+    m_generation = *m_write_generation;
+  }
+}
+
+/*
+  A write of the owning transaction may change what the remote iterator
+  returns at its current position, so ask the server again after one.
+*/
+void Rdb_rpc_iterator::check_stale() const {
+  if (m_write_generation != nullptr && *m_write_generation != m_generation) {
+    forget_position();
+  }
+}
+
+/*
+  Move the remote iterator in the given direction until it is on a row that
+  the scan filter accepts. Past the filter's stop key the iterator reports
+  itself as invalid. Only the keys of the skipped rows are read.
+*/
+void Rdb_rpc_iterator::skip_filtered(const bool forward) {
+  const Rdb_rpc_call_site_scope rpc_site(Rdb_rpc_call_site::SCAN);
+  if (m_filter.empty()) {
+    return;
+  }
+
+  while (Valid()) {
+    const rocksdb::Slice cur_key = key();
+    if (m_filter.past_stop(cur_key)) {
+      m_valid = false;
+      return;
+    }
+    if (m_filter.matches(cur_key)) {
+      return;
+    }
+
+    forget_position();
+    if (forward) {
+      rocksdb_rpc_log(214,
+                      "Rdb_rpc_iterator::skip_filtered: "
+                      "rocksdb_Iterator__Next");
+      const Rdb_rpc_call_timer rpc_timer("Iterator::Next");
+      rocksdb_Iterator__Next(m_remote_it);
+    } else {
+      rocksdb_rpc_log(219,
+                      "Rdb_rpc_iterator::skip_filtered: "
+                      "rocksdb_Iterator__Prev");
+      const Rdb_rpc_call_timer rpc_timer("Iterator::Prev");
+      rocksdb_Iterator__Prev(m_remote_it);
+    }
+  }
+}
+
+}  // namespace myrocks_rpc
@@ -0,0 +1,118 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* MySQL header files */
+#include "./my_global.h" /* ulonglong */
+
+/* C++ standard header files */
+#include <string>
+
+/* RocksDB header files */
+#include "rocksdb/iterator.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+/* MyRocks header files */
+#include "./rdb_rpc_scan_filter.h"
+
+#include "rpcclient.hpp"
+
+namespace myrocks_rpc {
+
+/*
+  Client side cursor over a remote rocksdb::Iterator.
+
+  Every call on a remote iterator is a round trip. The engine asks a
+  position for Valid(), key() and status() several times while it checks
+  bounds, unpacks and compares a row, so Rdb_rpc_iterator remembers what
+  the server answered for the current position and only asks again after
+  the next positioning call. A scan then costs one Next(), Valid(), key()
+  and, for the rows that are used, value() round trip per row.
+
+  Remembered answers are dropped when the owning transaction writes, as
+  the remote iterator may see its own writes.
+
+  The methods mirror rocksdb::Iterator; key() and value() stay valid until
+  the next positioning call.
+
+  A scan filter (set_scan_filter()) skips the rows whose key the caller
+  would throw away. The iterator moves on from such a row after reading
+  its key, so its value is never fetched.
+*/
+class Rdb_rpc_iterator {
+ public:
+  Rdb_rpc_iterator(const Rdb_rpc_iterator &) = delete;
+  Rdb_rpc_iterator &operator=(const Rdb_rpc_iterator &) = delete;
+
+  /*
+    @param remote_it         remote iterator, owned by this object
+    @param write_generation  counter bumped on every write of the owning
+                             transaction, or nullptr if the remote iterator
+                             does not see the transaction's own writes
+  */
+  Rdb_rpc_iterator(rocksdb::Iterator *const remote_it,
+                   const ulonglong *const write_generation);
+  ~Rdb_rpc_iterator();
+
+  bool Valid() const;
+  rocksdb::Slice key() const;
+  rocksdb::Slice value() const;
+  rocksdb::Status status() const;
+
+  void Seek(const rocksdb::Slice &target);
+  void SeekForPrev(const rocksdb::Slice &target);
+  void SeekToFirst();
+  void SeekToLast();
+  void Next();
+  void Prev();
+
+  rocksdb::Iterator *get_remote_iterator() const { return m_remote_it; }
+
+  /*
+    Skip the rows that filter rejects from the following positioning calls
+    on. The filter only saves round trips, so callers still have to check
+    the rows they get.
+  */
+  void set_scan_filter(const Rdb_rpc_scan_filter &filter);
+
+ private:
+  void forget_position() const;
+  void check_stale() const;
+  void skip_filtered(const bool forward);
+
+  rocksdb::Iterator *m_remote_it;
+  const ulonglong *const m_write_generation;
+
+  Rdb_rpc_scan_filter m_filter;
+
+  /*
+    Answers of the remote iterator at the current position, and the write
+    generation they were read at. Mutable as they are filled in by the
+    const accessors.
+  */
+  mutable ulonglong m_generation = 0;
+  mutable bool m_has_valid = false;
+  mutable bool m_valid = false;
+  mutable bool m_has_key = false;
+  mutable std::string m_key;
+  mutable bool m_has_value = false;
+  mutable std::string m_value;
+  mutable bool m_has_status = false;
+  mutable rocksdb::Status m_status;
+};
+
+}  // namespace myrocks_rpc
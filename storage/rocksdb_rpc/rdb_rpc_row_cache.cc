@@ -0,0 +1,237 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_rpc_row_cache.h"
+
+/* C++ standard header files */
+#include <functional>
+
+/* MySQL header files */
+#include "./my_dbug.h"
+
+/* RocksDB header files */
+#include "util/coding.h"
+
+namespace myrocks_rpc {
+
+/* Rough cost of the list node, the hash map node and the strings */
+static constexpr size_t RDB_ROW_CACHE_ENTRY_OVERHEAD = 128;
+
+Rdb_rpc_row_cache::Rdb_rpc_row_cache()
+    : m_capacity(0),
+      m_epoch(0),
+      m_all_pending(0),
+      m_all_inval_epoch(0),
+      m_hits(0),
+      m_misses(0),
+      m_inserts(0),
+      m_insert_rejects(0),
+      m_invalidations(0),
+      m_evictions(0) {}
+
+std::string Rdb_rpc_row_cache::make_key(const uint32_t cf_id,
+                                        const rocksdb::Slice &key) {
+  std::string cache_key;
+  cache_key.reserve(sizeof(cf_id) + key.size());
+  rocksdb::PutFixed32(&cache_key, cf_id);
+  cache_key.append(key.data(), key.size());
+  return cache_key;
+}
+
+size_t Rdb_rpc_row_cache::charge(const Rdb_entry &entry) {
+  /* The key is stored in the list entry and in the hash map */
+  return 2 * entry.m_key.size() + entry.m_value.size() +
+         RDB_ROW_CACHE_ENTRY_OVERHEAD;
+}
+
+Rdb_rpc_row_cache::Rdb_shard &Rdb_rpc_row_cache::get_shard(
+    const std::string &cache_key) {
+  return m_shards[std::hash<std::string>()(cache_key) % RDB_ROW_CACHE_SHARDS];
+}
+
+void Rdb_rpc_row_cache::set_capacity(const size_t capacity) {
+  if (capacity == 0) {
+    m_capacity.store(0);
+    clear_shards();
+    return;
+  }
+  if (!enabled()) {
+    /*
+      Writes committed while the cache was off were not tracked. Readers
+      whose snapshot may predate them must not fill the cache.
+    */
+    m_all_inval_epoch.store(++m_epoch);
+  }
+  m_capacity.store(capacity);
+
+  /* Shrink shards that are over their new share */
+  const size_t shard_capacity = capacity / RDB_ROW_CACHE_SHARDS;
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    while (shard.m_usage > shard_capacity && !shard.m_lru.empty()) {
+      erase(&shard, shard.m_lru.back().m_key);
+      m_evictions++;
+    }
+  }
+}
+
+void Rdb_rpc_row_cache::clear_shards() {
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.m_map.clear();
+    shard.m_lru.clear();
+    shard.m_usage = 0;
+  }
+}
+
+void Rdb_rpc_row_cache::erase(Rdb_shard *const shard,
+                              const std::string &cache_key) {
+  const auto it = shard->m_map.find(cache_key);
+  if (it == shard->m_map.end()) {
+    return;
+  }
+  const auto entry = it->second;
+  shard->m_map.erase(it);
+  shard->m_usage -= charge(*entry);
+  shard->m_lru.erase(entry);
+}
+
+bool Rdb_rpc_row_cache::lookup(const std::string &cache_key,
+                               const uint64_t snapshot_seq,
+                               std::string *const value) {
+  Rdb_shard &shard = get_shard(cache_key);
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    const auto it = shard.m_map.find(cache_key);
+    if (it != shard.m_map.end() && it->second->m_seq <= snapshot_seq) {
+      shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+      *value = it->second->m_value;
+      m_hits++;
+      return true;
+    }
+  }
+  m_misses++;
+  return false;
+}
+
+void Rdb_rpc_row_cache::insert(const std::string &cache_key,
+                               const rocksdb::Slice &value, const uint64_t seq,
+                               const uint64_t epoch) {
+  const size_t shard_capacity = m_capacity.load() / RDB_ROW_CACHE_SHARDS;
+  if (shard_capacity == 0) {
+    return;
+  }
+
+  Rdb_shard &shard = get_shard(cache_key);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+  /*
+    m_all_pending is checked before m_all_inval_epoch: invalidate_end()
+    moves the epoch forward before it decrements the pending count.
+  */
+  if (shard.m_pending > 0 || m_all_pending.load() > 0 ||
+      shard.m_last_inval_epoch > epoch || m_all_inval_epoch.load() > epoch) {
+    m_insert_rejects++;
+    return;
+  }
+
+  const auto it = shard.m_map.find(cache_key);
+  if (it != shard.m_map.end()) {
+    /*
+      Nothing was committed to the key since the entry was added, so the
+      values are the same. Keep the older sequence number, it serves more
+      snapshots.
+    */
+    shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+    return;
+  }
+
+  shard.m_lru.push_front(
+      Rdb_entry{cache_key, std::string(value.data(), value.size()), seq});
+  shard.m_map.emplace(cache_key, shard.m_lru.begin());
+  shard.m_usage += charge(shard.m_lru.front());
+  m_inserts++;
+
+  while (shard.m_usage > shard_capacity && !shard.m_lru.empty()) {
+    erase(&shard, shard.m_lru.back().m_key);
+    m_evictions++;
+  }
+}
+
+void Rdb_rpc_row_cache::invalidate_begin(
+    const std::vector<std::string> &cache_keys, const bool all) {
+  if (all) {
+    m_all_pending++;
+    if (enabled()) {
+      clear_shards();
+    }
+    return;
+  }
+
+  for (const auto &cache_key : cache_keys) {
+    Rdb_shard &shard = get_shard(cache_key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.m_pending++;
+    erase(&shard, cache_key);
+  }
+}
+
+void Rdb_rpc_row_cache::invalidate_end(
+    const std::vector<std::string> &cache_keys, const bool all) {
+  const uint64_t epoch = ++m_epoch;
+
+  if (all) {
+    /* Entries added before the commit by readers that saw no pending count */
+    if (enabled()) {
+      clear_shards();
+    }
+    m_all_inval_epoch.store(epoch);
+    DBUG_ASSERT(m_all_pending.load() > 0);
+    m_all_pending--;
+    m_invalidations++;
+    return;
+  }
+
+  for (const auto &cache_key : cache_keys) {
+    Rdb_shard &shard = get_shard(cache_key);
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    erase(&shard, cache_key);
+    shard.m_last_inval_epoch = epoch;
+    DBUG_ASSERT(shard.m_pending > 0);
+    shard.m_pending--;
+  }
+  m_invalidations += cache_keys.size();
+}
+
+void Rdb_rpc_row_cache::get_stats(Rdb_rpc_row_cache_stats *const stats) const {
+  stats->m_hits = m_hits.load();
+  stats->m_misses = m_misses.load();
+  stats->m_inserts = m_inserts.load();
+  stats->m_insert_rejects = m_insert_rejects.load();
+  stats->m_invalidations = m_invalidations.load();
+  stats->m_evictions = m_evictions.load();
+  stats->m_capacity = m_capacity.load();
+  stats->m_entries = 0;
+  stats->m_usage = 0;
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    stats->m_entries += shard.m_map.size();
+    stats->m_usage += shard.m_usage;
+  }
+}
+
+}  // namespace myrocks_rpc
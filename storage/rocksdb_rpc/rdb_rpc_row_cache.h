@@ -0,0 +1,154 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* C++ standard header files */
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* MySQL header files */
+#include "./my_global.h" /* ulonglong */
+
+/* RocksDB header files */
+#include "rocksdb/slice.h"
+
+namespace myrocks_rpc {
+
+struct Rdb_rpc_row_cache_stats {
+  ulonglong m_hits = 0;
+  ulonglong m_misses = 0;
+  ulonglong m_inserts = 0;
+  /* Inserts refused because a write to the shard may have raced with them */
+  ulonglong m_insert_rejects = 0;
+  ulonglong m_invalidations = 0;
+  ulonglong m_evictions = 0;
+  ulonglong m_entries = 0;
+  ulonglong m_usage = 0;
+  ulonglong m_capacity = 0;
+};
+
+/*
+  Process-local LRU cache of rows read with point lookups from the RocksDB
+  RPC server.
+
+  Entries are keyed by column family id and key; MyRocks keys start with the
+  index number, so this is the (index id, key) pair of the row. Every entry
+  carries the sequence number of the snapshot it was read with, and it is
+  only returned to readers whose snapshot is not older than that.
+
+  The cache relies on all writes to the remote database going through this
+  process. Transactions remember the keys they write and bracket their
+  commit with invalidate_begin() / invalidate_end(), which drop the keys
+  from the cache. A reader could still insert a value it read before the
+  commit after the keys have been dropped. To prevent this, insert() is
+  refused while a commit to the shard is in progress, and also when the
+  shard was invalidated after the reader's snapshot was taken. The reader
+  names that point in time with the epoch it got from current_epoch() right
+  before it acquired its snapshot.
+
+  Only rows that were found are cached.
+*/
+class Rdb_rpc_row_cache {
+ public:
+  Rdb_rpc_row_cache(const Rdb_rpc_row_cache &) = delete;
+  Rdb_rpc_row_cache &operator=(const Rdb_rpc_row_cache &) = delete;
+  Rdb_rpc_row_cache();
+
+  /* Resize the cache; 0 disables it and frees all entries */
+  void set_capacity(const size_t capacity);
+  bool enabled() const { return m_capacity.load() > 0; }
+
+  uint64_t current_epoch() const { return m_epoch.load(); }
+
+  static std::string make_key(const uint32_t cf_id, const rocksdb::Slice &key);
+
+  /*
+    Copy the cached value of key to *value if there is one that is visible
+    to a snapshot with sequence number snapshot_seq.
+  */
+  bool lookup(const std::string &cache_key, const uint64_t snapshot_seq,
+              std::string *const value);
+
+  /*
+    Cache a row read with a snapshot with sequence number seq that was
+    acquired at epoch. The insert is silently dropped if it may race with a
+    write.
+  */
+  void insert(const std::string &cache_key, const rocksdb::Slice &value,
+              const uint64_t seq, const uint64_t epoch);
+
+  /*
+    Bracket the commit of writes to cache_keys. With all set, cache_keys is
+    ignored and the whole cache is invalidated. Every invalidate_begin()
+    must be followed by an invalidate_end() with the same arguments, also if
+    the commit fails.
+  */
+  void invalidate_begin(const std::vector<std::string> &cache_keys,
+                        const bool all);
+  void invalidate_end(const std::vector<std::string> &cache_keys,
+                      const bool all);
+
+  void get_stats(Rdb_rpc_row_cache_stats *const stats) const;
+
+ private:
+  static constexpr size_t RDB_ROW_CACHE_SHARDS = 16;
+
+  struct Rdb_entry {
+    std::string m_key;
+    std::string m_value;
+    uint64_t m_seq;
+  };
+
+  struct Rdb_shard {
+    mutable std::mutex m_mutex;
+    /* Most recently used first */
+    std::list<Rdb_entry> m_lru;
+    std::unordered_map<std::string, std::list<Rdb_entry>::iterator> m_map;
+    size_t m_usage = 0;
+    /* Number of commits to keys of this shard that are in progress */
+    uint m_pending = 0;
+    /* Epoch of the last commit to a key of this shard */
+    uint64_t m_last_inval_epoch = 0;
+  };
+
+  Rdb_shard &get_shard(const std::string &cache_key);
+  /* The shard mutex must be held by the caller */
+  void erase(Rdb_shard *const shard, const std::string &cache_key);
+  void clear_shards();
+
+  static size_t charge(const Rdb_entry &entry);
+
+  Rdb_shard m_shards[RDB_ROW_CACHE_SHARDS];
+  std::atomic<size_t> m_capacity;
+  std::atomic<uint64_t> m_epoch;
+
+  /* Same as the shard fields, for commits that invalidate the whole cache */
+  std::atomic<uint> m_all_pending;
+  std::atomic<uint64_t> m_all_inval_epoch;
+
+  std::atomic<ulonglong> m_hits;
+  std::atomic<ulonglong> m_misses;
+  std::atomic<ulonglong> m_inserts;
+  std::atomic<ulonglong> m_insert_rejects;
+  std::atomic<ulonglong> m_invalidations;
+  std::atomic<ulonglong> m_evictions;
+};
+
+}  // namespace myrocks_rpc
@@ -0,0 +1,100 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_rpc_scan_filter.h"
+
+/* C++ standard header files */
+#include <cstring>
+
+namespace myrocks_rpc {
+
+void Rdb_rpc_scan_filter::add_key_predicate(
+    const size_t offset, const size_t length, const Rdb_rpc_cmp_op op,
+    std::vector<std::string> &&operands) {
+  m_predicates.push_back({static_cast<uint32_t>(offset),
+                          static_cast<uint32_t>(length), op,
+                          std::move(operands)});
+}
+
+void Rdb_rpc_scan_filter::set_stop_key(const rocksdb::Slice &key,
+                                       const bool stop_above) {
+  m_stop = stop_above ? STOP_ABOVE : STOP_BELOW;
+  m_stop_key.assign(key.data(), key.size());
+}
+
+void Rdb_rpc_scan_filter::clear() {
+  m_predicates.clear();
+  m_stop = STOP_NONE;
+  m_stop_key.clear();
+}
+
+bool Rdb_rpc_scan_filter::Rdb_key_predicate::matches(
+    const rocksdb::Slice &key) const {
+  if (key.size() < m_offset + m_length) {
+    return true;
+  }
+  const char *const segment = key.data() + m_offset;
+
+  if (m_op == Rdb_rpc_cmp_op::IN) {
+    for (const auto &operand : m_operands) {
+      if (memcmp(segment, operand.data(), m_length) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const int cmp = memcmp(segment, m_operands[0].data(), m_length);
+  switch (m_op) {
+    case Rdb_rpc_cmp_op::EQ:
+      return cmp == 0;
+    case Rdb_rpc_cmp_op::LT:
+      return cmp < 0;
+    case Rdb_rpc_cmp_op::LE:
+      return cmp <= 0;
+    case Rdb_rpc_cmp_op::GT:
+      return cmp > 0;
+    case Rdb_rpc_cmp_op::GE:
+      return cmp >= 0;
+    case Rdb_rpc_cmp_op::IN:
+      break;
+  }
+  return true;
+}
+
+bool Rdb_rpc_scan_filter::matches(const rocksdb::Slice &key) const {
+  for (const auto &pred : m_predicates) {
+    if (!pred.matches(key)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Rdb_rpc_scan_filter::past_stop(const rocksdb::Slice &key) const {
+  switch (m_stop) {
+    case STOP_NONE:
+      return false;
+    case STOP_ABOVE:
+      return key.compare(m_stop_key) > 0;
+    case STOP_BELOW:
+      return key.compare(m_stop_key) < 0;
+  }
+  return false;
+}
+
+}  // namespace myrocks_rpc
@@ -0,0 +1,98 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+#pragma once
+
+/* C++ standard header files */
+#include <string>
+#include <vector>
+
+/* RocksDB header files */
+#include "rocksdb/slice.h"
+
+namespace myrocks_rpc {
+
+enum class Rdb_rpc_cmp_op : uint8_t {
+  EQ = 0,
+  /* Equal to any of the operands */
+  IN,
+  LT,
+  LE,
+  GT,
+  GE,
+};
+
+/*
+  Key filter that Rdb_rpc_iterator applies while it moves the remote
+  iterator, so that the value of a row whose key already fails the query's
+  conditions is never fetched.
+
+  The filter works on raw key bytes:
+
+  - A key predicate compares the key segment at a fixed offset and length
+    with memcmp() against its operands. The engine only builds predicates
+    on key parts whose mem-comparable image sits at a fixed position, so
+    that comparing images is the same as comparing the column values.
+  - The stop key ends the scan at the first key above (or below) it, the
+    way a range scan ends at its end key.
+
+  A filter only ever skips rows the caller would have thrown away, and
+  callers keep checking their conditions on the rows they get.
+*/
+class Rdb_rpc_scan_filter {
+ public:
+  /*
+    Only keep entries whose key segment [offset, offset + length) compares
+    to the operands as op says. Keys too short to hold the segment are
+    kept.
+  */
+  void add_key_predicate(const size_t offset, const size_t length,
+                         const Rdb_rpc_cmp_op op,
+                         std::vector<std::string> &&operands);
+
+  /*
+    End the collection at the first key that compares greater than key
+    (stop_above) or less than key (!stop_above), as rocksdb::Slice::compare
+    orders them.
+  */
+  void set_stop_key(const rocksdb::Slice &key, const bool stop_above);
+  void clear_stop_key() { m_stop = STOP_NONE; }
+
+  void clear();
+
+  /* Whether the filter lets everything through */
+  bool empty() const { return m_predicates.empty() && m_stop == STOP_NONE; }
+
+  bool matches(const rocksdb::Slice &key) const;
+  bool past_stop(const rocksdb::Slice &key) const;
+
+ private:
+  enum Rdb_stop : uint8_t { STOP_NONE = 0, STOP_ABOVE, STOP_BELOW };
+
+  struct Rdb_key_predicate {
+    uint32_t m_offset;
+    uint32_t m_length;
+    Rdb_rpc_cmp_op m_op;
+    std::vector<std::string> m_operands;
+
+    bool matches(const rocksdb::Slice &key) const;
+  };
+
+  std::vector<Rdb_key_predicate> m_predicates;
+  Rdb_stop m_stop = STOP_NONE;
+  std::string m_stop_key;
+};
+
+}  // namespace myrocks_rpc
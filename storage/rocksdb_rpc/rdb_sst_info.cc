@@ -50,7 +50,7 @@ Rdb_sst_file_ordered::Rdb_sst_file::Rdb_sst_file(
       m_tracing(tracing),
       // ALTER
       /*m_comparator(cf->GetComparator())*/
-      m_comparator(rocksdb_ColumnFamilyHandle__GetComparator(cf)) {
+      m_comparator(rdb_cf_comparator(cf)) {
   DBUG_ASSERT(db != nullptr);
   DBUG_ASSERT(cf != nullptr);
 }
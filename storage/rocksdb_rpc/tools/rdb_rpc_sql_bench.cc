@@ -0,0 +1,397 @@
+/*
+   Copyright (c) 2021, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/*
+  SQL level benchmark of the storage engine, to compare MyRocks with a local
+  database against MyRocks over RPC.
+
+  Every --target names a running mysqld and the engine to create the tables
+  with, e.g.
+
+    --target=local,127.0.0.1,3306,ROCKSDB
+    --target=rpc,127.0.0.1,3307,ROCKSDB_RPC
+
+  where the second server runs against a RocksDB RPC server. For every
+  target the benchmark loads a table of --rows rows and then runs each
+  workload with --threads connections for --seconds seconds:
+
+    point_get   SELECT of one row by primary key
+    range_scan  SELECT of --range_size consecutive rows by primary key
+    insert      autocommit INSERT of one new row
+    commit      transaction updating --trx_size random rows
+
+  Throughput and latency percentiles are reported per target and workload;
+  for commit an operation is a whole transaction.
+
+  Usage: rdb_rpc_sql_bench --target=name,host,port,engine [--target=...]
+                           [--user=U] [--password=P] [--database=D]
+                           [--rows=N] [--threads=N] [--seconds=N]
+                           [--range_size=N] [--trx_size=N]
+                           [--workloads=point_get,range_scan,insert,commit]
+*/
+
+/* C++ standard header files */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* MySQL header files */
+#include "mysql.h"
+
+namespace {
+
+struct Bench_target {
+  std::string name;
+  std::string host;
+  unsigned int port = 0;
+  std::string engine;
+};
+
+struct Bench_options {
+  std::vector<Bench_target> targets;
+  std::string user = "root";
+  std::string password;
+  std::string database = "rdb_rpc_bench";
+  size_t rows = 100000;
+  size_t threads = 8;
+  size_t seconds = 10;
+  size_t range_size = 100;
+  size_t trx_size = 10;
+  std::vector<std::string> workloads = {"point_get", "range_scan", "insert",
+                                        "commit"};
+};
+
+struct Bench_result {
+  size_t ops = 0;
+  size_t errors = 0;
+  double wall_sec = 0;
+  std::vector<double> latencies_us;
+};
+
+MYSQL *connect(const Bench_options &opts, const Bench_target &target,
+               const char *const database) {
+  MYSQL *const mysql = mysql_init(nullptr);
+  if (mysql == nullptr) {
+    return nullptr;
+  }
+  if (mysql_real_connect(mysql, target.host.c_str(), opts.user.c_str(),
+                         opts.password.c_str(), database, target.port,
+                         nullptr, 0) == nullptr) {
+    fprintf(stderr, "%s: cannot connect: %s\n", target.name.c_str(),
+            mysql_error(mysql));
+    mysql_close(mysql);
+    return nullptr;
+  }
+  return mysql;
+}
+
+/* Run a statement and discard its result set */
+bool query(MYSQL *const mysql, const std::string &stmt) {
+  if (mysql_real_query(mysql, stmt.data(), stmt.size()) != 0) {
+    return false;
+  }
+  MYSQL_RES *const res = mysql_store_result(mysql);
+  if (res != nullptr) {
+    mysql_free_result(res);
+  } else if (mysql_field_count(mysql) != 0) {
+    return false;
+  }
+  return true;
+}
+
+bool query_or_report(MYSQL *const mysql, const Bench_target &target,
+                     const std::string &stmt) {
+  if (!query(mysql, stmt)) {
+    fprintf(stderr, "%s: %s: %s\n", target.name.c_str(), stmt.c_str(),
+            mysql_error(mysql));
+    return false;
+  }
+  return true;
+}
+
+std::string row_value(const size_t id) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "'value-%020zu'", id);
+  return buf;
+}
+
+/*
+  (Re)create the tables: t1 with --rows rows for the read and update
+  workloads, and an empty t2 for inserts.
+*/
+bool prepare(const Bench_options &opts, const Bench_target &target) {
+  MYSQL *const mysql = connect(opts, target, nullptr);
+  if (mysql == nullptr) {
+    return false;
+  }
+
+  const std::string table_def =
+      "(id BIGINT UNSIGNED NOT NULL PRIMARY KEY, k INT NOT NULL, "
+      "v VARCHAR(64) NOT NULL, KEY (k)) ENGINE=" +
+      target.engine;
+  bool ok =
+      query_or_report(mysql, target,
+                      "CREATE DATABASE IF NOT EXISTS " + opts.database) &&
+      query_or_report(mysql, target, "USE " + opts.database) &&
+      query_or_report(mysql, target, "DROP TABLE IF EXISTS t1, t2") &&
+      query_or_report(mysql, target, "CREATE TABLE t1 " + table_def) &&
+      query_or_report(mysql, target, "CREATE TABLE t2 " + table_def);
+
+  static const size_t rows_per_insert = 1000;
+  for (size_t id = 0; ok && id < opts.rows; id += rows_per_insert) {
+    std::ostringstream stmt;
+    stmt << "INSERT INTO t1 VALUES ";
+    const size_t end = std::min(opts.rows, id + rows_per_insert);
+    for (size_t i = id; i < end; i++) {
+      stmt << (i == id ? "" : ",") << "(" << i << "," << i % 1000 << ","
+           << row_value(i) << ")";
+    }
+    ok = query_or_report(mysql, target, stmt.str());
+  }
+
+  mysql_close(mysql);
+  return ok;
+}
+
+/* One operation of the workload; returns false if a statement failed */
+bool run_op(const Bench_options &opts, const std::string &workload,
+            MYSQL *const mysql, std::mt19937_64 *const rng,
+            std::atomic<size_t> *const next_insert_id) {
+  std::ostringstream stmt;
+  if (workload == "point_get") {
+    stmt << "SELECT v FROM t1 WHERE id = " << (*rng)() % opts.rows;
+    return query(mysql, stmt.str());
+  }
+  if (workload == "range_scan") {
+    const size_t start = (*rng)() % opts.rows;
+    stmt << "SELECT id, v FROM t1 WHERE id >= " << start << " AND id < "
+         << start + opts.range_size;
+    return query(mysql, stmt.str());
+  }
+  if (workload == "insert") {
+    const size_t id = (*next_insert_id)++;
+    stmt << "INSERT INTO t2 VALUES (" << id << "," << id % 1000 << ","
+         << row_value(id) << ")";
+    return query(mysql, stmt.str());
+  }
+
+  /* commit */
+  if (!query(mysql, "BEGIN")) {
+    return false;
+  }
+  for (size_t i = 0; i < opts.trx_size; i++) {
+    stmt.str("");
+    stmt << "UPDATE t1 SET k = k + 1 WHERE id = " << (*rng)() % opts.rows;
+    if (!query(mysql, stmt.str())) {
+      query(mysql, "ROLLBACK");
+      return false;
+    }
+  }
+  return query(mysql, "COMMIT");
+}
+
+bool run(const Bench_options &opts, const Bench_target &target,
+         const std::string &workload, Bench_result *const result) {
+  std::vector<MYSQL *> conns;
+  for (size_t i = 0; i < opts.threads; i++) {
+    MYSQL *const mysql = connect(opts, target, opts.database.c_str());
+    if (mysql == nullptr) {
+      for (MYSQL *const conn : conns) {
+        mysql_close(conn);
+      }
+      return false;
+    }
+    conns.push_back(mysql);
+  }
+
+  std::atomic<size_t> next_insert_id(0);
+  std::vector<std::vector<double>> latencies(opts.threads);
+  std::vector<size_t> errors(opts.threads, 0);
+  const auto wall_start = std::chrono::steady_clock::now();
+  const auto deadline = wall_start + std::chrono::seconds(opts.seconds);
+
+  const auto client = [&](const size_t thread_no) {
+    mysql_thread_init();
+    std::mt19937_64 rng(thread_no + 1);
+    while (std::chrono::steady_clock::now() < deadline) {
+      const auto start = std::chrono::steady_clock::now();
+      if (!run_op(opts, workload, conns[thread_no], &rng, &next_insert_id)) {
+        errors[thread_no]++;
+        continue;
+      }
+      const auto end = std::chrono::steady_clock::now();
+      latencies[thread_no].push_back(
+          std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    mysql_thread_end();
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < opts.threads; i++) {
+    threads.emplace_back(client, i);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  result->wall_sec = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - wall_start)
+                         .count();
+
+  result->latencies_us.clear();
+  result->errors = 0;
+  for (size_t i = 0; i < opts.threads; i++) {
+    result->latencies_us.insert(result->latencies_us.end(),
+                                latencies[i].begin(), latencies[i].end());
+    result->errors += errors[i];
+    mysql_close(conns[i]);
+  }
+  std::sort(result->latencies_us.begin(), result->latencies_us.end());
+  result->ops = result->latencies_us.size();
+  return true;
+}
+
+void print_result(const Bench_target &target, const std::string &workload,
+                   const Bench_result &result) {
+  const std::vector<double> &lat = result.latencies_us;
+  const size_t n = lat.size();
+  double sum = 0;
+  for (const double l : lat) {
+    sum += l;
+  }
+  printf("%-12s %-12s %10zu %8zu %10.0f %9.1f %9.1f %9.1f\n",
+         target.name.c_str(), workload.c_str(), result.ops, result.errors,
+         result.ops / result.wall_sec, n ? sum / n : 0.0,
+         n ? lat[n / 2] : 0.0, n ? lat[n * 99 / 100] : 0.0);
+}
+
+std::vector<std::string> split(const std::string &value) {
+  std::vector<std::string> parts;
+  std::string part;
+  std::istringstream in(value);
+  while (std::getline(in, part, ',')) {
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+bool parse_arg(const char *const arg, const char *const name,
+               std::string *const value) {
+  const size_t len = strlen(name);
+  if (strncmp(arg, name, len) != 0 || arg[len] != '=') {
+    return false;
+  }
+  *value = arg + len + 1;
+  return true;
+}
+
+bool parse_size(const char *const arg, const char *const name,
+                size_t *const value) {
+  std::string str;
+  if (!parse_arg(arg, name, &str)) {
+    return false;
+  }
+  *value = strtoull(str.c_str(), nullptr, 10);
+  return true;
+}
+
+bool parse_options(int argc, char **argv, Bench_options *const opts) {
+  for (int i = 1; i < argc; i++) {
+    std::string value;
+    if (parse_arg(argv[i], "--target", &value)) {
+      const std::vector<std::string> parts = split(value);
+      if (parts.size() != 4) {
+        return false;
+      }
+      Bench_target target;
+      target.name = parts[0];
+      target.host = parts[1];
+      target.port = static_cast<unsigned int>(std::stoul(parts[2]));
+      target.engine = parts[3];
+      opts->targets.push_back(target);
+    } else if (parse_arg(argv[i], "--workloads", &value)) {
+      opts->workloads = split(value);
+      for (const auto &workload : opts->workloads) {
+        if (workload != "point_get" && workload != "range_scan" &&
+            workload != "insert" && workload != "commit") {
+          return false;
+        }
+      }
+    } else if (!parse_arg(argv[i], "--user", &opts->user) &&
+               !parse_arg(argv[i], "--password", &opts->password) &&
+               !parse_arg(argv[i], "--database", &opts->database) &&
+               !parse_size(argv[i], "--rows", &opts->rows) &&
+               !parse_size(argv[i], "--threads", &opts->threads) &&
+               !parse_size(argv[i], "--seconds", &opts->seconds) &&
+               !parse_size(argv[i], "--range_size", &opts->range_size) &&
+               !parse_size(argv[i], "--trx_size", &opts->trx_size)) {
+      return false;
+    }
+  }
+  return !opts->targets.empty() && opts->rows > 0 && opts->threads > 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Bench_options opts;
+  if (!parse_options(argc, argv, &opts)) {
+    fprintf(stderr,
+            "usage: %s --target=name,host,port,engine [--target=...] "
+            "[--user=U] [--password=P] [--database=D] [--rows=N] "
+            "[--threads=N] [--seconds=N] [--range_size=N] [--trx_size=N] "
+            "[--workloads=point_get,range_scan,insert,commit]\n",
+            argv[0]);
+    return 1;
+  }
+
+  if (mysql_library_init(0, nullptr, nullptr) != 0) {
+    fprintf(stderr, "cannot initialize the client library\n");
+    return 1;
+  }
+
+  printf("rows=%zu threads=%zu seconds=%zu range_size=%zu trx_size=%zu\n",
+         opts.rows, opts.threads, opts.seconds, opts.range_size,
+         opts.trx_size);
+  printf("%-12s %-12s %10s %8s %10s %9s %9s %9s\n", "target", "workload",
+         "ops", "errors", "ops/s", "avg_us", "p50_us", "p99_us");
+
+  int ret = 0;
+  for (const auto &target : opts.targets) {
+    if (!prepare(opts, target)) {
+      ret = 1;
+      continue;
+    }
+    for (const auto &workload : opts.workloads) {
+      Bench_result result;
+      if (!run(opts, target, workload, &result)) {
+        ret = 1;
+        break;
+      }
+      print_result(target, workload, result);
+    }
+  }
+
+  mysql_library_end();
+  return ret;
+}